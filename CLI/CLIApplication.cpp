@@ -2,6 +2,7 @@
 #include <iostream>
 #include <iomanip>
 #include <filesystem>
+#include <fstream>
 
 namespace UnityContextGen {
 namespace CLI {
@@ -33,6 +34,14 @@ int CLIApplication::run(int argc, char* argv[]) {
         return 1;
     }
     
+    if (!options.focus_component.empty()) {
+        return runFocusedContext(options);
+    }
+    
+    if (!options.symbol_query.empty()) {
+        return runSymbolSearch(options);
+    }
+    
     return runAnalysis(options);
 }
 
@@ -78,6 +87,83 @@ int CLIApplication::runAnalysis(const CLIOptions& options) {
     }
 }
 
+int CLIApplication::runFocusedContext(const CLIOptions& options) {
+    try {
+        m_engine->setVerbose(options.verbose);
+        
+        if (!createOutputDirectory(options.output_directory)) {
+            printError("Failed to create output directory: " + options.output_directory, options);
+            return 1;
+        }
+        
+        auto analysis_options = convertCLIOptions(options);
+        Context::FocusedContext focused = options.input_directory.empty()
+            ? m_engine->generateFocusedContext(options.input_files, options.focus_component,
+                                               options.focus_hops, analysis_options)
+            : m_engine->generateFocusedContextForDirectory(options.input_directory, options.focus_component,
+                                                           options.focus_hops, analysis_options);
+        
+        if (!focused.found) {
+            printError("No component matches: " + options.focus_component, options);
+            return 1;
+        }
+        
+        std::filesystem::path output_path = std::filesystem::path(options.output_directory) / "focused_context.md";
+        std::ofstream output_file(output_path);
+        if (output_file.is_open()) {
+            output_file << focused.prompt;
+        }
+        
+        // The prompt goes to stdout so it can be piped straight into another tool
+        std::cout << focused.prompt;
+        return 0;
+        
+    } catch (const std::exception& e) {
+        printError("Unexpected error: " + std::string(e.what()), options);
+        return 1;
+    }
+}
+
+int CLIApplication::runSymbolSearch(const CLIOptions& options) {
+    try {
+        m_engine->setVerbose(options.verbose);
+        
+        if (!createOutputDirectory(options.output_directory)) {
+            printError("Failed to create output directory: " + options.output_directory, options);
+            return 1;
+        }
+        
+        auto analysis_options = convertCLIOptions(options);
+        auto matches = options.input_directory.empty()
+            ? m_engine->searchSymbols(options.input_files, options.symbol_query, 10, analysis_options)
+            : m_engine->searchSymbolsInDirectory(options.input_directory, options.symbol_query, 10, analysis_options);
+        
+        if (matches.empty()) {
+            if (!options.quiet) {
+                std::cout << "No components match: " << options.symbol_query << "\n";
+            }
+            return 0;
+        }
+        
+        for (size_t i = 0; i < matches.size(); ++i) {
+            const auto& match = matches[i];
+            std::cout << (i + 1) << ". " << match.component << " (" << std::fixed << std::setprecision(2)
+                      << match.score << ") " << match.file_path << "\n";
+            
+            std::cout << "   matched:";
+            for (const auto& term : match.matched_terms) {
+                std::cout << " " << term << (&term != &match.matched_terms.back() ? "," : "");
+            }
+            std::cout << "\n";
+        }
+        return 0;
+        
+    } catch (const std::exception& e) {
+        printError("Unexpected error: " + std::string(e.what()), options);
+        return 1;
+    }
+}
+
 void CLIApplication::printResults(const AnalysisResult& result, const CLIOptions& options) {
     if (options.quiet) return;
     
@@ -171,6 +257,20 @@ AnalysisOptions CLIApplication::convertCLIOptions(const CLIOptions& cli_options)
     analysis_options.export_json = cli_options.export_json;
     analysis_options.output_directory = cli_options.output_directory;
     analysis_options.verbose_output = cli_options.verbose;
+    analysis_options.compact_json = cli_options.compact_json;
+    analysis_options.sharded_export = cli_options.sharded_export;
+    analysis_options.shard_granularity = cli_options.shard_granularity;
+    analysis_options.delta_export = cli_options.delta_export;
+    analysis_options.context_token_budget = cli_options.context_token_budget;
+    
+    // --format wins over the configured output format
+    analysis_options.output_format = cli_options.output_format;
+    if (!cli_options.output_format_set) {
+        const auto& configured = Config::ConfigurationManager::getInstance().getAnalysisOptions().output_format;
+        if (!parseOutputFormat(configured, analysis_options.output_format)) {
+            analysis_options.output_format = OutputFormat::All;
+        }
+    }
     
     return analysis_options;
 }
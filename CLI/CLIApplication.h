@@ -19,6 +19,8 @@ private:
     CLIArguments m_args;
     
     int runAnalysis(const CLIOptions& options);
+    int runFocusedContext(const CLIOptions& options);
+    int runSymbolSearch(const CLIOptions& options);
     void printResults(const AnalysisResult& result, const CLIOptions& options);
     void printProgress(const std::string& message, const CLIOptions& options);
     void printError(const std::string& message, const CLIOptions& options);
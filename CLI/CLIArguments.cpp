@@ -2,6 +2,7 @@
 #include <iostream>
 #include <filesystem>
 #include <algorithm>
+#include <stdexcept>
 
 namespace UnityContextGen {
 namespace CLI {
@@ -42,6 +43,73 @@ bool CLIArguments::parseArguments(int argc, char* argv[]) {
             m_options.generate_context = false;
         } else if (arg == "--no-json") {
             m_options.export_json = false;
+        } else if (arg == "--compact-json") {
+            m_options.compact_json = true;
+        } else if (arg == "--token-budget") {
+            if (i + 1 < argc) {
+                std::string budget = argv[++i];
+                
+                try {
+                    long long parsed = std::stoll(budget);
+                    if (parsed <= 0) {
+                        throw std::out_of_range(budget);
+                    }
+                    m_options.context_token_budget = static_cast<size_t>(parsed);
+                } catch (const std::exception&) {
+                    m_error_message = "Invalid token budget: " + budget;
+                    return false;
+                }
+            } else {
+                m_error_message = "Missing value for " + arg;
+                return false;
+            }
+        } else if (arg == "--focus") {
+            if (i + 1 < argc) {
+                m_options.focus_component = argv[++i];
+            } else {
+                m_error_message = "Missing value for " + arg;
+                return false;
+            }
+        } else if (arg == "--search") {
+            if (i + 1 < argc) {
+                m_options.symbol_query = argv[++i];
+            } else {
+                m_error_message = "Missing value for " + arg;
+                return false;
+            }
+        } else if (arg == "--hops") {
+            if (i + 1 < argc) {
+                std::string hops = argv[++i];
+                
+                try {
+                    int parsed = std::stoi(hops);
+                    if (parsed < 0) {
+                        throw std::out_of_range(hops);
+                    }
+                    m_options.focus_hops = parsed;
+                } catch (const std::exception&) {
+                    m_error_message = "Invalid hop count: " + hops;
+                    return false;
+                }
+            } else {
+                m_error_message = "Missing value for " + arg;
+                return false;
+            }
+        } else if (arg == "--delta") {
+            m_options.delta_export = true;
+        } else if (arg == "--shard") {
+            if (i + 1 < argc) {
+                std::string granularity = argv[++i];
+                
+                if (!Metadata::ShardedExporter::parseGranularity(granularity, m_options.shard_granularity)) {
+                    m_error_message = "Invalid shard granularity: " + granularity;
+                    return false;
+                }
+                m_options.sharded_export = true;
+            } else {
+                m_error_message = "Missing value for " + arg;
+                return false;
+            }
         } else if (arg == "--output" || arg == "-o") {
             if (i + 1 < argc) {
                 m_options.output_directory = argv[++i];
@@ -59,20 +127,12 @@ bool CLIArguments::parseArguments(int argc, char* argv[]) {
         } else if (arg == "--format" || arg == "-f") {
             if (i + 1 < argc) {
                 std::string format = argv[++i];
-                std::transform(format.begin(), format.end(), format.begin(), ::tolower);
                 
-                if (format == "json") {
-                    m_options.output_format = CLIOptions::OutputFormat::JSON;
-                } else if (format == "markdown" || format == "md") {
-                    m_options.output_format = CLIOptions::OutputFormat::Markdown;
-                } else if (format == "llm" || format == "prompt") {
-                    m_options.output_format = CLIOptions::OutputFormat::LLMPrompt;
-                } else if (format == "all") {
-                    m_options.output_format = CLIOptions::OutputFormat::All;
-                } else {
+                if (!parseOutputFormat(format, m_options.output_format)) {
                     m_error_message = "Invalid output format: " + format;
                     return false;
                 }
+                m_options.output_format_set = true;
             } else {
                 m_error_message = "Missing value for " + arg;
                 return false;
@@ -184,6 +244,13 @@ OPTIONS:
     --no-metadata           Skip metadata generation
     --no-context            Skip context summarization
     --no-json               Skip JSON export
+    --compact-json          Write JSON without indentation or newlines
+    --shard <MODE>          Split component metadata into shards: component, system
+    --delta                 Also write a JSON Patch against the previous run's snapshot
+    --token-budget <N>      Fit llm_prompt.md into N tokens, dropping the least relevant parts
+    --focus <NAME|FILE>     Print context for one component and its neighbours only
+    --hops <K>              Neighbourhood radius for --focus (default: 1, max: 8)
+    --search <QUERY>        Rank components by the classes, methods, fields and APIs they use
 
 EXAMPLES:
     # Analyze a single file
@@ -195,6 +262,12 @@ EXAMPLES:
     # Generate only LLM prompt
     unity_context_generator -d ./Scripts -f llm -o ./llm_context
     
+    # Context for one component and everything within two dependency hops
+    unity_context_generator -d ./Assets/Scripts --focus PlayerController --hops 2
+    
+    # Find the components that use Rigidbody inside FixedUpdate
+    unity_context_generator -d ./Assets/Scripts --search "Rigidbody in FixedUpdate"
+    
     # Verbose analysis with custom output
     unity_context_generator --verbose -d ./Assets -o ./analysis
 
@@ -205,6 +278,16 @@ OUTPUT FILES:
     summary.md              - Quick project overview
     detailed_report.md      - Comprehensive analysis report
     llm_prompt.md           - Ready-to-use LLM context prompt
+    component_index.json    - Dependency index that serves --focus queries without reanalysis
+    focused_context.md      - Focused component prompt (with --focus)
+    symbol_index.json       - Ranked symbol index that serves --search queries without reparsing
+    shard_manifest.json     - Shard index with offsets and hashes (with --shard)
+    shards/                 - Per-component or per-system metadata (with --shard)
+    project_snapshot.json   - Keyed snapshot the next delta is computed against (with --delta)
+    project_delta.json      - RFC 6902 JSON Patch from the previous snapshot (with --delta)
+    ai_response_cache.json  - Cached AI reviews reused for unchanged files (with AI analysis)
+    ai_triage.json          - Files ranked by review risk, with what the budget skipped (with AI analysis)
+    ai_batch_journal.json   - Submitted AI batch jobs, resumed by the next run until collected (with ai batch jobs)
 
 For more information, visit: https://github.com/your-repo/unity-llm-context-generator
 )";
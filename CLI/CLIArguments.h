@@ -23,15 +23,20 @@ struct CLIOptions {
     bool help = false;
     bool version = false;
     
-    enum class OutputFormat {
-        JSON,
-        Markdown,
-        LLMPrompt,
-        All
-    } output_format = OutputFormat::All;
+    using OutputFormat = UnityContextGen::OutputFormat;
+    OutputFormat output_format = OutputFormat::All;
+    bool output_format_set = false;
     
     bool quiet = false;
     bool force_overwrite = false;
+    bool compact_json = false;
+    bool sharded_export = false;
+    bool delta_export = false;
+    size_t context_token_budget = 0;
+    std::string focus_component;
+    int focus_hops = 1;
+    std::string symbol_query;
+    Metadata::ShardGranularity shard_granularity = Metadata::ShardGranularity::SystemGroup;
 };
 
 class CLIArguments {
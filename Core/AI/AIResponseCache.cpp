@@ -0,0 +1,219 @@
+#include "AIResponseCache.h"
+#include "MetadataGenerator/ArtifactWriter.h"
+#include "MetadataGenerator/ContentHash.h"
+#include <nlohmann/json.hpp>
+#include <fstream>
+#include <iostream>
+
+namespace UnityContextGen {
+namespace AI {
+
+using json = nlohmann::json;
+
+static const int CACHE_FORMAT_VERSION = 2;
+
+static json resultToJSON(const AIAnalysisResult& result) {
+    return {
+        {"overall_assessment", result.overall_assessment},
+        {"suggestions", result.suggestions},
+        {"potential_issues", result.potential_issues},
+        {"best_practices", result.best_practices},
+        {"performance_optimizations", result.performance_optimizations},
+        {"security_concerns", result.security_concerns},
+        {"architecture_pattern", result.architecture_pattern},
+        {"design_improvements", result.design_improvements},
+        {"maintainability_score", result.maintainability_score},
+        {"complexity_assessment", result.complexity_assessment},
+        {"unity_best_practices", result.unity_best_practices},
+        {"lifecycle_recommendations", result.lifecycle_recommendations},
+        {"performance_tips", result.performance_tips},
+        {"confidence_score", result.confidence_score},
+        {"analysis_duration_ms", result.analysis_duration_ms}
+    };
+}
+
+static AIAnalysisResult resultFromJSON(const json& j) {
+    using Items = std::vector<std::string>;
+    AIAnalysisResult result;
+    result.success = true;
+    result.overall_assessment = j.value("overall_assessment", "");
+    result.suggestions = j.value("suggestions", Items());
+    result.potential_issues = j.value("potential_issues", Items());
+    result.best_practices = j.value("best_practices", Items());
+    result.performance_optimizations = j.value("performance_optimizations", Items());
+    result.security_concerns = j.value("security_concerns", Items());
+    result.architecture_pattern = j.value("architecture_pattern", "");
+    result.design_improvements = j.value("design_improvements", Items());
+    result.maintainability_score = j.value("maintainability_score", "");
+    result.complexity_assessment = j.value("complexity_assessment", "");
+    result.unity_best_practices = j.value("unity_best_practices", Items());
+    result.lifecycle_recommendations = j.value("lifecycle_recommendations", Items());
+    result.performance_tips = j.value("performance_tips", Items());
+    result.confidence_score = j.value("confidence_score", 0.0f);
+    result.analysis_duration_ms = j.value("analysis_duration_ms", 0);
+    return result;
+}
+
+AIResponseCache::AIResponseCache(size_t max_bytes) : m_max_bytes(max_bytes) {
+}
+
+std::string AIResponseCache::makeKey(const std::string& code_content,
+                                     int prompt_template_version,
+                                     const std::string& model_name,
+                                     const std::string& analysis_type,
+                                     const std::string& file_path,
+                                     const std::string& component_name) {
+    // The project context is left out: it summarizes the whole project, so
+    // hashing it would re-review every file whenever any other file changed.
+    // Length-prefix each part so shifting bytes between fields changes the key
+    uint64_t hash = Metadata::FNV1A_OFFSET_BASIS;
+    for (const std::string& part : {std::to_string(prompt_template_version), model_name, analysis_type,
+                                    file_path, component_name, code_content}) {
+        hash = Metadata::hashContent(std::to_string(part.size()) + ":", hash);
+        hash = Metadata::hashContent(part, hash);
+    }
+    return Metadata::hashToHex(hash);
+}
+
+bool AIResponseCache::lookup(const std::string& key, AIAnalysisResult& result) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_by_key.find(key);
+    if (it == m_by_key.end()) {
+        m_stats.misses++;
+        return false;
+    }
+
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    result = it->second->result;
+    m_stats.hits++;
+    return true;
+}
+
+void AIResponseCache::store(const std::string& key, const AIAnalysisResult& result) {
+    if (!result.success) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    insert(key, result);
+    m_stats.stores++;
+    evict();
+}
+
+bool AIResponseCache::load(const std::string& cache_path) {
+    try {
+        std::ifstream file(cache_path);
+        if (!file.is_open()) {
+            return false;
+        }
+
+        json j = json::parse(file);
+        if (j.value("format_version", 0) != CACHE_FORMAT_VERSION) {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_entries.clear();
+        m_by_key.clear();
+        m_stats.bytes = 0;
+        // Saved most recent first; appending keeps that order
+        for (const auto& entry : j.at("entries")) {
+            std::string key = entry.at("key").get<std::string>();
+            if (m_by_key.count(key)) {
+                continue;
+            }
+            AIAnalysisResult result = resultFromJSON(entry.at("result"));
+            size_t bytes = estimateBytes(key, result);
+            m_entries.push_back({key, std::move(result), bytes});
+            m_by_key[key] = std::prev(m_entries.end());
+            m_stats.bytes += bytes;
+        }
+        evict();
+        m_stats.entries = m_entries.size();
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Error reading AI response cache: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool AIResponseCache::save(const std::string& cache_path) const {
+    json j;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        j["format_version"] = CACHE_FORMAT_VERSION;
+        j["entries"] = json::array();
+        for (const auto& entry : m_entries) {
+            j["entries"].push_back({{"key", entry.key}, {"result", resultToJSON(entry.result)}});
+        }
+    }
+
+    std::string error;
+    auto status = Metadata::writeArtifactIfChanged(cache_path, [&j](std::ostream& out) {
+        out << j.dump();
+    }, error);
+    if (status == Metadata::ArtifactWriteStatus::Failed) {
+        std::cerr << "Error writing AI response cache: " << error << std::endl;
+        return false;
+    }
+    return true;
+}
+
+ResponseCacheStats AIResponseCache::getStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void AIResponseCache::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_by_key.clear();
+    m_stats.entries = 0;
+    m_stats.bytes = 0;
+}
+
+void AIResponseCache::insert(const std::string& key, const AIAnalysisResult& result) {
+    auto existing = m_by_key.find(key);
+    if (existing != m_by_key.end()) {
+        m_stats.bytes -= existing->second->bytes;
+        m_entries.erase(existing->second);
+        m_by_key.erase(existing);
+    }
+
+    size_t bytes = estimateBytes(key, result);
+    m_entries.push_front({key, result, bytes});
+    m_by_key[key] = m_entries.begin();
+    m_stats.bytes += bytes;
+    m_stats.entries = m_entries.size();
+}
+
+void AIResponseCache::evict() {
+    while (m_stats.bytes > m_max_bytes && !m_entries.empty()) {
+        const Entry& oldest = m_entries.back();
+        m_stats.bytes -= oldest.bytes;
+        m_by_key.erase(oldest.key);
+        m_entries.pop_back();
+        m_stats.evictions++;
+    }
+    m_stats.entries = m_entries.size();
+}
+
+size_t AIResponseCache::estimateBytes(const std::string& key, const AIAnalysisResult& result) {
+    auto list_bytes = [](const std::vector<std::string>& items) {
+        size_t total = 0;
+        for (const auto& item : items) {
+            total += item.size();
+        }
+        return total;
+    };
+
+    return key.size() + result.overall_assessment.size() + result.architecture_pattern.size() +
+           result.maintainability_score.size() + result.complexity_assessment.size() +
+           list_bytes(result.suggestions) + list_bytes(result.potential_issues) +
+           list_bytes(result.best_practices) + list_bytes(result.performance_optimizations) +
+           list_bytes(result.security_concerns) + list_bytes(result.design_improvements) +
+           list_bytes(result.unity_best_practices) + list_bytes(result.lifecycle_recommendations) +
+           list_bytes(result.performance_tips);
+}
+
+} // namespace AI
+} // namespace UnityContextGen
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "ClaudeAnalyzer.h"
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace UnityContextGen {
+namespace AI {
+
+struct ResponseCacheStats {
+    int64_t hits = 0;
+    int64_t misses = 0;
+    int64_t stores = 0;
+    int64_t evictions = 0;
+    size_t entries = 0;
+    size_t bytes = 0;
+};
+
+// Persistent cache of successful analysis results. Keys hash the per-file
+// inputs of the reply (code, prompt template version, model, analysis type,
+// file path and component name), so an unchanged file is never sent twice,
+// even when the shared project summary moves, and any edit or prompt change
+// misses naturally. Bounded by approximate size with LRU eviction; recency
+// survives save/load. Thread-safe.
+class AIResponseCache {
+public:
+    explicit AIResponseCache(size_t max_bytes = 64 * 1024 * 1024);
+    ~AIResponseCache() = default;
+
+    static std::string makeKey(const std::string& code_content,
+                               int prompt_template_version,
+                               const std::string& model_name,
+                               const std::string& analysis_type,
+                               const std::string& file_path,
+                               const std::string& component_name);
+
+    bool lookup(const std::string& key, AIAnalysisResult& result);
+    void store(const std::string& key, const AIAnalysisResult& result);
+
+    bool load(const std::string& cache_path);
+    bool save(const std::string& cache_path) const;
+
+    ResponseCacheStats getStats() const;
+    void clear();
+
+private:
+    struct Entry {
+        std::string key;
+        AIAnalysisResult result;
+        size_t bytes;
+    };
+
+    size_t m_max_bytes;
+    std::list<Entry> m_entries; // Most recently used first
+    std::unordered_map<std::string, std::list<Entry>::iterator> m_by_key;
+    ResponseCacheStats m_stats;
+    mutable std::mutex m_mutex;
+
+    void insert(const std::string& key, const AIAnalysisResult& result);
+    void evict();
+
+    static size_t estimateBytes(const std::string& key, const AIAnalysisResult& result);
+};
+
+} // namespace AI
+} // namespace UnityContextGen
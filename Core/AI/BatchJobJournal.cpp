@@ -0,0 +1,147 @@
+#include "BatchJobJournal.h"
+#include "MetadataGenerator/ArtifactWriter.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace UnityContextGen {
+namespace AI {
+
+using json = nlohmann::json;
+
+static const int JOURNAL_FORMAT_VERSION = 1;
+
+bool BatchJobJournal::load(const std::string& journal_path) {
+    try {
+        std::ifstream file(journal_path);
+        if (!file.is_open()) {
+            return false;
+        }
+
+        json j = json::parse(file);
+        if (j.value("format_version", 0) != JOURNAL_FORMAT_VERSION) {
+            return false;
+        }
+
+        m_jobs.clear();
+        m_messages.clear();
+        for (const auto& entry : j.at("jobs")) {
+            BatchJobRecord job;
+            job.batch_id = entry.at("batch_id").get<std::string>();
+            job.processing_status = entry.value("processing_status", "in_progress");
+            job.custom_ids = entry.value("custom_ids", std::vector<std::string>());
+            m_jobs.push_back(std::move(job));
+        }
+        for (const auto& item : j.at("messages").items()) {
+            m_messages[item.key()] = item.value();
+        }
+        reindex();
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Error reading AI batch job journal: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool BatchJobJournal::save(const std::string& journal_path) const {
+    json j;
+    j["format_version"] = JOURNAL_FORMAT_VERSION;
+    j["jobs"] = json::array();
+    for (const auto& job : m_jobs) {
+        j["jobs"].push_back({
+            {"batch_id", job.batch_id},
+            {"processing_status", job.processing_status},
+            {"custom_ids", job.custom_ids}
+        });
+    }
+    j["messages"] = json::object();
+    for (const auto& entry : m_messages) {
+        j["messages"][entry.first] = entry.second;
+    }
+
+    std::string error;
+    auto status = Metadata::writeArtifactIfChanged(journal_path, [&j](std::ostream& out) {
+        out << j.dump();
+    }, error);
+    if (status == Metadata::ArtifactWriteStatus::Failed) {
+        std::cerr << "Error writing AI batch job journal: " << error << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool BatchJobJournal::release(const std::string& journal_path) {
+    BatchJobJournal journal;
+    if (!journal.load(journal_path)) {
+        return false;
+    }
+    
+    if (journal.m_jobs.empty()) {
+        std::error_code ec;
+        return std::filesystem::remove(journal_path, ec);
+    }
+    journal.m_messages.clear();
+    return journal.save(journal_path);
+}
+
+void BatchJobJournal::addJob(const BatchJobRecord& job) {
+    m_jobs.push_back(job);
+    for (const auto& custom_id : job.custom_ids) {
+        m_job_by_custom_id[custom_id] = m_jobs.size() - 1;
+    }
+}
+
+void BatchJobJournal::setStatus(const std::string& batch_id, const std::string& processing_status) {
+    for (auto& job : m_jobs) {
+        if (job.batch_id == batch_id) {
+            job.processing_status = processing_status;
+        }
+    }
+}
+
+void BatchJobJournal::markCollected(const std::string& batch_id) {
+    m_jobs.erase(std::remove_if(m_jobs.begin(), m_jobs.end(), [&batch_id](const BatchJobRecord& job) {
+        return job.batch_id == batch_id;
+    }), m_jobs.end());
+    reindex();
+}
+
+const BatchJobRecord* BatchJobJournal::findOpenJob(const std::string& custom_id) const {
+    auto it = m_job_by_custom_id.find(custom_id);
+    return it == m_job_by_custom_id.end() ? nullptr : &m_jobs[it->second];
+}
+
+void BatchJobJournal::storeMessage(const std::string& custom_id, const json& message) {
+    m_messages[custom_id] = message;
+}
+
+const json* BatchJobJournal::findMessage(const std::string& custom_id) const {
+    auto it = m_messages.find(custom_id);
+    return it == m_messages.end() ? nullptr : &it->second;
+}
+
+size_t BatchJobJournal::discardMessagesExcept(const std::set<std::string>& custom_ids) {
+    size_t discarded = 0;
+    for (auto it = m_messages.begin(); it != m_messages.end();) {
+        if (custom_ids.count(it->first)) {
+            ++it;
+        } else {
+            it = m_messages.erase(it);
+            ++discarded;
+        }
+    }
+    return discarded;
+}
+
+void BatchJobJournal::reindex() {
+    m_job_by_custom_id.clear();
+    for (size_t i = 0; i < m_jobs.size(); ++i) {
+        for (const auto& custom_id : m_jobs[i].custom_ids) {
+            m_job_by_custom_id[custom_id] = i;
+        }
+    }
+}
+
+} // namespace AI
+} // namespace UnityContextGen
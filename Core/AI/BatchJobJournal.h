@@ -0,0 +1,63 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace UnityContextGen {
+namespace AI {
+
+// One submitted Message Batches job and the prompts packed into it
+struct BatchJobRecord {
+    std::string batch_id;
+    std::string processing_status; // As last reported: "in_progress", "canceling" or "ended"
+    std::vector<std::string> custom_ids;
+};
+
+// Persistent record of submitted batch jobs and the replies already
+// collected from them, so a run that is interrupted while a job is still
+// processing picks the same job up again instead of paying for it twice.
+// Prompts are identified by custom ids derived from their content; a job
+// stays open until its results have been downloaded. Not thread-safe.
+class BatchJobJournal {
+public:
+    BatchJobJournal() = default;
+    ~BatchJobJournal() = default;
+
+    bool load(const std::string& journal_path);
+    bool save(const std::string& journal_path) const;
+
+    void addJob(const BatchJobRecord& job);
+    void setStatus(const std::string& batch_id, const std::string& processing_status);
+
+    // Closes the job; its prompts without a stored reply are sent again next time
+    void markCollected(const std::string& batch_id);
+
+    // The open job a prompt was submitted in, or nullptr
+    const BatchJobRecord* findOpenJob(const std::string& custom_id) const;
+    const std::vector<BatchJobRecord>& openJobs() const { return m_jobs; }
+
+    // Successful Messages API replies, kept until the journal is discarded
+    void storeMessage(const std::string& custom_id, const nlohmann::json& message);
+    const nlohmann::json* findMessage(const std::string& custom_id) const;
+    // Drops replies to prompts not in custom_ids; returns how many were dropped
+    size_t discardMessagesExcept(const std::set<std::string>& custom_ids);
+
+    bool empty() const { return m_jobs.empty() && m_messages.empty(); }
+
+    // For once the collected replies are persisted elsewhere (the response
+    // cache): drops them, and removes the journal when no job is left open
+    static bool release(const std::string& journal_path);
+
+private:
+    std::vector<BatchJobRecord> m_jobs;
+    std::unordered_map<std::string, size_t> m_job_by_custom_id;
+    std::unordered_map<std::string, nlohmann::json> m_messages;
+
+    void reindex();
+};
+
+} // namespace AI
+} // namespace UnityContextGen
@@ -1,7 +1,15 @@
 #include "ClaudeAnalyzer.h"
 #include "UnityAPIDetector.h"
+#include "AIResponseCache.h"
+#include "ResponseStream.h"
+#include "CodeChunker.h"
+#include "BatchJobJournal.h"
+#include "UnityAnalyzer/MonoBehaviourAnalyzer.h"
 #include <nlohmann/json.hpp>
+#include <algorithm>
 #include <iostream>
+#include <map>
+#include <set>
 #include <sstream>
 #include <thread>
 #include <chrono>
@@ -11,8 +19,36 @@ namespace AI {
 
 using json = nlohmann::json;
 
+// Bump whenever the system message, prefix or suffix templates change, so
+// cached responses produced by an older prompt are not reused
+static const int PROMPT_TEMPLATE_VERSION = 2;
+
+static const int MAX_OUTPUT_TOKENS = 4000;
+
+// Roughly four characters per token for English text and code
+static const int64_t CHARS_PER_TOKEN = 4;
+
+// Room left for the part header and per-chunk API list when sizing chunks,
+// and the smallest code budget worth splitting a file into
+static const int64_t CHUNK_HEADER_TOKENS = 256;
+static const int64_t MIN_CHUNK_TOKENS = 512;
+static const int MAX_CHUNKING_ATTEMPTS = 4;
+
+// Message Batches limits per job: request count, and a margin under 256 MB
+static const size_t MAX_BATCH_JOB_REQUESTS = 100000;
+static const size_t MAX_BATCH_JOB_BYTES = 200 * 1024 * 1024;
+
+static void appendUnique(std::vector<std::string>& items, const std::vector<std::string>& more) {
+    for (const auto& item : more) {
+        if (std::find(items.begin(), items.end(), item) == items.end()) {
+            items.push_back(item);
+        }
+    }
+}
+
 ClaudeAnalyzer::ClaudeAnalyzer() : m_initialized(false) {
     m_http_client = std::make_unique<HTTPClient>();
+    m_api_detector.setVerbose(false);
 }
 
 bool ClaudeAnalyzer::initialize(const Config::AIAnalysisConfig& config) {
@@ -27,6 +63,13 @@ bool ClaudeAnalyzer::initialize(const Config::AIAnalysisConfig& config) {
     m_http_client->setTimeout(m_config.timeout_seconds);
     m_http_client->setUserAgent("UnityContextGenerator/1.0 (Claude Integration)");
     
+    RateLimits limits;
+    limits.requests_per_minute = m_config.requests_per_minute;
+    limits.tokens_per_minute = m_config.tokens_per_minute;
+    limits.retry_base_delay_ms = m_config.retry_base_delay_ms;
+    limits.retry_max_delay_ms = m_config.retry_max_delay_ms;
+    m_scheduler = std::make_unique<RequestScheduler>(limits);
+    
     m_initialized = true;
     logProgress("Claude API initialized successfully", 1.0f);
     
@@ -38,48 +81,673 @@ AIAnalysisResult ClaudeAnalyzer::analyzeCode(const AIAnalysisRequest& request) {
         return createErrorResult("ClaudeAnalyzer not initialized");
     }
     
+    std::string cache_key;
+    if (m_response_cache) {
+        cache_key = responseCacheKey(request);
+        AIAnalysisResult cached;
+        if (m_response_cache->lookup(cache_key, cached)) {
+            cached.analysis_duration_ms = 0;
+            logProgress("Using cached AI analysis for " + request.component_name, 1.0f);
+            return cached;
+        }
+    }
+    
     logProgress("Starting AI code analysis...", 0.0f);
     
     auto start_time = std::chrono::high_resolution_clock::now();
     
-    // Detect Unity APIs in the code
-    UnityAPIDetector detector;
-    detector.setVerbose(false);
-    auto api_usage = detector.analyzeCode(request.code_content, request.file_path);
+    // Construct prompt for Claude from the detected Unity APIs
+    std::string error;
+    std::vector<PromptLayout> prompts = buildReviewPrompts(request, error);
+    if (prompts.empty()) {
+        return createErrorResult(error);
+    }
     
     logProgress("Detected Unity APIs, analyzing with Claude...", 0.3f);
     
-    // Create analysis context
-    std::string analysis_context = createAnalysisContext(request.project_context, api_usage.detected_apis);
+    AIAnalysisResult result;
+    if (prompts.size() > 1) {
+        // Chunks of an oversized file are reviewed concurrently, then merged
+        std::vector<HTTPClient::HTTPRequest> http_requests;
+        for (const auto& layout : prompts) {
+            http_requests.push_back(buildHTTPRequest(layout));
+        }
+        std::vector<AIAnalysisResult> parts(prompts.size());
+        logProgress("Sending " + std::to_string(prompts.size()) + " chunk requests to Claude API...", 0.5f);
+        sendBatch(http_requests, RequestPriority::Interactive,
+            [&](size_t chunk_index, const HTTPClient::HTTPResponse& response) {
+                parts[chunk_index] = resultFromResponse(response, request);
+            });
+        result = mergeChunkResults(parts);
+        if (!result.success) {
+            return result;
+        }
+    } else {
+        logProgress("Sending request to Claude API...", 0.5f);
+        
+        // Make API request to Claude; streaming surfaces insights while the reply is generated
+        const PromptLayout& layout = prompts.front();
+        std::string claude_response = m_config.enable_streaming ? makeStreamingAPIRequest(layout) : makeAPIRequest(layout);
+        
+        if (claude_response.empty()) {
+            return createErrorResult("Failed to get response from Claude API");
+        }
+        
+        logProgress("Processing Claude response...", 0.8f);
+        
+        // Parse and structure the response
+        result = parseAPIResponse(claude_response, request);
+    }
     
-    // Construct prompt for Claude
-    std::string prompt = constructPrompt(request, api_usage);
-    std::string system_message = constructSystemMessage(request.analysis_type);
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+    result.analysis_duration_ms = static_cast<int>(duration.count());
     
-    logProgress("Sending request to Claude API...", 0.5f);
+    if (m_response_cache) {
+        m_response_cache->store(cache_key, result);
+    }
     
-    // Make API request to Claude
-    std::string claude_response = makeAPIRequest(prompt, system_message);
+    logProgress("AI analysis completed", 1.0f);
     
-    if (claude_response.empty()) {
-        return createErrorResult("Failed to get response from Claude API");
+    return result;
+}
+
+std::vector<AIAnalysisResult> ClaudeAnalyzer::analyzeBatch(const std::vector<AIAnalysisRequest>& requests,
+                                                           const BatchCompletionCallback& on_complete) {
+    std::vector<AIAnalysisResult> results(requests.size());
+    if (!m_initialized) {
+        for (size_t i = 0; i < requests.size(); ++i) {
+            results[i] = createErrorResult("ClaudeAnalyzer not initialized");
+            if (on_complete) {
+                on_complete(i, results[i]);
+            }
+        }
+        return results;
+    }
+    if (requests.empty()) {
+        return results;
     }
     
-    logProgress("Processing Claude response...", 0.8f);
+    logProgress("Starting batched AI code analysis of " + std::to_string(requests.size()) + " files...", 0.0f);
     
-    // Parse and structure the response
-    AIAnalysisResult result = parseAPIResponse(claude_response, request);
+    // Cached files complete immediately; only the rest go on the wire
+    std::vector<std::string> cache_keys;
+    std::vector<size_t> pending = takeCachedResults(requests, results, cache_keys, on_complete);
+    size_t completed = requests.size() - pending.size();
+    if (pending.empty()) {
+        return results;
+    }
     
-    auto end_time = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
-    result.analysis_duration_ms = static_cast<int>(duration.count());
+    auto start_time = std::chrono::steady_clock::now();
+    auto finish = [&](size_t index) {
+        // Requests overlap, so this is time from batch start to this response
+        auto elapsed = std::chrono::steady_clock::now() - start_time;
+        results[index].analysis_duration_ms = static_cast<int>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+        
+        ++completed;
+        logProgress("Analyzed " + requests[index].component_name + " (" + std::to_string(completed) +
+                    "/" + std::to_string(requests.size()) + ")",
+                    static_cast<float>(completed) / static_cast<float>(requests.size()));
+        if (on_complete) {
+            on_complete(index, results[index]);
+        }
+    };
     
-    logProgress("AI analysis completed", 1.0f);
+    // Prompts are built up front so the event loop only moves bytes. An
+    // oversized file contributes one request per chunk; its result is merged
+    // once the last chunk is back. A file whose estimated cost would overrun
+    // the review token budget is skipped, though smaller ones further down
+    // the list may still fit.
+    std::vector<HTTPClient::HTTPRequest> http_requests;
+    std::vector<std::pair<size_t, size_t>> chunk_owners; // (request index, chunk index) per HTTP request
+    std::vector<std::vector<AIAnalysisResult>> chunk_results(requests.size());
+    std::vector<size_t> chunks_outstanding(requests.size(), 0);
+    int64_t token_budget = m_config.review_token_budget;
+    int64_t tokens_planned = 0;
+    for (size_t request_index : pending) {
+        std::string error;
+        std::vector<PromptLayout> prompts = buildReviewPrompts(requests[request_index], error);
+        if (prompts.empty()) {
+            results[request_index] = createErrorResult(error);
+            finish(request_index);
+            continue;
+        }
+        
+        std::vector<HTTPClient::HTTPRequest> file_requests;
+        int64_t file_tokens = 0;
+        for (const auto& layout : prompts) {
+            file_requests.push_back(buildHTTPRequest(layout));
+            file_tokens += estimateInputTokens(file_requests.back().body) + MAX_OUTPUT_TOKENS;
+        }
+        if (token_budget > 0 && tokens_planned + file_tokens > token_budget) {
+            results[request_index] = createErrorResult("Skipped: review needs about " + std::to_string(file_tokens) +
+                                                       " tokens, " + std::to_string(token_budget - tokens_planned) +
+                                                       " left in the review token budget");
+            results[request_index].skipped = true;
+            finish(request_index);
+            continue;
+        }
+        tokens_planned += file_tokens;
+        
+        chunk_results[request_index].resize(prompts.size());
+        chunks_outstanding[request_index] = prompts.size();
+        for (size_t chunk_index = 0; chunk_index < prompts.size(); ++chunk_index) {
+            http_requests.push_back(std::move(file_requests[chunk_index]));
+            chunk_owners.emplace_back(request_index, chunk_index);
+        }
+    }
+    if (token_budget > 0) {
+        logProgress("Planned about " + std::to_string(tokens_planned) + " of " + std::to_string(token_budget) +
+                    " budgeted review tokens", static_cast<float>(completed) / static_cast<float>(requests.size()));
+    }
     
-    return result;
+    // Requests still unsent when the time budget runs out are skipped
+    auto send_deadline = Clock::time_point::max();
+    if (m_config.review_time_budget_seconds > 0) {
+        send_deadline = m_now() + std::chrono::seconds(m_config.review_time_budget_seconds);
+    }
+    
+    sendBatch(http_requests, RequestPriority::Bulk,
+        [&](size_t http_index, const HTTPClient::HTTPResponse& response) {
+            size_t index = chunk_owners[http_index].first;
+            auto& parts = chunk_results[index];
+            AIAnalysisResult& part = parts[chunk_owners[http_index].second];
+            if (response.dropped) {
+                part = createErrorResult("Skipped: review time budget of " +
+                                         std::to_string(m_config.review_time_budget_seconds) + " s ran out");
+                part.skipped = true;
+            } else {
+                part = resultFromResponse(response, requests[index]);
+            }
+            if (--chunks_outstanding[index] > 0) {
+                return;
+            }
+            
+            AIAnalysisResult& result = results[index];
+            result = parts.size() == 1 ? std::move(parts.front()) : mergeChunkResults(parts);
+            parts.clear();
+            if (result.success && m_response_cache) {
+                m_response_cache->store(cache_keys[index], result);
+            }
+            finish(index);
+        }, send_deadline);
+    
+    return results;
+}
+
+std::vector<AIAnalysisResult> ClaudeAnalyzer::analyzeBatchJob(const std::vector<AIAnalysisRequest>& requests,
+                                                              const std::string& journal_path,
+                                                              const BatchCompletionCallback& on_complete) {
+    std::vector<AIAnalysisResult> results(requests.size());
+    if (!m_initialized) {
+        for (size_t i = 0; i < requests.size(); ++i) {
+            results[i] = createErrorResult("ClaudeAnalyzer not initialized");
+            if (on_complete) {
+                on_complete(i, results[i]);
+            }
+        }
+        return results;
+    }
+    if (requests.empty()) {
+        return results;
+    }
+    
+    logProgress("Starting AI batch job review of " + std::to_string(requests.size()) + " files...", 0.0f);
+    std::vector<std::string> cache_keys;
+    std::vector<size_t> pending = takeCachedResults(requests, results, cache_keys, on_complete);
+    
+    BatchJobJournal journal;
+    if (journal.load(journal_path)) {
+        logProgress("Resuming " + std::to_string(journal.openJobs().size()) + " AI batch jobs from " + journal_path, 0.0f);
+    }
+    if (pending.empty() && journal.openJobs().empty()) {
+        return results;
+    }
+    
+    // Custom ids are derived from the file's own inputs, so the same file maps
+    // to the same id in a later run and is found in the journal
+    std::vector<std::vector<std::string>> custom_ids(requests.size());
+    std::unordered_map<std::string, std::string> failures; // custom id -> why there is no reply
+    std::vector<std::pair<std::string, json>> unsubmitted;
+    std::set<std::string> seen;
+    for (size_t request_index : pending) {
+        std::string error;
+        std::vector<PromptLayout> prompts = buildReviewPrompts(requests[request_index], error);
+        if (prompts.empty()) {
+            results[request_index] = createErrorResult(error);
+            continue;
+        }
+        
+        for (size_t chunk_index = 0; chunk_index < prompts.size(); ++chunk_index) {
+            std::string custom_id = batchCustomId(requests[request_index], chunk_index, prompts.size());
+            custom_ids[request_index].push_back(custom_id);
+            if (!seen.insert(custom_id).second || journal.findMessage(custom_id) || journal.findOpenJob(custom_id)) {
+                continue;
+            }
+            unsubmitted.emplace_back(custom_id, buildRequestJSON(prompts[chunk_index]));
+        }
+    }
+    
+    // Pack the remaining prompts into as few jobs as the API accepts
+    size_t submitted = 0;
+    for (size_t first = 0; first < unsubmitted.size();) {
+        json job_requests = json::array();
+        size_t job_bytes = 0;
+        size_t last = first;
+        for (; last < unsubmitted.size() && job_requests.size() < MAX_BATCH_JOB_REQUESTS; ++last) {
+            json entry = {{"custom_id", unsubmitted[last].first}, {"params", unsubmitted[last].second}};
+            size_t entry_bytes = entry.dump().size();
+            if (!job_requests.empty() && job_bytes + entry_bytes > MAX_BATCH_JOB_BYTES) {
+                break;
+            }
+            job_bytes += entry_bytes;
+            job_requests.push_back(std::move(entry));
+        }
+        
+        BatchJobRecord job;
+        std::string error;
+        if (submitBatchJob(job_requests, job, error)) {
+            journal.addJob(job);
+            journal.save(journal_path); // Before waiting, so an interrupted run finds the job
+            submitted += job.custom_ids.size();
+        } else {
+            for (size_t i = first; i < last; ++i) {
+                failures[unsubmitted[i].first] = "Batch job submission failed: " + error;
+            }
+        }
+        first = last;
+    }
+    logProgress("Submitted " + std::to_string(submitted) + " prompts in AI batch jobs", 0.1f);
+    
+    // Poll every open job until it ends or the wait runs out, including jobs
+    // from earlier runs holding none of these prompts: left alone, they would
+    // keep the journal open for good
+    std::set<std::string> waiting;
+    for (const auto& job : journal.openJobs()) {
+        waiting.insert(job.batch_id);
+    }
+    auto start_time = std::chrono::steady_clock::now();
+    auto wait_deadline = m_config.batch_max_wait_seconds > 0
+        ? start_time + std::chrono::seconds(m_config.batch_max_wait_seconds)
+        : std::chrono::steady_clock::time_point::max();
+    // A job that will never deliver is closed, so its prompts are submitted again on the next run
+    auto abandon_job = [&](const std::string& batch_id, const std::string& reason) {
+        for (const auto& job : journal.openJobs()) {
+            if (job.batch_id != batch_id) {
+                continue;
+            }
+            for (const auto& custom_id : job.custom_ids) {
+                failures[custom_id] = "AI batch job " + batch_id + " " + reason + "; rerun to submit it again";
+            }
+        }
+        journal.markCollected(batch_id);
+        journal.save(journal_path);
+        logError("Abandoned AI batch job " + batch_id + ": " + reason);
+    };
+    // Jobs whose status check failed transiently: (failed checks in a row, earliest next check)
+    std::map<std::string, std::pair<int, std::chrono::steady_clock::time_point>> poll_backoff;
+    size_t jobs_total = waiting.size();
+    while (!waiting.empty()) {
+        for (auto it = waiting.begin(); it != waiting.end();) {
+            auto backoff = poll_backoff.find(*it);
+            if (backoff != poll_backoff.end() && std::chrono::steady_clock::now() < backoff->second.second) {
+                ++it;
+                continue;
+            }
+            
+            std::string status;
+            std::string error;
+            int http_status = 0;
+            if (!pollBatchJob(*it, status, error, http_status)) {
+                // Client errors other than timeouts and rate limits (e.g. 404) mean the API no longer has the job
+                bool job_lost = http_status >= 400 && http_status < 500 && http_status != 408 && http_status != 429;
+                if (job_lost) {
+                    abandon_job(*it, "could not be found (" + error + ")");
+                    it = waiting.erase(it);
+                    continue;
+                }
+                // Anything else may clear up, so the job is checked again until the wait runs out
+                auto& failed = poll_backoff[*it];
+                failed.second = std::chrono::steady_clock::now() + m_scheduler->backoffDelay(failed.first++);
+                logError("Could not check AI batch job " + *it + ", retrying: " + error);
+                ++it;
+                continue;
+            }
+            poll_backoff.erase(*it);
+            journal.setStatus(*it, status);
+            if (status == "in_progress" || status == "canceling") {
+                ++it;
+                continue;
+            }
+            if (status != "ended") {
+                abandon_job(*it, "reported status " + status);
+                it = waiting.erase(it);
+                continue;
+            }
+            
+            if (collectBatchJob(*it, journal, failures, error)) {
+                journal.markCollected(*it);
+            } else {
+                logError("Could not download results of AI batch job " + *it + ": " + error);
+            }
+            journal.save(journal_path);
+            it = waiting.erase(it);
+            logProgress("AI batch job ended (" + std::to_string(jobs_total - waiting.size()) + "/" +
+                        std::to_string(jobs_total) + ")",
+                        0.1f + 0.9f * static_cast<float>(jobs_total - waiting.size()) / static_cast<float>(jobs_total));
+        }
+        
+        auto now = std::chrono::steady_clock::now();
+        if (waiting.empty() || now >= wait_deadline) {
+            break;
+        }
+        auto poll_interval = std::chrono::milliseconds(std::max(1, m_config.batch_poll_interval_ms));
+        std::this_thread::sleep_for(wait_deadline - now < poll_interval
+            ? std::chrono::duration_cast<std::chrono::milliseconds>(wait_deadline - now)
+            : poll_interval);
+    }
+    if (!waiting.empty()) {
+        logProgress(std::to_string(waiting.size()) + " AI batch jobs still processing; rerun to collect them from " +
+                    journal_path, 1.0f);
+    }
+    
+    for (size_t request_index : pending) {
+        if (custom_ids[request_index].empty()) {
+            if (on_complete) {
+                on_complete(request_index, results[request_index]);
+            }
+            continue;
+        }
+        
+        std::vector<AIAnalysisResult> parts;
+        for (const auto& custom_id : custom_ids[request_index]) {
+            if (const json* message = journal.findMessage(custom_id)) {
+                HTTPClient::HTTPResponse response;
+                response.status_code = 200;
+                response.success = true;
+                response.body = message->dump();
+                parts.push_back(resultFromResponse(response, requests[request_index]));
+            } else if (failures.count(custom_id)) {
+                parts.push_back(createErrorResult(failures[custom_id]));
+            } else if (const BatchJobRecord* job = journal.findOpenJob(custom_id)) {
+                parts.push_back(createErrorResult("AI batch job " + job->batch_id +
+                                                  " still processing; rerun to collect its results"));
+            } else {
+                parts.push_back(createErrorResult("No reply found for batch request " + custom_id));
+            }
+        }
+        
+        AIAnalysisResult& result = results[request_index];
+        result = parts.size() == 1 ? std::move(parts.front()) : mergeChunkResults(parts);
+        result.analysis_duration_ms = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start_time).count());
+        if (result.success && m_response_cache) {
+            m_response_cache->store(cache_keys[request_index], result);
+        }
+        if (on_complete) {
+            on_complete(request_index, result);
+        }
+    }
+    
+    // Replies for files outside this run cannot be turned into results, so they
+    // are dropped; the rest stay journaled until the caller has persisted the
+    // results (BatchJobJournal::release)
+    size_t discarded = journal.discardMessagesExcept(seen);
+    if (discarded > 0) {
+        logProgress("Discarded " + std::to_string(discarded) + " AI batch replies for files not in this run", 1.0f);
+    }
+    journal.save(journal_path);
+    return results;
+}
+
+std::vector<size_t> ClaudeAnalyzer::takeCachedResults(const std::vector<AIAnalysisRequest>& requests,
+                                                      std::vector<AIAnalysisResult>& results,
+                                                      std::vector<std::string>& cache_keys,
+                                                      const BatchCompletionCallback& on_complete) {
+    std::vector<size_t> pending;
+    cache_keys.assign(requests.size(), std::string());
+    for (size_t i = 0; i < requests.size(); ++i) {
+        if (m_response_cache) {
+            cache_keys[i] = responseCacheKey(requests[i]);
+            if (m_response_cache->lookup(cache_keys[i], results[i])) {
+                results[i].analysis_duration_ms = 0;
+                if (on_complete) {
+                    on_complete(i, results[i]);
+                }
+                continue;
+            }
+        }
+        pending.push_back(i);
+    }
+    if (m_response_cache) {
+        size_t reused = requests.size() - pending.size();
+        logProgress("Reused " + std::to_string(reused) + " cached AI analyses",
+                    static_cast<float>(reused) / static_cast<float>(requests.size()));
+    }
+    return pending;
+}
+
+bool ClaudeAnalyzer::submitBatchJob(const json& job_requests, BatchJobRecord& job, std::string& error) {
+    std::string request_body = json{{"requests", job_requests}}.dump();
+    auto headers = buildRequestHeaders();
+    
+    // Not sent through retryableAPICall: after a dropped connection or a
+    // server error the job may exist anyway, and a second create would pay
+    // for every prompt twice. Only an explicit refusal (429, 529) is retried;
+    // anything else is reported and the prompts are submitted on the next run.
+    HTTPClient::HTTPResponse response;
+    for (int attempt = 0; ; ++attempt) {
+        m_scheduler->acquire(RequestPriority::Bulk, 0);
+        response = m_http_client->post(m_config.api_base_url + "/v1/messages/batches", request_body, headers,
+                                       m_config.batch_transfer_timeout_seconds * 1000);
+        bool refused = response.status_code == 429 || response.status_code == 529;
+        if (response.success || !refused) {
+            break;
+        }
+        std::chrono::milliseconds delay = retryDelay(attempt, response);
+        if (delay.count() < 0) {
+            break;
+        }
+        std::this_thread::sleep_for(delay);
+    }
+    if (!response.success) {
+        error = response.error_message;
+        return false;
+    }
+    
+    try {
+        json batch = json::parse(response.body);
+        job.batch_id = batch.at("id").get<std::string>();
+        job.processing_status = batch.value("processing_status", "in_progress");
+        for (const auto& entry : job_requests) {
+            job.custom_ids.push_back(entry.at("custom_id").get<std::string>());
+        }
+        return true;
+    } catch (const std::exception& e) {
+        error = "Unexpected batch response: " + std::string(e.what());
+        return false;
+    }
+}
+
+bool ClaudeAnalyzer::pollBatchJob(const std::string& batch_id, std::string& processing_status, std::string& error,
+                                  int& http_status) {
+    auto headers = buildRequestHeaders();
+    HTTPClient::HTTPResponse response = retryableAPICall([&]() {
+        return m_http_client->get(m_config.api_base_url + "/v1/messages/batches/" + batch_id, headers);
+    }, RequestPriority::Bulk, 0);
+    http_status = response.status_code;
+    if (!response.success) {
+        error = response.error_message;
+        return false;
+    }
+    
+    try {
+        processing_status = json::parse(response.body).at("processing_status").get<std::string>();
+        return true;
+    } catch (const std::exception& e) {
+        error = "Unexpected batch response: " + std::string(e.what());
+        return false;
+    }
+}
+
+bool ClaudeAnalyzer::collectBatchJob(const std::string& batch_id, BatchJobJournal& journal,
+                                     std::unordered_map<std::string, std::string>& failures, std::string& error) {
+    // One JSON object per line, in no particular order. Results can run to
+    // hundreds of megabytes, so lines are handled as they arrive
+    auto store_line = [&](const std::string& line) {
+        if (line.find_first_not_of(" \t\r") == std::string::npos) {
+            return;
+        }
+        try {
+            json entry = json::parse(line);
+            std::string custom_id = entry.at("custom_id").get<std::string>();
+            const json& result = entry.at("result");
+            std::string type = result.value("type", "");
+            if (type == "succeeded") {
+                journal.storeMessage(custom_id, result.at("message"));
+            } else if (type == "errored" && result.contains("error")) {
+                failures[custom_id] = "Batch request errored: " +
+                    result["error"].value("error", json::object()).value("message", result["error"].dump());
+            } else {
+                failures[custom_id] = "Batch request " + (type.empty() ? std::string("failed") : type);
+            }
+        } catch (const std::exception& e) {
+            logError("Skipping malformed batch result line: " + std::string(e.what()));
+        }
+    };
+    
+    auto headers = buildRequestHeaders();
+    std::string partial_line;
+    HTTPClient::HTTPResponse response = retryableAPICall([&]() {
+        partial_line.clear(); // A retry downloads the results from the start
+        return m_http_client->getStream(m_config.api_base_url + "/v1/messages/batches/" + batch_id + "/results", headers,
+            [&](const char* data, size_t size) {
+                partial_line.append(data, size);
+                size_t line_start = 0;
+                for (size_t newline; (newline = partial_line.find('\n', line_start)) != std::string::npos;
+                     line_start = newline + 1) {
+                    store_line(partial_line.substr(line_start, newline - line_start));
+                }
+                partial_line.erase(0, line_start);
+                return true;
+            }, m_config.batch_transfer_timeout_seconds * 1000);
+    }, RequestPriority::Bulk, 0);
+    if (!response.success) {
+        error = response.error_message;
+        return false;
+    }
+    store_line(partial_line);
+    return true;
+}
+
+HTTPClient::HTTPRequest ClaudeAnalyzer::buildHTTPRequest(const PromptLayout& layout) {
+    HTTPClient::HTTPRequest http_request;
+    http_request.url = m_config.api_base_url + "/v1/messages";
+    http_request.body = buildRequestBody(layout);
+    http_request.headers = buildRequestHeaders();
+    http_request.timeout_ms = m_config.timeout_seconds * 1000;
+    return http_request;
+}
+
+void ClaudeAnalyzer::sendBatch(const std::vector<HTTPClient::HTTPRequest>& http_requests, RequestPriority priority,
+                               const HTTPClient::CompletionCallback& on_complete,
+                               std::chrono::steady_clock::time_point send_deadline) {
+    if (http_requests.empty()) {
+        return;
+    }
+    size_t concurrency = static_cast<size_t>(std::max(1, m_config.max_concurrent_requests));
+    
+    std::vector<int64_t> estimated_tokens;
+    estimated_tokens.reserve(http_requests.size());
+    for (const auto& http_request : http_requests) {
+        estimated_tokens.push_back(estimateInputTokens(http_request.body));
+    }
+    HTTPClient::DispatchPolicy policy;
+    policy.admit = [&](size_t index) {
+        if (m_now() >= send_deadline) {
+            return std::chrono::milliseconds(-1);
+        }
+        return m_scheduler->tryAcquire(priority, estimated_tokens[index]);
+    };
+    policy.retry_delay = [&](size_t, int attempt, const HTTPClient::HTTPResponse& response) {
+        return retryDelay(attempt, response);
+    };
+    
+    m_http_client->postMany(http_requests, concurrency, on_complete, policy);
+}
+
+std::vector<PromptLayout> ClaudeAnalyzer::buildReviewPrompts(const AIAnalysisRequest& request, std::string& error) {
+    // Detect Unity APIs in the code, unless the pipeline already did
+    UnityAPIUsage scanned;
+    const UnityAPIUsage& api_usage = resolveAPIUsage(request, scanned);
+    
+    PromptLayout layout = constructPromptLayout(request, api_usage);
+    int64_t context_limit = m_config.max_context_length;
+    if (context_limit <= 0 || estimateInputTokens(buildRequestBody(layout)) + MAX_OUTPUT_TOKENS <= context_limit) {
+        return {layout};
+    }
+    
+    // Whatever the prompt needs besides the code and its API list is paid
+    // again by every chunk
+    AIAnalysisRequest outline = request;
+    outline.code_content.clear();
+    UnityAPIUsage outline_usage = api_usage;
+    outline_usage.detected_apis.clear();
+    int64_t overhead_tokens = estimateInputTokens(buildRequestBody(constructPromptLayout(outline, outline_usage)));
+    int64_t code_tokens = context_limit - MAX_OUTPUT_TOKENS - overhead_tokens - CHUNK_HEADER_TOKENS;
+    
+    static const std::vector<Unity::MethodSpan> no_method_spans;
+    const std::vector<Unity::MethodSpan>& method_spans =
+        request.component ? request.component->method_spans : no_method_spans;
+    
+    // A chunk's API list grows with its code, so the budget shrinks in
+    // proportion to the worst overflow until every chunk fits
+    for (int attempt = 0; attempt < MAX_CHUNKING_ATTEMPTS && code_tokens >= MIN_CHUNK_TOKENS; ++attempt) {
+        CodeChunker chunker(static_cast<size_t>(code_tokens * CHARS_PER_TOKEN));
+        std::vector<CodeChunk> chunks = chunker.split(request.code_content, method_spans);
+        
+        std::vector<PromptLayout> prompts;
+        prompts.reserve(chunks.size());
+        int64_t overflow_tokens = 0;
+        for (const auto& chunk : chunks) {
+            // Each chunk lists only the API calls it contains
+            UnityAPIUsage chunk_usage = outline_usage;
+            for (const auto& api : api_usage.detected_apis) {
+                size_t line = static_cast<size_t>(std::max(0, api.line_number));
+                if (line >= chunk.start_line && line <= chunk.end_line) {
+                    chunk_usage.detected_apis.push_back(api);
+                }
+            }
+            prompts.push_back(constructPromptLayout(request, chunk_usage, &chunk));
+            overflow_tokens = std::max(overflow_tokens, estimateInputTokens(buildRequestBody(prompts.back())) +
+                                                        MAX_OUTPUT_TOKENS - context_limit);
+        }
+        
+        if (overflow_tokens <= 0) {
+            logProgress("Split " + request.component_name + " into " + std::to_string(prompts.size()) +
+                        " chunks to fit max_context_length", 0.2f);
+            return prompts;
+        }
+        code_tokens = code_tokens * code_tokens / (code_tokens + overflow_tokens) * 9 / 10;
+    }
+    
+    error = "max_context_length (" + std::to_string(context_limit) + " tokens) leaves no room to review " +
+            request.file_path;
+    return {};
+}
+
+PromptLayout ClaudeAnalyzer::constructPromptLayout(const AIAnalysisRequest& request, const UnityAPIUsage& api_usage,
+                                                   const CodeChunk* chunk) {
+    PromptLayout layout;
+    layout.system_message = constructSystemMessage(request.analysis_type);
+    layout.project_prefix = constructProjectPrefix(request);
+    layout.file_suffix = constructFileSuffix(request, api_usage, chunk);
+    return layout;
 }
 
-std::string ClaudeAnalyzer::constructPrompt(const AIAnalysisRequest& request, const UnityAPIUsage& api_usage) {
+std::string ClaudeAnalyzer::constructProjectPrefix(const AIAnalysisRequest& request) {
+    // Nothing file-specific may appear here, or the cached prefix stops matching
     std::stringstream prompt;
     
     prompt << "# Unity Code Analysis Request\n\n";
@@ -90,10 +758,60 @@ std::string ClaudeAnalyzer::constructPrompt(const AIAnalysisRequest& request, co
         prompt << request.project_context << "\n\n";
     }
     
+    // Analysis request
+    prompt << "## Analysis Request\n";
+    prompt << "**Analysis Type:** " << (request.analysis_type.empty() ? "code_review" : request.analysis_type) << "\n\n";
+    prompt << "For the component that follows, please provide a comprehensive analysis focusing on:\n";
+    
+    if (request.analysis_type == "code_review" || request.analysis_type.empty()) {
+        prompt << "1. **Code Quality**: Overall code structure and organization\n";
+        prompt << "2. **Unity Best Practices**: Proper use of Unity APIs and patterns\n";
+        prompt << "3. **Performance Issues**: Potential performance bottlenecks\n";
+        prompt << "4. **Architecture Suggestions**: Improvements to code design\n";
+        prompt << "5. **Bug Prevention**: Potential issues or edge cases\n";
+    }
+    
+    if (request.analysis_type == "performance") {
+        prompt << "1. **Performance Bottlenecks**: Expensive operations and their impact\n";
+        prompt << "2. **Memory Usage**: GC allocations and memory leaks\n";
+        prompt << "3. **CPU Optimization**: Algorithmic improvements\n";
+        prompt << "4. **Unity-Specific Optimizations**: Frame rate and rendering optimizations\n";
+    }
+    
+    if (request.analysis_type == "architecture") {
+        prompt << "1. **Design Patterns**: Current patterns and suggested improvements\n";
+        prompt << "2. **Separation of Concerns**: How well responsibilities are divided\n";
+        prompt << "3. **Maintainability**: Ease of modification and extension\n";
+        prompt << "4. **Testability**: How well the code supports unit testing\n";
+    }
+    
+    prompt << "\nProvide specific, actionable recommendations with code examples where helpful.\n";
+    
+    return prompt.str();
+}
+
+std::string ClaudeAnalyzer::constructFileSuffix(const AIAnalysisRequest& request, const UnityAPIUsage& api_usage,
+                                                const CodeChunk* chunk) {
+    std::stringstream prompt;
+    
     // Component information
     prompt << "## Component: " << request.component_name << "\n";
-    prompt << "**File:** " << request.file_path << "\n";
-    prompt << "**Analysis Type:** " << request.analysis_type << "\n\n";
+    prompt << "**File:** " << request.file_path << "\n\n";
+    
+    // Structure the MonoBehaviour analyzer already extracted
+    if (request.component) {
+        const auto& component = *request.component;
+        if (!component.unity_methods.empty()) {
+            prompt << "**Unity Callbacks:** " << joinVector(component.unity_methods) << "\n";
+        }
+        if (!component.serialized_fields.empty()) {
+            prompt << "**Serialized Fields:** " << joinVector(component.serialized_fields) << "\n";
+        }
+        if (!component.component_dependencies.empty()) {
+            prompt << "**Component Dependencies:** " << joinVector(component.component_dependencies) << "\n";
+        }
+        prompt << "\n";
+    }
     
     // Detected Unity APIs
     if (!api_usage.detected_apis.empty()) {
@@ -125,10 +843,15 @@ std::string ClaudeAnalyzer::constructPrompt(const AIAnalysisRequest& request, co
         prompt << "\n";
     }
     
-    // Unity API database insights
+    // Unity API database insights, once per API in order of first use
     prompt << "## Unity API Insights\n";
     auto& db = UnityAPIDatabase::getInstance();
+    std::set<std::string> described;
     for (const auto& api : api_usage.detected_apis) {
+        if (!described.insert(api.api_name).second) {
+            continue;
+        }
+        
         auto issues = db.getCommonIssues(api.api_name);
         auto best_practices = db.getBestPractices(api.api_name);
         
@@ -145,39 +868,28 @@ std::string ClaudeAnalyzer::constructPrompt(const AIAnalysisRequest& request, co
     prompt << "\n";
     
     // The actual code
-    prompt << "## Code to Analyze\n";
-    prompt << "```csharp\n";
-    prompt << request.code_content << "\n";
-    prompt << "```\n\n";
-    
-    // Analysis request
-    prompt << "## Analysis Request\n";
-    prompt << "Please provide a comprehensive analysis focusing on:\n";
-    
-    if (request.analysis_type == "code_review" || request.analysis_type.empty()) {
-        prompt << "1. **Code Quality**: Overall code structure and organization\n";
-        prompt << "2. **Unity Best Practices**: Proper use of Unity APIs and patterns\n";
-        prompt << "3. **Performance Issues**: Potential performance bottlenecks\n";
-        prompt << "4. **Architecture Suggestions**: Improvements to code design\n";
-        prompt << "5. **Bug Prevention**: Potential issues or edge cases\n";
-    }
-    
-    if (request.analysis_type == "performance") {
-        prompt << "1. **Performance Bottlenecks**: Expensive operations and their impact\n";
-        prompt << "2. **Memory Usage**: GC allocations and memory leaks\n";
-        prompt << "3. **CPU Optimization**: Algorithmic improvements\n";
-        prompt << "4. **Unity-Specific Optimizations**: Frame rate and rendering optimizations\n";
-    }
-    
-    if (request.analysis_type == "architecture") {
-        prompt << "1. **Design Patterns**: Current patterns and suggested improvements\n";
-        prompt << "2. **Separation of Concerns**: How well responsibilities are divided\n";
-        prompt << "3. **Maintainability**: Ease of modification and extension\n";
-        prompt << "4. **Testability**: How well the code supports unit testing\n";
+    if (chunk && chunk->count > 1) {
+        prompt << "## Code to Analyze (part " << chunk->index + 1 << " of " << chunk->count
+               << ", lines " << chunk->start_line << "-" << chunk->end_line << ")\n";
+        prompt << "This file is too large for a single request and is reviewed in parts. "
+               << "Review only the excerpt below; the skeleton outlines the rest of the file.\n\n";
+        if (!chunk->skeleton.empty()) {
+            prompt << "### File Skeleton\n";
+            prompt << "```csharp\n";
+            prompt << chunk->skeleton;
+            prompt << "```\n\n";
+            prompt << "### Excerpt\n";
+        }
+        prompt << "```csharp\n";
+        prompt << chunk->code;
+        prompt << "```\n";
+    } else {
+        prompt << "## Code to Analyze\n";
+        prompt << "```csharp\n";
+        prompt << request.code_content << "\n";
+        prompt << "```\n";
     }
     
-    prompt << "\nProvide specific, actionable recommendations with code examples where helpful.\n";
-    
     return prompt.str();
 }
 
@@ -209,40 +921,88 @@ std::string ClaudeAnalyzer::constructSystemMessage(const std::string& analysis_t
 }
 
 std::string ClaudeAnalyzer::makeAPIRequest(const std::string& prompt, const std::string& system_message) {
+    PromptLayout layout;
+    layout.system_message = system_message;
+    layout.file_suffix = prompt;
+    return makeAPIRequest(layout);
+}
+
+std::string ClaudeAnalyzer::makeAPIRequest(const PromptLayout& layout) {
     try {
-        // Construct Claude API request JSON
-        json request_json;
-        request_json["model"] = m_config.model_name;
-        request_json["max_tokens"] = 4000;
-        request_json["temperature"] = 0.1; // Low temperature for consistent analysis
-        
-        request_json["system"] = system_message;
-        
-        json user_message;
-        user_message["role"] = "user";
-        user_message["content"] = prompt;
-        request_json["messages"] = json::array({user_message});
-        
-        // Prepare headers
-        std::vector<std::pair<std::string, std::string>> headers = {
-            {"Content-Type", "application/json"},
-            {"x-api-key", m_config.api_key},
-            {"anthropic-version", "2023-06-01"}
-        };
-        
         // Make the request
-        std::string request_body = request_json.dump();
+        std::string request_body = buildRequestBody(layout);
         logError("Request URL: " + m_config.api_base_url + "/v1/messages");
         logError("Request body: " + request_body.substr(0, 1000) + "...");
-        auto response = m_http_client->post(m_config.api_base_url + "/v1/messages", request_body, headers);
+        auto headers = buildRequestHeaders();
+        auto response = retryableAPICall([&]() {
+            return m_http_client->post(m_config.api_base_url + "/v1/messages", request_body, headers);
+        }, RequestPriority::Interactive, estimateInputTokens(request_body));
         
-        if (!response.success) {
-            logError("Claude API request failed: " + response.error_message);
-            logError("Response body: " + response.body);
-            logError("Status code: " + std::to_string(response.status_code));
-            return "";
-        }
+        return extractResponseText(response);
         
+    } catch (const std::exception& e) {
+        logError("Error making Claude API request: " + std::string(e.what()));
+        return "";
+    }
+}
+
+std::string ClaudeAnalyzer::buildRequestBody(const PromptLayout& layout, bool stream) {
+    return buildRequestJSON(layout, stream).dump();
+}
+
+json ClaudeAnalyzer::buildRequestJSON(const PromptLayout& layout, bool stream) {
+    // Construct Claude API request JSON
+    json request_json;
+    request_json["model"] = m_config.model_name;
+    request_json["max_tokens"] = MAX_OUTPUT_TOKENS;
+    request_json["temperature"] = 0.1; // Low temperature for consistent analysis
+    
+    // Stable blocks come first and carry the cache breakpoints
+    json cache_control = {{"type", "ephemeral"}};
+    if (m_config.enable_prompt_caching && !layout.system_message.empty()) {
+        json system_block = {{"type", "text"}, {"text", layout.system_message}, {"cache_control", cache_control}};
+        request_json["system"] = json::array({system_block});
+    } else {
+        request_json["system"] = layout.system_message;
+    }
+    
+    json user_message;
+    user_message["role"] = "user";
+    if (layout.project_prefix.empty()) {
+        user_message["content"] = layout.file_suffix;
+    } else {
+        json prefix_block = {{"type", "text"}, {"text", layout.project_prefix}};
+        if (m_config.enable_prompt_caching) {
+            prefix_block["cache_control"] = cache_control;
+        }
+        json suffix_block = {{"type", "text"}, {"text", layout.file_suffix}};
+        user_message["content"] = json::array({prefix_block, suffix_block});
+    }
+    request_json["messages"] = json::array({user_message});
+    if (stream) {
+        request_json["stream"] = true;
+    }
+    
+    return request_json;
+}
+
+std::vector<std::pair<std::string, std::string>> ClaudeAnalyzer::buildRequestHeaders() const {
+    return {
+        {"Content-Type", "application/json"},
+        {"x-api-key", m_config.api_key},
+        {"anthropic-version", "2023-06-01"}
+    };
+}
+
+std::string ClaudeAnalyzer::extractResponseText(const HTTPClient::HTTPResponse& response) {
+    if (!response.success) {
+        logError("Claude API request failed: " + response.error_message);
+        logError("Response body: " + response.body);
+        logError("Status code: " + std::to_string(response.status_code));
+        return "";
+    }
+    
+    try {
         // Parse response JSON
         json response_json = json::parse(response.body);
         
@@ -251,6 +1011,10 @@ std::string ClaudeAnalyzer::makeAPIRequest(const std::string& prompt, const std:
             return "";
         }
         
+        if (response_json.contains("usage") && response_json["usage"].is_object()) {
+            recordUsage(response_json["usage"]);
+        }
+        
         if (response_json.contains("content") && response_json["content"].is_array() && 
             !response_json["content"].empty()) {
             return response_json["content"][0]["text"].get<std::string>();
@@ -260,11 +1024,194 @@ std::string ClaudeAnalyzer::makeAPIRequest(const std::string& prompt, const std:
         return "";
         
     } catch (const std::exception& e) {
-        logError("Error making Claude API request: " + std::string(e.what()));
+        logError("Error parsing Claude API response: " + std::string(e.what()));
+        return "";
+    }
+}
+
+std::string ClaudeAnalyzer::responseCacheKey(const AIAnalysisRequest& request) const {
+    // The prompt names the file and component, so identical code elsewhere gets its own review
+    return AIResponseCache::makeKey(request.code_content, PROMPT_TEMPLATE_VERSION, m_config.model_name,
+                                    request.analysis_type, request.file_path, request.component_name);
+}
+
+std::string ClaudeAnalyzer::batchCustomId(const AIAnalysisRequest& request, size_t chunk_index,
+                                          size_t chunk_count) const {
+    // Only per-file inputs, never the shared project context, so a journaled
+    // job is still matched after any other file changed
+    std::string file_key = AIResponseCache::makeKey(request.code_content, PROMPT_TEMPLATE_VERSION, m_config.model_name,
+                                                    request.analysis_type, request.file_path, request.component_name);
+    return file_key + "-" + std::to_string(chunk_index) + "-" + std::to_string(chunk_count);
+}
+
+const UnityAPIUsage& ClaudeAnalyzer::resolveAPIUsage(const AIAnalysisRequest& request, UnityAPIUsage& scanned) {
+    if (request.api_usage) {
+        return *request.api_usage;
+    }
+    scanned = m_api_detector.analyzeCode(request.code_content, request.file_path);
+    return scanned;
+}
+
+void ClaudeAnalyzer::recordUsage(const json& usage) {
+    std::lock_guard<std::mutex> lock(m_stats_mutex);
+    m_cache_stats.requests++;
+    m_cache_stats.input_tokens += usage.value("input_tokens", static_cast<int64_t>(0));
+    m_cache_stats.cache_creation_input_tokens += usage.value("cache_creation_input_tokens", static_cast<int64_t>(0));
+    m_cache_stats.cache_read_input_tokens += usage.value("cache_read_input_tokens", static_cast<int64_t>(0));
+}
+
+std::string ClaudeAnalyzer::makeStreamingAPIRequest(const PromptLayout& layout) {
+    try {
+        std::string request_body = buildRequestBody(layout, true);
+        auto headers = buildRequestHeaders();
+        
+        std::string text;
+        std::string raw_body;
+        std::string stream_error;
+        size_t event_count = 0;
+        
+        auto response = retryableAPICall([&]() {
+            // A retried attempt streams from the start again
+            text.clear();
+            raw_body.clear();
+            stream_error.clear();
+            
+            auto stream_progress = [&text]() {
+                float received = static_cast<float>(text.size()) / (4.0f * MAX_OUTPUT_TOKENS);
+                return 0.5f + 0.3f * std::min(1.0f, received);
+            };
+            
+            // Each bullet is reported as soon as its line is complete
+            InsightParser insights([&](const Insight& insight) {
+                logProgress(std::string("[") + InsightParser::sectionName(insight.section) + "] " + insight.text,
+                            stream_progress());
+            });
+            
+            SSEParser events([&](const SSEEvent& event) {
+                json payload = json::parse(event.data, nullptr, false);
+                if (payload.is_discarded()) {
+                    return;
+                }
+                
+                if (event.event == "message_start") {
+                    if (payload.contains("message") && payload["message"].contains("usage")) {
+                        recordUsage(payload["message"]["usage"]);
+                    }
+                } else if (event.event == "content_block_delta") {
+                    const json& delta = payload.value("delta", json::object());
+                    if (delta.value("type", "") == "text_delta") {
+                        if (text.empty()) {
+                            logProgress("Receiving Claude response...", 0.5f);
+                        }
+                        std::string fragment = delta.value("text", "");
+                        text += fragment;
+                        insights.feed(fragment);
+                    }
+                } else if (event.event == "error") {
+                    stream_error = payload.contains("error") ? payload["error"].value("message", "unknown error")
+                                                             : "unknown error";
+                }
+            });
+            
+            auto attempt = m_http_client->postStream(m_config.api_base_url + "/v1/messages", request_body, headers,
+                [&](const char* data, size_t size) {
+                    raw_body.append(data, size);
+                    events.feed(data, size);
+                    return true;
+                });
+            insights.finish();
+            event_count = events.eventCount();
+            return attempt;
+        }, RequestPriority::Interactive, estimateInputTokens(request_body));
+        
+        if (!response.success) {
+            return extractResponseText(response);
+        }
+        
+        // Servers or proxies that ignore "stream" answer with a plain JSON message
+        if (event_count == 0) {
+            response.body = raw_body;
+            return extractResponseText(response);
+        }
+        
+        if (!stream_error.empty()) {
+            logError("Claude API stream error: " + stream_error);
+            return "";
+        }
+        if (text.empty()) {
+            logError("Claude API stream ended without text");
+        }
+        return text;
+        
+    } catch (const std::exception& e) {
+        logError("Error making streaming Claude API request: " + std::string(e.what()));
         return "";
     }
 }
 
+HTTPClient::HTTPResponse ClaudeAnalyzer::retryableAPICall(const std::function<HTTPClient::HTTPResponse()>& api_call,
+                                                          RequestPriority priority, int64_t estimated_tokens) {
+    for (int attempt = 0; ; ++attempt) {
+        m_scheduler->acquire(priority, estimated_tokens);
+        HTTPClient::HTTPResponse response = api_call();
+        if (response.success) {
+            return response;
+        }
+        
+        std::chrono::milliseconds delay = retryDelay(attempt, response);
+        if (delay.count() < 0) {
+            return response;
+        }
+        std::this_thread::sleep_for(delay);
+    }
+}
+
+std::chrono::milliseconds ClaudeAnalyzer::retryDelay(int attempt, const HTTPClient::HTTPResponse& response) {
+    const std::chrono::milliseconds give_up(-1);
+    if (attempt >= m_config.max_retries) {
+        return give_up;
+    }
+    
+    // Rate limits (429), overload (529), other server errors and dropped
+    // connections are transient. A request that ran into its own deadline is not
+    // retried: a second attempt would overrun the deadline the caller asked for.
+    int status = response.status_code;
+    bool transient = status == 408 || status == 429 || status >= 500 ||
+                     (status == 0 && !response.timed_out);
+    if (!transient) {
+        return give_up;
+    }
+    
+    std::chrono::milliseconds delay = m_scheduler->backoffDelay(attempt);
+    std::string retry_after = response.header("retry-after");
+    if (!retry_after.empty()) {
+        try {
+            // Seconds form only; an HTTP-date falls back to exponential backoff
+            double seconds = std::stod(retry_after);
+            if (seconds >= 0.0) {
+                delay = std::chrono::milliseconds(static_cast<int64_t>(seconds * 1000.0));
+                // The server's wait applies to every request sharing this key
+                m_scheduler->pauseUntil(RequestScheduler::Clock::now() + delay);
+            }
+        } catch (const std::exception&) {
+        }
+    }
+    
+    logError("Claude API request failed (" + (status != 0 ? "HTTP " + std::to_string(status) : response.error_message) +
+             "), retrying in " + std::to_string(delay.count()) + " ms (retry " + std::to_string(attempt + 1) +
+             "/" + std::to_string(m_config.max_retries) + ")");
+    return delay;
+}
+
+int64_t ClaudeAnalyzer::estimateInputTokens(const std::string& request_body) {
+    return static_cast<int64_t>(request_body.size()) / CHARS_PER_TOKEN;
+}
+
+PromptCacheStats ClaudeAnalyzer::getPromptCacheStats() const {
+    std::lock_guard<std::mutex> lock(m_stats_mutex);
+    return m_cache_stats;
+}
+
 AIAnalysisResult ClaudeAnalyzer::parseAPIResponse(const std::string& response, const AIAnalysisRequest& request) {
     AIAnalysisResult result;
     result.success = true;
@@ -272,42 +1219,26 @@ AIAnalysisResult ClaudeAnalyzer::parseAPIResponse(const std::string& response, c
     
     // Extract structured information from Claude's response
     // This is a simplified parser - could be more sophisticated
+    InsightParser parser;
+    parser.feed(response);
+    parser.finish();
     
-    std::vector<std::string> lines;
-    std::istringstream iss(response);
-    std::string line;
-    
-    while (std::getline(iss, line)) {
-        lines.push_back(line);
-    }
-    
-    // Parse sections
-    std::string current_section;
-    for (const auto& line : lines) {
-        if (line.find("**") != std::string::npos) {
-            // This is a section header
-            if (line.find("Key Issues") != std::string::npos || line.find("Issues") != std::string::npos) {
-                current_section = "issues";
-            } else if (line.find("Performance") != std::string::npos) {
-                current_section = "performance";
-            } else if (line.find("Best Practices") != std::string::npos || line.find("Improvements") != std::string::npos) {
-                current_section = "best_practices";
-            } else if (line.find("Suggestions") != std::string::npos) {
-                current_section = "suggestions";
-            }
-        } else if (line.find("- ") == 0 || line.find("• ") == 0) {
-            // This is a bullet point
-            std::string item = line.substr(2); // Remove bullet point
-            
-            if (current_section == "issues") {
-                result.potential_issues.push_back(item);
-            } else if (current_section == "performance") {
-                result.performance_optimizations.push_back(item);
-            } else if (current_section == "best_practices") {
-                result.best_practices.push_back(item);
-            } else if (current_section == "suggestions") {
-                result.suggestions.push_back(item);
-            }
+    for (const auto& insight : parser.insights()) {
+        switch (insight.section) {
+            case InsightSection::Issues:
+                result.potential_issues.push_back(insight.text);
+                break;
+            case InsightSection::Performance:
+                result.performance_optimizations.push_back(insight.text);
+                break;
+            case InsightSection::BestPractices:
+                result.best_practices.push_back(insight.text);
+                break;
+            case InsightSection::Suggestions:
+                result.suggestions.push_back(insight.text);
+                break;
+            default:
+                break;
         }
     }
     
@@ -329,6 +1260,62 @@ AIAnalysisResult ClaudeAnalyzer::parseAPIResponse(const std::string& response, c
     return result;
 }
 
+AIAnalysisResult ClaudeAnalyzer::resultFromResponse(const HTTPClient::HTTPResponse& response,
+                                                    const AIAnalysisRequest& request) {
+    std::string claude_response = extractResponseText(response);
+    if (claude_response.empty()) {
+        return createErrorResult(response.error_message.empty()
+            ? "Failed to get response from Claude API"
+            : "Failed to get response from Claude API: " + response.error_message);
+    }
+    return parseAPIResponse(claude_response, request);
+}
+
+AIAnalysisResult ClaudeAnalyzer::mergeChunkResults(const std::vector<AIAnalysisResult>& parts) {
+    AIAnalysisResult merged;
+    merged.success = true;
+    merged.confidence_score = 1.0f;
+    merged.analysis_duration_ms = 0;
+    
+    for (size_t i = 0; i < parts.size(); ++i) {
+        const AIAnalysisResult& part = parts[i];
+        std::string label = "Part " + std::to_string(i + 1) + " of " + std::to_string(parts.size());
+        if (!part.success) {
+            AIAnalysisResult failed = createErrorResult(label + " failed: " + part.error_message);
+            failed.skipped = part.skipped;
+            return failed;
+        }
+        
+        if (!part.overall_assessment.empty()) {
+            if (!merged.overall_assessment.empty()) {
+                merged.overall_assessment += "\n\n";
+            }
+            merged.overall_assessment += "### " + label + "\n" + part.overall_assessment;
+        }
+        appendUnique(merged.suggestions, part.suggestions);
+        appendUnique(merged.potential_issues, part.potential_issues);
+        appendUnique(merged.best_practices, part.best_practices);
+        appendUnique(merged.performance_optimizations, part.performance_optimizations);
+        appendUnique(merged.security_concerns, part.security_concerns);
+        appendUnique(merged.design_improvements, part.design_improvements);
+        appendUnique(merged.unity_best_practices, part.unity_best_practices);
+        appendUnique(merged.lifecycle_recommendations, part.lifecycle_recommendations);
+        appendUnique(merged.performance_tips, part.performance_tips);
+        
+        for (auto [field, value] : {std::make_pair(&merged.architecture_pattern, &part.architecture_pattern),
+                                    std::make_pair(&merged.maintainability_score, &part.maintainability_score),
+                                    std::make_pair(&merged.complexity_assessment, &part.complexity_assessment)}) {
+            if (field->empty()) {
+                *field = *value;
+            }
+        }
+        
+        // A file is only as well understood as its least certain part
+        merged.confidence_score = std::min(merged.confidence_score, part.confidence_score);
+    }
+    return merged;
+}
+
 std::string ClaudeAnalyzer::createAnalysisContext(const std::string& project_metadata,
                                                  const std::vector<DetectedAPI>& unity_apis) {
     std::stringstream context;
@@ -336,7 +1323,7 @@ std::string ClaudeAnalyzer::createAnalysisContext(const std::string& project_met
     context << "Project Type: Unity Game/Application\n";
     context << "Detected APIs: ";
     
-    std::unordered_set<std::string> unique_apis;
+    std::set<std::string> unique_apis;
     for (const auto& api : unity_apis) {
         unique_apis.insert(api.api_name);
     }
@@ -1,12 +1,23 @@
 #pragma once
 
+#include <chrono>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <memory>
+#include <mutex>
 #include <functional>
+#include <unordered_map>
 #include "Configuration/AnalysisConfig.h"
+#include "RequestScheduler.h"
+#include "UnityAPIDetector.h"
 
 namespace UnityContextGen {
+
+namespace Unity {
+struct MonoBehaviourInfo;
+}
+
 namespace AI {
 
 struct AIAnalysisRequest {
@@ -16,11 +27,18 @@ struct AIAnalysisRequest {
     std::string analysis_type; // "code_review", "architecture", "performance", "security"
     std::string component_name;
     std::string file_path;
+    
+    // Results the pipeline already computed for this file, borrowed and not
+    // owned; both must outlive the analysis. Without api_usage the analyzer
+    // scans code_content itself.
+    const UnityAPIUsage* api_usage = nullptr;
+    const Unity::MonoBehaviourInfo* component = nullptr;
 };
 
 struct AIAnalysisResult {
     bool success;
     std::string error_message;
+    bool skipped = false; // Not sent: outside the review token or time budget
     
     // Analysis results
     std::string overall_assessment;
@@ -46,10 +64,121 @@ struct AIAnalysisResult {
     int analysis_duration_ms;
 };
 
+// A request prompt split by stability. The system message and project prefix
+// depend only on the project and analysis type, so they are byte-identical
+// across a run and can be served from the provider's prompt cache; only the
+// per-file suffix (component, detected APIs, code) changes between requests.
+struct PromptLayout {
+    std::string system_message;
+    std::string project_prefix;
+    std::string file_suffix;
+};
+
+// Token accounting reported by the API, for checking that caching takes effect
+struct PromptCacheStats {
+    int requests = 0;
+    int64_t input_tokens = 0;
+    int64_t cache_creation_input_tokens = 0;
+    int64_t cache_read_input_tokens = 0;
+};
+
 // Forward declarations
-class UnityAPIDatabase;
-struct DetectedAPI;
-struct UnityAPIUsage;
+class AIResponseCache;
+class BatchJobJournal;
+struct BatchJobRecord;
+struct CodeChunk;
+
+// HTTP client interface for API calls
+class HTTPClient {
+public:
+    struct HTTPResponse {
+        int status_code;
+        std::string body;
+        std::string error_message;
+        bool success;
+        bool timed_out = false;
+        bool dropped = false; // Refused by DispatchPolicy::admit and never sent
+        std::vector<std::pair<std::string, std::string>> headers;
+        
+        // Case-insensitive header lookup; empty when absent
+        std::string header(const std::string& name) const;
+    };
+    
+    struct HTTPRequest {
+        std::string url;
+        std::string body;
+        std::vector<std::pair<std::string, std::string>> headers;
+        int timeout_ms = 0; // Deadline for this request; 0 uses setTimeout
+    };
+    
+    // Invoked on the thread running postMany, once per request, in completion order
+    using CompletionCallback = std::function<void(size_t request_index, const HTTPResponse& response)>;
+    
+    // Connection reuse summed over every HTTPClient in the process
+    struct ConnectionStats {
+        int64_t transfers = 0;
+        int64_t new_connections = 0;
+        int64_t reused_connections = 0; // Transfers that rode an already open connection
+        int64_t tls_handshakes = 0;
+        int64_t http2_transfers = 0;
+        int64_t connect_time_us = 0;    // TCP connect plus TLS handshake time on new connections
+    };
+    
+    // Optional pacing for postMany. admit returns how long to hold a request
+    // back (zero sends it now, negative drops it unsent); retry_delay returns
+    // how long to wait before resending after an attempt, or a negative value
+    // to report the response.
+    struct DispatchPolicy {
+        std::function<std::chrono::milliseconds(size_t request_index)> admit;
+        std::function<std::chrono::milliseconds(size_t request_index, int attempt, const HTTPResponse& response)> retry_delay;
+    };
+    
+    HTTPClient();
+    ~HTTPClient();
+    
+    // timeout_ms, when positive, replaces the setTimeout deadline for this request
+    HTTPResponse post(const std::string& url, 
+                     const std::string& body,
+                     const std::vector<std::pair<std::string, std::string>>& headers,
+                     int timeout_ms = 0);
+    
+    HTTPResponse get(const std::string& url,
+                     const std::vector<std::pair<std::string, std::string>>& headers);
+    
+    // Receives response body bytes as they arrive; return false to abort
+    using DataCallback = std::function<bool(const char* data, size_t size)>;
+    
+    // Like post, but a successful body is handed to on_data incrementally
+    // (e.g. server-sent events) rather than buffered; error bodies are still
+    // returned in HTTPResponse::body
+    HTTPResponse postStream(const std::string& url,
+                            const std::string& body,
+                            const std::vector<std::pair<std::string, std::string>>& headers,
+                            const DataCallback& on_data);
+    
+    // Streaming counterpart of get, e.g. for downloads too large to buffer
+    HTTPResponse getStream(const std::string& url,
+                           const std::vector<std::pair<std::string, std::string>>& headers,
+                           const DataCallback& on_data,
+                           int timeout_ms = 0);
+    
+    // Runs the requests on one curl multi event loop with at most max_in_flight
+    // transfers open at a time; returns once every request has completed
+    void postMany(const std::vector<HTTPRequest>& requests, size_t max_in_flight,
+                  const CompletionCallback& on_complete,
+                  const DispatchPolicy& policy = DispatchPolicy());
+    
+    void setTimeout(int seconds);
+    void setUserAgent(const std::string& user_agent);
+    
+    // DNS results, TLS sessions and open connections are shared process-wide,
+    // so a new client (or CoreEngine) reuses the previous one's connection
+    static ConnectionStats connectionStats();
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> m_impl;
+};
 
 class ClaudeAnalyzer {
 public:
@@ -67,13 +196,40 @@ public:
     AIAnalysisResult suggestImprovements(const std::string& code_content, 
                                         const std::string& component_name);
     
-    // Batch analysis
-    std::vector<AIAnalysisResult> analyzeBatch(const std::vector<AIAnalysisRequest>& requests);
+    // Batch analysis: up to max_concurrent_requests reviews in flight at once.
+    // on_complete runs on the calling thread as each review finishes; the
+    // returned results are in request order. The review token and time
+    // budgets are spent in request order, so callers put important files first.
+    using BatchCompletionCallback = std::function<void(size_t request_index, const AIAnalysisResult& result)>;
+    std::vector<AIAnalysisResult> analyzeBatch(const std::vector<AIAnalysisRequest>& requests,
+                                               const BatchCompletionCallback& on_complete = nullptr);
+    
+    // Offline review for large unattended runs: every prompt is packed into
+    // Message Batches jobs, which cost less and sit outside the live rate
+    // limits but may take hours. Jobs are polled every batch_poll_interval_ms.
+    // Submitted jobs and their replies are recorded in the journal at
+    // journal_path. A rerun after an interruption, or after
+    // batch_max_wait_seconds ran out, collects the same jobs instead of
+    // submitting again. Collected replies stay in the journal until the
+    // caller has persisted the results and calls BatchJobJournal::release.
+    // The review budgets do not apply.
+    std::vector<AIAnalysisResult> analyzeBatchJob(const std::vector<AIAnalysisRequest>& requests,
+                                                  const std::string& journal_path,
+                                                  const BatchCompletionCallback& on_complete = nullptr);
     
     // Context management
     std::string createAnalysisContext(const std::string& project_metadata,
                                      const std::vector<DetectedAPI>& unity_apis);
     
+    PromptCacheStats getPromptCacheStats() const;
+    
+    // Results for unchanged code are served from here instead of the API
+    void setResponseCache(std::shared_ptr<AIResponseCache> cache) { m_response_cache = std::move(cache); }
+    
+    // Time source for the review time budget; tests substitute a manual clock
+    using Clock = std::chrono::steady_clock;
+    void setClock(std::function<Clock::time_point()> now) { m_now = std::move(now); }
+    
     // Progress callback
     using ProgressCallback = std::function<void(const std::string&, float)>;
     void setProgressCallback(ProgressCallback callback) { m_progress_callback = callback; }
@@ -82,17 +238,61 @@ private:
     bool m_initialized;
     Config::AIAnalysisConfig m_config;
     ProgressCallback m_progress_callback;
+    PromptCacheStats m_cache_stats;
+    mutable std::mutex m_stats_mutex;
+    
+    // Rate limiting and retries shared by single and batched requests
+    std::unique_ptr<RequestScheduler> m_scheduler;
+    std::shared_ptr<AIResponseCache> m_response_cache;
+    std::function<Clock::time_point()> m_now = Clock::now;
     
     // HTTP client for API calls
-    std::unique_ptr<class HTTPClient> m_http_client;
+    std::unique_ptr<HTTPClient> m_http_client;
+    
+    // Fallback for requests that arrive without precomputed API usage
+    UnityAPIDetector m_api_detector;
     
     // API interaction
     std::string makeAPIRequest(const std::string& prompt, const std::string& system_message = "");
-    std::string constructPrompt(const AIAnalysisRequest& request, const UnityAPIUsage& api_usage);
+    std::string makeAPIRequest(const PromptLayout& layout);
+    std::string makeStreamingAPIRequest(const PromptLayout& layout);
+    HTTPClient::HTTPRequest buildHTTPRequest(const PromptLayout& layout);
+    void sendBatch(const std::vector<HTTPClient::HTTPRequest>& http_requests, RequestPriority priority,
+                   const HTTPClient::CompletionCallback& on_complete,
+                   std::chrono::steady_clock::time_point send_deadline = std::chrono::steady_clock::time_point::max());
+    std::string buildRequestBody(const PromptLayout& layout, bool stream = false);
+    nlohmann::json buildRequestJSON(const PromptLayout& layout, bool stream = false);
+    std::vector<std::pair<std::string, std::string>> buildRequestHeaders() const;
+    std::string extractResponseText(const HTTPClient::HTTPResponse& response);
+    void recordUsage(const nlohmann::json& usage);
+    PromptLayout constructPromptLayout(const AIAnalysisRequest& request, const UnityAPIUsage& api_usage,
+                                       const CodeChunk* chunk = nullptr);
+    std::string constructProjectPrefix(const AIAnalysisRequest& request);
+    std::string constructFileSuffix(const AIAnalysisRequest& request, const UnityAPIUsage& api_usage,
+                                    const CodeChunk* chunk = nullptr);
+    
+    // One prompt per review request, or one per chunk when the file would not
+    // fit in max_context_length; empty with error set when no split fits
+    std::vector<PromptLayout> buildReviewPrompts(const AIAnalysisRequest& request, std::string& error);
+    
+    // Fills in cached results and reports them; returns the indices left to review
+    std::vector<size_t> takeCachedResults(const std::vector<AIAnalysisRequest>& requests,
+                                          std::vector<AIAnalysisResult>& results,
+                                          std::vector<std::string>& cache_keys,
+                                          const BatchCompletionCallback& on_complete);
+    
+    // Message Batches API: create a job, read its status, store its replies
+    bool submitBatchJob(const nlohmann::json& job_requests, BatchJobRecord& job, std::string& error);
+    bool pollBatchJob(const std::string& batch_id, std::string& processing_status, std::string& error,
+                      int& http_status);
+    bool collectBatchJob(const std::string& batch_id, BatchJobJournal& journal,
+                         std::unordered_map<std::string, std::string>& failures, std::string& error);
     std::string constructSystemMessage(const std::string& analysis_type);
     
     // Response parsing
     AIAnalysisResult parseAPIResponse(const std::string& response, const AIAnalysisRequest& request);
+    AIAnalysisResult resultFromResponse(const HTTPClient::HTTPResponse& response, const AIAnalysisRequest& request);
+    AIAnalysisResult mergeChunkResults(const std::vector<AIAnalysisResult>& parts);
     std::vector<std::string> extractListItems(const std::string& text, const std::string& section_marker);
     float extractConfidenceScore(const std::string& response);
     
@@ -103,8 +303,15 @@ private:
     // Helper methods
     std::string joinVector(const std::vector<std::string>& vec);
     
-    // Retry logic
-    AIAnalysisResult retryableAPICall(const std::function<AIAnalysisResult()>& api_call);
+    // Retry logic: sends through the scheduler, retrying rate-limit, overload,
+    // server and connection errors up to max_retries times
+    HTTPClient::HTTPResponse retryableAPICall(const std::function<HTTPClient::HTTPResponse()>& api_call,
+                                              RequestPriority priority, int64_t estimated_tokens);
+    std::chrono::milliseconds retryDelay(int attempt, const HTTPClient::HTTPResponse& response);
+    static int64_t estimateInputTokens(const std::string& request_body);
+    std::string responseCacheKey(const AIAnalysisRequest& request) const;
+    std::string batchCustomId(const AIAnalysisRequest& request, size_t chunk_index, size_t chunk_count) const;
+    const UnityAPIUsage& resolveAPIUsage(const AIAnalysisRequest& request, UnityAPIUsage& scanned);
     
     // Error handling
     AIAnalysisResult createErrorResult(const std::string& error_message);
@@ -112,30 +319,5 @@ private:
     void logProgress(const std::string& message, float progress);
 };
 
-// HTTP client interface for API calls
-class HTTPClient {
-public:
-    struct HTTPResponse {
-        int status_code;
-        std::string body;
-        std::string error_message;
-        bool success;
-    };
-    
-    HTTPClient();
-    ~HTTPClient();
-    
-    HTTPResponse post(const std::string& url, 
-                     const std::string& body,
-                     const std::vector<std::pair<std::string, std::string>>& headers);
-    
-    void setTimeout(int seconds);
-    void setUserAgent(const std::string& user_agent);
-
-private:
-    class Impl;
-    std::unique_ptr<Impl> m_impl;
-};
-
 } // namespace AI
 } // namespace UnityContextGen
\ No newline at end of file
@@ -0,0 +1,204 @@
+#include "CodeChunker.h"
+#include <algorithm>
+
+namespace UnityContextGen {
+namespace AI {
+
+static const std::string SKELETON_TRUNCATED_MARKER = "// ... skeleton truncated\n";
+
+CodeChunker::CodeChunker(size_t max_chunk_chars) : m_max_chunk_chars(std::max<size_t>(1, max_chunk_chars)) {
+}
+
+std::vector<CodeChunk> CodeChunker::split(const std::string& code_content,
+                                          const std::vector<Unity::MethodSpan>& method_ranges) const {
+    std::vector<std::string> lines = splitLines(code_content);
+    std::vector<Unity::MethodSpan> ranges = normalizeRanges(method_ranges, lines.size());
+
+    if (code_content.size() <= m_max_chunk_chars) {
+        CodeChunk whole;
+        whole.index = 0;
+        whole.count = 1;
+        whole.start_line = 1;
+        whole.end_line = lines.size();
+        whole.code = code_content;
+        for (const auto& range : ranges) {
+            whole.methods.push_back(range.name);
+        }
+        return {whole};
+    }
+
+    std::string skeleton = ranges.empty() ? std::string() : buildSkeleton(lines, ranges);
+    bool skeleton_complete = skeleton.size() < SKELETON_TRUNCATED_MARKER.size() ||
+        skeleton.compare(skeleton.size() - SKELETON_TRUNCATED_MARKER.size(), std::string::npos,
+                         SKELETON_TRUNCATED_MARKER) != 0;
+    size_t budget = std::max<size_t>(1, m_max_chunk_chars - std::min(skeleton.size(), m_max_chunk_chars - 1));
+
+    // Units are packed whole. Code between methods already appears verbatim in
+    // the skeleton, so it is only sent again when the skeleton had to be cut.
+    std::vector<Unity::MethodSpan> units;
+    if (ranges.empty()) {
+        for (size_t line = 1; line <= lines.size(); ++line) {
+            units.push_back({"", line, line});
+        }
+    } else {
+        size_t next_line = 1;
+        for (const auto& range : ranges) {
+            if (!skeleton_complete && range.start_line > next_line) {
+                units.push_back({"", next_line, range.start_line - 1});
+            }
+            units.push_back(range);
+            next_line = range.end_line + 1;
+        }
+        if (!skeleton_complete && next_line <= lines.size()) {
+            units.push_back({"", next_line, lines.size()});
+        }
+    }
+
+    std::vector<CodeChunk> chunks;
+    CodeChunk current;
+    auto flush = [&chunks, &current]() {
+        if (!current.code.empty()) {
+            chunks.push_back(std::move(current));
+        }
+        current = CodeChunk();
+    };
+    auto append = [&current](const std::string& text, size_t start_line, size_t end_line) {
+        if (current.code.empty()) {
+            current.start_line = start_line;
+        }
+        current.end_line = end_line;
+        current.code += text;
+    };
+
+    for (const auto& unit : units) {
+        std::string text;
+        for (size_t line = unit.start_line; line <= unit.end_line; ++line) {
+            text += lines[line - 1];
+            text += '\n';
+        }
+
+        if (text.size() <= budget) {
+            if (current.code.size() + text.size() > budget) {
+                flush();
+            }
+            append(text, unit.start_line, unit.end_line);
+            if (!unit.name.empty()) {
+                current.methods.push_back(unit.name);
+            }
+            continue;
+        }
+
+        // Oversized declaration: cut between lines, and a single overlong line by size
+        flush();
+        for (size_t line = unit.start_line; line <= unit.end_line; ++line) {
+            std::string line_text = lines[line - 1] + '\n';
+            if (current.code.size() + line_text.size() > budget) {
+                flush();
+            }
+            while (line_text.size() > budget) {
+                append(line_text.substr(0, budget), line, line);
+                line_text.erase(0, budget);
+                flush();
+            }
+            append(line_text, line, line);
+        }
+        flush();
+    }
+    flush();
+
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        chunks[i].index = i;
+        chunks[i].count = chunks.size();
+        chunks[i].skeleton = skeleton;
+    }
+    return chunks;
+}
+
+std::string CodeChunker::buildSkeleton(const std::vector<std::string>& lines,
+                                       const std::vector<Unity::MethodSpan>& method_ranges) const {
+    std::vector<Unity::MethodSpan> ranges = normalizeRanges(method_ranges, lines.size());
+    std::string skeleton;
+
+    size_t next_range = 0;
+    for (size_t line = 1; line <= lines.size(); ++line) {
+        if (next_range < ranges.size() && line == ranges[next_range].start_line) {
+            const Unity::MethodSpan& range = ranges[next_range++];
+
+            // Attribute lines come before the one naming the method
+            size_t signature_line = range.start_line;
+            for (size_t candidate = range.start_line; candidate <= range.end_line; ++candidate) {
+                if (lines[candidate - 1].find(range.name + "(") != std::string::npos ||
+                    lines[candidate - 1].find(range.name + " (") != std::string::npos) {
+                    signature_line = candidate;
+                    break;
+                }
+            }
+            for (size_t attribute = range.start_line; attribute < signature_line; ++attribute) {
+                skeleton += lines[attribute - 1] + '\n';
+            }
+
+            std::string signature = lines[signature_line - 1];
+            while (!signature.empty() && (signature.back() == ' ' || signature.back() == '\t' ||
+                                          signature.back() == '\r' || signature.back() == '{')) {
+                signature.pop_back();
+            }
+            skeleton += signature + " { ... } // lines " + std::to_string(range.start_line) + "-" +
+                        std::to_string(range.end_line) + "\n";
+            line = range.end_line;
+            continue;
+        }
+        skeleton += lines[line - 1] + '\n';
+    }
+
+    // At most half of each chunk goes to the outline
+    size_t limit = m_max_chunk_chars / 2;
+    if (skeleton.size() > limit) {
+        size_t marker_size = SKELETON_TRUNCATED_MARKER.size();
+        size_t cut = limit > marker_size ? skeleton.rfind('\n', limit - marker_size) : std::string::npos;
+        skeleton.resize(cut == std::string::npos ? 0 : cut + 1);
+        skeleton += SKELETON_TRUNCATED_MARKER;
+    }
+    return skeleton;
+}
+
+std::vector<std::string> CodeChunker::splitLines(const std::string& code_content) {
+    std::vector<std::string> lines;
+    size_t start = 0;
+    while (start < code_content.size()) {
+        size_t newline = code_content.find('\n', start);
+        if (newline == std::string::npos) {
+            lines.push_back(code_content.substr(start));
+            break;
+        }
+        lines.push_back(code_content.substr(start, newline - start));
+        start = newline + 1;
+    }
+    return lines;
+}
+
+std::vector<Unity::MethodSpan> CodeChunker::normalizeRanges(const std::vector<Unity::MethodSpan>& method_ranges, size_t line_count) {
+    std::vector<Unity::MethodSpan> ranges;
+    for (const auto& range : method_ranges) {
+        if (range.start_line == 0 || range.start_line > line_count || range.end_line < range.start_line) {
+            continue;
+        }
+        ranges.push_back(range);
+        ranges.back().end_line = std::min(range.end_line, line_count);
+    }
+    std::sort(ranges.begin(), ranges.end(), [](const Unity::MethodSpan& a, const Unity::MethodSpan& b) {
+        return a.start_line < b.start_line;
+    });
+
+    // Local functions and overlaps stay inside the enclosing declaration
+    std::vector<Unity::MethodSpan> outermost;
+    for (const auto& range : ranges) {
+        if (!outermost.empty() && range.start_line <= outermost.back().end_line) {
+            continue;
+        }
+        outermost.push_back(range);
+    }
+    return outermost;
+}
+
+} // namespace AI
+} // namespace UnityContextGen
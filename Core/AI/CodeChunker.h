@@ -0,0 +1,47 @@
+#pragma once
+
+#include "UnityAnalyzer/MethodSpan.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace UnityContextGen {
+namespace AI {
+
+struct CodeChunk {
+    size_t index;
+    size_t count;      // Chunks the file was split into
+    size_t start_line; // Span of code covered by this chunk
+    size_t end_line;
+    std::string skeleton; // Shared outline of the file, identical in every chunk
+    std::string code;
+    std::vector<std::string> methods; // Declarations wholly inside this chunk
+};
+
+// Splits a source file that is too large for one prompt. Each chunk carries
+// whole methods where possible (a method larger than the budget is cut at
+// line boundaries) plus a skeleton of everything outside method bodies
+// (usings, class declarations, fields) with one signature line per method,
+// so every chunk can be reviewed with the shape of the whole class in view.
+class CodeChunker {
+public:
+    explicit CodeChunker(size_t max_chunk_chars);
+    ~CodeChunker() = default;
+
+    // Without method ranges the file is split at line boundaries and no
+    // skeleton is attached. A file within the budget yields one chunk.
+    std::vector<CodeChunk> split(const std::string& code_content,
+                                 const std::vector<Unity::MethodSpan>& method_ranges) const;
+
+    std::string buildSkeleton(const std::vector<std::string>& lines,
+                              const std::vector<Unity::MethodSpan>& method_ranges) const;
+
+private:
+    size_t m_max_chunk_chars;
+
+    static std::vector<std::string> splitLines(const std::string& code_content);
+    static std::vector<Unity::MethodSpan> normalizeRanges(const std::vector<Unity::MethodSpan>& method_ranges, size_t line_count);
+};
+
+} // namespace AI
+} // namespace UnityContextGen
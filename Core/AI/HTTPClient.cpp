@@ -1,7 +1,12 @@
 #include "ClaudeAnalyzer.h"
 #include <curl/curl.h>
+#include <algorithm>
+#include <cctype>
+#include <deque>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <thread>
 
 namespace UnityContextGen {
 namespace AI {
@@ -13,64 +18,221 @@ size_t WriteCallback(void* contents, size_t size, size_t nmemb, std::string* use
     return totalSize;
 }
 
-class HTTPClient::Impl {
+// CURL header callback; a status line starts a fresh header set (100 Continue, redirects)
+size_t HeaderCallback(char* buffer, size_t size, size_t nitems,
+                      std::vector<std::pair<std::string, std::string>>* headers) {
+    size_t totalSize = size * nitems;
+    std::string line(buffer, totalSize);
+    if (line.compare(0, 5, "HTTP/") == 0) {
+        headers->clear();
+        return totalSize;
+    }
+    
+    size_t colon = line.find(':');
+    if (colon != std::string::npos) {
+        std::string value = line.substr(colon + 1);
+        size_t first = value.find_first_not_of(" \t");
+        size_t last = value.find_last_not_of(" \t\r\n");
+        value = first == std::string::npos ? "" : value.substr(first, last - first + 1);
+        headers->emplace_back(line.substr(0, colon), value);
+    }
+    return totalSize;
+}
+
+std::string HTTPClient::HTTPResponse::header(const std::string& name) const {
+    auto same_name = [](const std::string& a, const std::string& b) {
+        return a.size() == b.size() &&
+               std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+                   return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+               });
+    };
+    for (const auto& entry : headers) {
+        if (same_name(entry.first, name)) {
+            return entry.second;
+        }
+    }
+    return "";
+}
+
+// Where a streamed transfer delivers its body: successful responses to the
+// receiver, anything else buffered so the error can be reported
+struct StreamTarget {
+    CURL* handle;
+    const HTTPClient::DataCallback* on_data;
+    std::string* error_body;
+};
+
+// CURL streaming callback; returning short of totalSize aborts the transfer
+size_t StreamCallback(void* contents, size_t size, size_t nmemb, StreamTarget* target) {
+    size_t totalSize = size * nmemb;
+    long response_code = 0;
+    curl_easy_getinfo(target->handle, CURLINFO_RESPONSE_CODE, &response_code);
+    if (response_code >= 200 && response_code < 300) {
+        return (*target->on_data)(static_cast<const char*>(contents), totalSize) ? totalSize : 0;
+    }
+    target->error_body->append(static_cast<char*>(contents), totalSize);
+    return totalSize;
+}
+
+// Idle easy handles kept for reuse; more than this are freed on release
+static const size_t MAX_IDLE_HANDLES = 16;
+
+// Process-wide curl state. The share handle holds the DNS cache, TLS session
+// cache and connection cache, so connections stay open after the HTTPClient
+// (and the CoreEngine owning it) that opened them is gone and the next
+// request skips the TCP and TLS handshakes. Easy handles are recycled too.
+class ConnectionPool {
 public:
-    Impl() : curl(nullptr), timeout_seconds(30) {
-        curl = curl_easy_init();
-        if (!curl) {
-            throw std::runtime_error("Failed to initialize CURL");
+    static ConnectionPool& instance() {
+        static ConnectionPool pool;
+        return pool;
+    }
+    
+    // A handle attached to the share, in its default state; nullptr on failure
+    CURL* acquire() {
+        {
+            std::lock_guard<std::mutex> lock(m_idle_mutex);
+            if (!m_idle.empty()) {
+                CURL* handle = m_idle.back();
+                m_idle.pop_back();
+                return handle;
+            }
+        }
+        CURL* handle = curl_easy_init();
+        if (handle && m_share) {
+            curl_easy_setopt(handle, CURLOPT_SHARE, m_share);
+        }
+        return handle;
+    }
+    
+    // Connections belong to the share, so recycling a handle never closes one
+    void release(CURL* handle) {
+        if (!handle) {
+            return;
+        }
+        curl_easy_reset(handle); // Keeps the share attached
+        std::lock_guard<std::mutex> lock(m_idle_mutex);
+        if (m_idle.size() < MAX_IDLE_HANDLES) {
+            m_idle.push_back(handle);
+        } else {
+            curl_easy_cleanup(handle);
         }
     }
     
-    ~Impl() {
-        if (curl) {
-            curl_easy_cleanup(curl);
+    // Called once per finished transfer, before the handle is released
+    void record(CURL* handle) {
+        long connects = 0;
+        long http_version = 0;
+        curl_off_t connect_us = 0;
+        curl_off_t tls_us = 0;
+        curl_easy_getinfo(handle, CURLINFO_NUM_CONNECTS, &connects);
+        curl_easy_getinfo(handle, CURLINFO_HTTP_VERSION, &http_version);
+        curl_easy_getinfo(handle, CURLINFO_CONNECT_TIME_T, &connect_us);
+        curl_easy_getinfo(handle, CURLINFO_APPCONNECT_TIME_T, &tls_us);
+        
+        std::lock_guard<std::mutex> lock(m_stats_mutex);
+        ++m_stats.transfers;
+        if (connects > 0) {
+            m_stats.new_connections += connects;
+            m_stats.connect_time_us += std::max(connect_us, tls_us);
+            if (tls_us > 0) {
+                ++m_stats.tls_handshakes;
+            }
+        } else {
+            ++m_stats.reused_connections;
         }
+        if (http_version == CURL_HTTP_VERSION_2_0) {
+            ++m_stats.http2_transfers;
+        }
+    }
+    
+    HTTPClient::ConnectionStats stats() const {
+        std::lock_guard<std::mutex> lock(m_stats_mutex);
+        return m_stats;
     }
     
-    HTTPResponse post(const std::string& url, const std::string& body,
-                     const std::vector<std::pair<std::string, std::string>>& headers) {
+private:
+    CURLSH* m_share;
+    std::mutex m_share_locks[CURL_LOCK_DATA_LAST];
+    std::mutex m_idle_mutex;
+    std::vector<CURL*> m_idle;
+    mutable std::mutex m_stats_mutex;
+    HTTPClient::ConnectionStats m_stats;
+    
+    ConnectionPool() : m_share(nullptr) {
+        curl_global_init(CURL_GLOBAL_DEFAULT);
+        m_share = curl_share_init();
+        if (!m_share) {
+            std::cerr << "[HTTPClient] CURL share handle unavailable; connections will not be pooled" << std::endl;
+            return;
+        }
+        curl_share_setopt(m_share, CURLSHOPT_LOCKFUNC, lockShare);
+        curl_share_setopt(m_share, CURLSHOPT_UNLOCKFUNC, unlockShare);
+        curl_share_setopt(m_share, CURLSHOPT_USERDATA, this);
+        curl_share_setopt(m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        curl_share_setopt(m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+        curl_share_setopt(m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+    }
+    
+    ~ConnectionPool() {
+        for (CURL* handle : m_idle) {
+            curl_easy_cleanup(handle);
+        }
+        if (m_share) {
+            curl_share_cleanup(m_share);
+        }
+        curl_global_cleanup();
+    }
+    
+    ConnectionPool(const ConnectionPool&) = delete;
+    ConnectionPool& operator=(const ConnectionPool&) = delete;
+    
+    static void lockShare(CURL*, curl_lock_data data, curl_lock_access, void* userptr) {
+        static_cast<ConnectionPool*>(userptr)->m_share_locks[data].lock();
+    }
+    
+    static void unlockShare(CURL*, curl_lock_data data, void* userptr) {
+        static_cast<ConnectionPool*>(userptr)->m_share_locks[data].unlock();
+    }
+};
+
+class HTTPClient::Impl {
+public:
+    Impl() : timeout_seconds(30) {
+        // Set up the shared caches before any handle is created
+        ConnectionPool::instance();
+    }
+    
+    // A POST of body, or a GET without one. With on_data set, 2xx body bytes
+    // go to it as they arrive instead of into response.body. A positive
+    // timeout_ms replaces timeout_seconds for this request
+    HTTPResponse perform(const std::string& url, const std::string* body,
+                         const std::vector<std::pair<std::string, std::string>>& headers,
+                         const DataCallback* on_data = nullptr, int timeout_ms = 0) {
         HTTPResponse response;
+        response.status_code = 0;
         response.success = false;
         
+        // Each call borrows its own handle, so concurrent posts do not wait on each other
+        ConnectionPool& pool = ConnectionPool::instance();
+        CURL* curl = pool.acquire();
         if (!curl) {
-            response.error_message = "CURL not initialized";
+            response.error_message = "Failed to initialize CURL";
             return response;
         }
         
-        // Reset CURL handle
-        curl_easy_reset(curl);
-        
-        // Set URL
-        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-        
-        // Set POST request
-        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body.c_str());
-        
-        // Set headers
-        struct curl_slist* header_list = nullptr;
-        for (const auto& header : headers) {
-            std::string header_str = header.first + ": " + header.second;
-            header_list = curl_slist_append(header_list, header_str.c_str());
-        }
-        if (header_list) {
-            curl_easy_setopt(curl, CURLOPT_HTTPHEADER, header_list);
-        }
-        
-        // Set response callback
         std::string response_body;
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response_body);
-        
-        // Set timeout
-        curl_easy_setopt(curl, CURLOPT_TIMEOUT, timeout_seconds);
+        struct curl_slist* header_list = configure(curl, url, body, headers, &response_body, &response.headers);
         
-        // Set user agent
-        curl_easy_setopt(curl, CURLOPT_USERAGENT, user_agent.c_str());
+        if (timeout_ms > 0) {
+            curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, static_cast<long>(timeout_ms));
+        }
         
-        // Disable SSL verification for development (should be enabled in production)
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0L);
+        StreamTarget stream_target{curl, on_data, &response_body};
+        if (on_data) {
+            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, StreamCallback);
+            curl_easy_setopt(curl, CURLOPT_WRITEDATA, &stream_target);
+        }
         
         // Perform request
         CURLcode res = curl_easy_perform(curl);
@@ -80,15 +242,19 @@ public:
             curl_slist_free_all(header_list);
         }
         
+        long response_code = 0;
+        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response_code);
+        pool.record(curl);
+        pool.release(curl);
+        
         if (res != CURLE_OK) {
-            response.error_message = "CURL error: " + std::string(curl_easy_strerror(res));
+            response.error_message = res == CURLE_WRITE_ERROR && on_data
+                ? "Stream cancelled by receiver"
+                : "CURL error: " + std::string(curl_easy_strerror(res));
+            response.timed_out = (res == CURLE_OPERATION_TIMEDOUT);
             return response;
         }
         
-        // Get response code
-        long response_code = 0;
-        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response_code);
-        
         response.status_code = static_cast<int>(response_code);
         response.body = response_body;
         response.success = (response_code >= 200 && response_code < 300);
@@ -100,6 +266,195 @@ public:
         return response;
     }
     
+    void postMany(const std::vector<HTTPRequest>& requests, size_t max_in_flight,
+                  const CompletionCallback& on_complete, const DispatchPolicy& policy) {
+        using Clock = std::chrono::steady_clock;
+        
+        struct Transfer {
+            size_t index;
+            int attempt;
+            CURL* handle;
+            struct curl_slist* header_list;
+            std::string response_body;
+            std::vector<std::pair<std::string, std::string>> response_headers;
+        };
+        
+        struct Pending {
+            size_t index;
+            int attempt;
+            Clock::time_point not_before;
+        };
+        
+        ConnectionPool& pool = ConnectionPool::instance();
+        CURLM* multi = curl_multi_init();
+        if (!multi) {
+            for (size_t i = 0; i < requests.size(); ++i) {
+                HTTPResponse response;
+                response.status_code = 0;
+                response.success = false;
+                response.error_message = "CURL multi handle not initialized";
+                on_complete(i, response);
+            }
+            return;
+        }
+        
+        // Over HTTP/2 concurrent requests share one connection as separate streams
+        curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+        
+        max_in_flight = std::max<size_t>(1, max_in_flight);
+        std::vector<std::unique_ptr<Transfer>> in_flight;
+        std::deque<Pending> pending;
+        Clock::time_point started = Clock::now();
+        for (size_t i = 0; i < requests.size(); ++i) {
+            pending.push_back({i, 0, started});
+        }
+        // Earliest time a held-back request may become sendable
+        Clock::time_point next_wake = Clock::time_point::max();
+        
+        auto finish = [&](Transfer* transfer, CURLcode result) {
+            HTTPResponse response;
+            response.status_code = 0;
+            response.success = false;
+            if (result != CURLE_OK) {
+                response.error_message = "CURL error: " + std::string(curl_easy_strerror(result));
+                response.timed_out = (result == CURLE_OPERATION_TIMEDOUT);
+            } else {
+                long response_code = 0;
+                curl_easy_getinfo(transfer->handle, CURLINFO_RESPONSE_CODE, &response_code);
+                response.status_code = static_cast<int>(response_code);
+                response.body = std::move(transfer->response_body);
+                response.headers = std::move(transfer->response_headers);
+                response.success = (response_code >= 200 && response_code < 300);
+                if (!response.success) {
+                    response.error_message = "HTTP error " + std::to_string(response_code);
+                }
+            }
+            
+            pool.record(transfer->handle);
+            curl_multi_remove_handle(multi, transfer->handle);
+            pool.release(transfer->handle);
+            if (transfer->header_list) {
+                curl_slist_free_all(transfer->header_list);
+            }
+            
+            size_t index = transfer->index;
+            int attempt = transfer->attempt;
+            in_flight.erase(std::find_if(in_flight.begin(), in_flight.end(),
+                [transfer](const std::unique_ptr<Transfer>& t) { return t.get() == transfer; }));
+            
+            std::chrono::milliseconds retry_delay(-1);
+            if (!response.success && policy.retry_delay) {
+                retry_delay = policy.retry_delay(index, attempt, response);
+            }
+            if (retry_delay.count() >= 0) {
+                pending.push_back({index, attempt + 1, Clock::now() + retry_delay});
+            } else {
+                on_complete(index, response);
+            }
+        };
+        
+        // Top the pool up to the concurrency cap with requests that are due and admitted
+        auto launch = [&]() {
+            Clock::time_point now = Clock::now();
+            next_wake = Clock::time_point::max();
+            for (auto it = pending.begin(); it != pending.end() && in_flight.size() < max_in_flight;) {
+                if (it->not_before > now) {
+                    next_wake = std::min(next_wake, it->not_before);
+                    ++it;
+                    continue;
+                }
+                if (policy.admit) {
+                    std::chrono::milliseconds hold = policy.admit(it->index);
+                    if (hold.count() > 0) {
+                        next_wake = std::min(next_wake, now + hold);
+                        break;
+                    }
+                    if (hold.count() < 0) {
+                        HTTPResponse response;
+                        response.status_code = 0;
+                        response.success = false;
+                        response.dropped = true;
+                        response.error_message = "Request dropped before sending";
+                        size_t index = it->index;
+                        it = pending.erase(it);
+                        on_complete(index, response);
+                        continue;
+                    }
+                }
+                
+                Pending entry = *it;
+                it = pending.erase(it);
+                
+                const HTTPRequest& request = requests[entry.index];
+                auto transfer = std::make_unique<Transfer>();
+                transfer->index = entry.index;
+                transfer->attempt = entry.attempt;
+                transfer->handle = pool.acquire();
+                transfer->header_list = nullptr;
+                if (!transfer->handle) {
+                    HTTPResponse response;
+                    response.status_code = 0;
+                    response.success = false;
+                    response.error_message = "Failed to initialize CURL";
+                    on_complete(transfer->index, response);
+                    continue;
+                }
+                
+                transfer->header_list = configure(transfer->handle, request.url, &request.body, request.headers,
+                                                  &transfer->response_body, &transfer->response_headers);
+                if (request.timeout_ms > 0) {
+                    curl_easy_setopt(transfer->handle, CURLOPT_TIMEOUT_MS, static_cast<long>(request.timeout_ms));
+                }
+                // Wait for an HTTP/2 connection being set up rather than opening another
+                curl_easy_setopt(transfer->handle, CURLOPT_PIPEWAIT, 1L);
+                curl_easy_setopt(transfer->handle, CURLOPT_PRIVATE, transfer.get());
+                curl_multi_add_handle(multi, transfer->handle);
+                in_flight.push_back(std::move(transfer));
+            }
+        };
+        
+        // Never block longer than this so held-back requests are re-checked promptly
+        const std::chrono::milliseconds max_wait(100);
+        auto wait_budget = [&]() {
+            Clock::time_point now = Clock::now();
+            if (next_wake == Clock::time_point::max() || next_wake - now >= max_wait) {
+                return max_wait;
+            }
+            return std::max(std::chrono::milliseconds(0),
+                            std::chrono::ceil<std::chrono::milliseconds>(next_wake - now));
+        };
+        
+        launch();
+        while (!in_flight.empty() || !pending.empty()) {
+            if (in_flight.empty()) {
+                // Nothing on the wire: sleep until a backoff or rate limit expires
+                std::this_thread::sleep_for(wait_budget());
+                launch();
+                continue;
+            }
+            
+            int running = 0;
+            curl_multi_perform(multi, &running);
+            
+            int queued = 0;
+            while (CURLMsg* message = curl_multi_info_read(multi, &queued)) {
+                if (message->msg != CURLMSG_DONE) {
+                    continue;
+                }
+                Transfer* transfer = nullptr;
+                curl_easy_getinfo(message->easy_handle, CURLINFO_PRIVATE, &transfer);
+                finish(transfer, message->data.result);
+            }
+            
+            launch();
+            if (!in_flight.empty()) {
+                curl_multi_wait(multi, nullptr, 0, static_cast<int>(wait_budget().count()), nullptr);
+            }
+        }
+        
+        curl_multi_cleanup(multi);
+    }
+    
     void setTimeout(int seconds) {
         timeout_seconds = seconds;
     }
@@ -109,7 +464,57 @@ public:
     }
     
 private:
-    CURL* curl;
+    // Applies the options shared by every request; the caller frees the returned header list
+    struct curl_slist* configure(CURL* handle, const std::string& url, const std::string* body,
+                                 const std::vector<std::pair<std::string, std::string>>& headers,
+                                 std::string* response_body,
+                                 std::vector<std::pair<std::string, std::string>>* response_headers) {
+        // Set URL
+        curl_easy_setopt(handle, CURLOPT_URL, url.c_str());
+        
+        // POST the body when there is one, otherwise GET
+        if (body) {
+            curl_easy_setopt(handle, CURLOPT_POSTFIELDS, body->c_str());
+        } else {
+            curl_easy_setopt(handle, CURLOPT_HTTPGET, 1L);
+        }
+        
+        // Set headers
+        struct curl_slist* header_list = nullptr;
+        for (const auto& header : headers) {
+            std::string header_str = header.first + ": " + header.second;
+            header_list = curl_slist_append(header_list, header_str.c_str());
+        }
+        if (header_list) {
+            curl_easy_setopt(handle, CURLOPT_HTTPHEADER, header_list);
+        }
+        
+        // Set response callback
+        curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, WriteCallback);
+        curl_easy_setopt(handle, CURLOPT_WRITEDATA, response_body);
+        curl_easy_setopt(handle, CURLOPT_HEADERFUNCTION, HeaderCallback);
+        curl_easy_setopt(handle, CURLOPT_HEADERDATA, response_headers);
+        
+        // Set timeout
+        curl_easy_setopt(handle, CURLOPT_TIMEOUT, static_cast<long>(timeout_seconds));
+        
+        // Set user agent
+        curl_easy_setopt(handle, CURLOPT_USERAGENT, user_agent.c_str());
+        
+        // Disable SSL verification for development (should be enabled in production)
+        curl_easy_setopt(handle, CURLOPT_SSL_VERIFYPEER, 0L);
+        curl_easy_setopt(handle, CURLOPT_SSL_VERIFYHOST, 0L);
+        
+        // Worker threads must not be interrupted by curl's timeout signals
+        curl_easy_setopt(handle, CURLOPT_NOSIGNAL, 1L);
+        
+        // Negotiate HTTP/2 over TLS and keep idle pooled connections alive
+        curl_easy_setopt(handle, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+        curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L);
+        
+        return header_list;
+    }
+    
     int timeout_seconds;
     std::string user_agent = "UnityContextGenerator/1.0";
 };
@@ -121,8 +526,33 @@ HTTPClient::~HTTPClient() = default;
 
 HTTPClient::HTTPResponse HTTPClient::post(const std::string& url, 
                                          const std::string& body,
-                                         const std::vector<std::pair<std::string, std::string>>& headers) {
-    return m_impl->post(url, body, headers);
+                                         const std::vector<std::pair<std::string, std::string>>& headers,
+                                         int timeout_ms) {
+    return m_impl->perform(url, &body, headers, nullptr, timeout_ms);
+}
+
+HTTPClient::HTTPResponse HTTPClient::get(const std::string& url,
+                                        const std::vector<std::pair<std::string, std::string>>& headers) {
+    return m_impl->perform(url, nullptr, headers);
+}
+
+HTTPClient::HTTPResponse HTTPClient::postStream(const std::string& url,
+                                               const std::string& body,
+                                               const std::vector<std::pair<std::string, std::string>>& headers,
+                                               const DataCallback& on_data) {
+    return m_impl->perform(url, &body, headers, &on_data);
+}
+
+HTTPClient::HTTPResponse HTTPClient::getStream(const std::string& url,
+                                              const std::vector<std::pair<std::string, std::string>>& headers,
+                                              const DataCallback& on_data,
+                                              int timeout_ms) {
+    return m_impl->perform(url, nullptr, headers, &on_data, timeout_ms);
+}
+
+void HTTPClient::postMany(const std::vector<HTTPRequest>& requests, size_t max_in_flight,
+                          const CompletionCallback& on_complete, const DispatchPolicy& policy) {
+    m_impl->postMany(requests, max_in_flight, on_complete, policy);
 }
 
 void HTTPClient::setTimeout(int seconds) {
@@ -133,5 +563,9 @@ void HTTPClient::setUserAgent(const std::string& user_agent) {
     m_impl->setUserAgent(user_agent);
 }
 
+HTTPClient::ConnectionStats HTTPClient::connectionStats() {
+    return ConnectionPool::instance().stats();
+}
+
 } // namespace AI
 } // namespace UnityContextGen
\ No newline at end of file
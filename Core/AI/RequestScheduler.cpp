@@ -0,0 +1,131 @@
+#include "RequestScheduler.h"
+#include <algorithm>
+#include <cmath>
+
+namespace UnityContextGen {
+namespace AI {
+
+// How often an outranked event loop asks again
+static const std::chrono::milliseconds OUTRANKED_POLL_INTERVAL(20);
+
+RequestScheduler::RequestScheduler(const RateLimits& limits)
+    : m_limits(limits), m_next_sequence(0), m_random(std::random_device{}()) {
+    m_requests.capacity = std::max(0, limits.requests_per_minute);
+    m_requests.level = m_requests.capacity;
+    m_tokens.capacity = std::max(0, limits.tokens_per_minute);
+    m_tokens.level = m_tokens.capacity;
+    m_last_refill = Clock::now();
+    m_paused_until = m_last_refill;
+}
+
+void RequestScheduler::acquire(RequestPriority priority, int64_t tokens) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    Waiter self{priority, m_next_sequence++};
+    m_waiters.push_back(self);
+    std::push_heap(m_waiters.begin(), m_waiters.end(), lowerPriority);
+    m_waiters_changed.notify_all();
+
+    while (true) {
+        if (m_waiters.front().sequence != self.sequence) {
+            m_waiters_changed.wait(lock);
+            continue;
+        }
+
+        Clock::time_point now = Clock::now();
+        refill(now);
+        Clock::duration wait = waitTime(tokens, now);
+        if (wait <= Clock::duration::zero()) {
+            std::pop_heap(m_waiters.begin(), m_waiters.end(), lowerPriority);
+            m_waiters.pop_back();
+            charge(tokens);
+            m_waiters_changed.notify_all();
+            return;
+        }
+        m_waiters_changed.wait_for(lock, wait);
+    }
+}
+
+std::chrono::milliseconds RequestScheduler::tryAcquire(RequestPriority priority, int64_t tokens) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (outranked(priority)) {
+        return OUTRANKED_POLL_INTERVAL;
+    }
+
+    Clock::time_point now = Clock::now();
+    refill(now);
+    Clock::duration wait = waitTime(tokens, now);
+    if (wait <= Clock::duration::zero()) {
+        charge(tokens);
+        return std::chrono::milliseconds(0);
+    }
+    // Round up so a sub-millisecond wait is never mistaken for admission
+    return std::max(std::chrono::milliseconds(1), std::chrono::ceil<std::chrono::milliseconds>(wait));
+}
+
+void RequestScheduler::pauseUntil(Clock::time_point until) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_paused_until = std::max(m_paused_until, until);
+    m_waiters_changed.notify_all();
+}
+
+std::chrono::milliseconds RequestScheduler::backoffDelay(int attempt) {
+    double ceiling = static_cast<double>(std::max(0, m_limits.retry_base_delay_ms)) *
+                     std::pow(2.0, std::min(std::max(0, attempt), 30));
+    ceiling = std::min(ceiling, static_cast<double>(std::max(0, m_limits.retry_max_delay_ms)));
+
+    // Half fixed, half random, so concurrent retries spread out but never fire immediately
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::uniform_real_distribution<double> jitter(0.0, ceiling / 2.0);
+    return std::chrono::milliseconds(static_cast<int64_t>(ceiling / 2.0 + jitter(m_random)));
+}
+
+void RequestScheduler::refill(Clock::time_point now) {
+    double minutes = std::chrono::duration<double, std::ratio<60>>(now - m_last_refill).count();
+    m_last_refill = now;
+    for (Bucket* bucket : {&m_requests, &m_tokens}) {
+        bucket->level = std::min(bucket->capacity, bucket->level + bucket->capacity * minutes);
+    }
+}
+
+RequestScheduler::Clock::duration RequestScheduler::waitTime(int64_t tokens, Clock::time_point now) const {
+    Clock::duration wait = std::max(Clock::duration::zero(), m_paused_until - now);
+
+    auto deficit = [&wait](const Bucket& bucket, double cost) {
+        if (bucket.capacity <= 0.0) {
+            return;
+        }
+        // A request larger than the whole bucket waits for a full bucket instead of forever
+        cost = std::min(cost, bucket.capacity);
+        if (bucket.level < cost) {
+            std::chrono::duration<double, std::ratio<60>> refill_time((cost - bucket.level) / bucket.capacity);
+            wait = std::max(wait, std::chrono::ceil<Clock::duration>(refill_time));
+        }
+    };
+    deficit(m_requests, 1.0);
+    deficit(m_tokens, static_cast<double>(std::max<int64_t>(0, tokens)));
+    return wait;
+}
+
+void RequestScheduler::charge(int64_t tokens) {
+    if (m_requests.capacity > 0.0) {
+        m_requests.level -= 1.0;
+    }
+    if (m_tokens.capacity > 0.0) {
+        m_tokens.level -= std::min(static_cast<double>(std::max<int64_t>(0, tokens)), m_tokens.capacity);
+    }
+}
+
+bool RequestScheduler::outranked(RequestPriority priority) const {
+    // Waiters already queued at the same priority arrived first
+    return !m_waiters.empty() && m_waiters.front().priority <= priority;
+}
+
+bool RequestScheduler::lowerPriority(const Waiter& a, const Waiter& b) {
+    if (a.priority != b.priority) {
+        return a.priority > b.priority;
+    }
+    return a.sequence > b.sequence;
+}
+
+} // namespace AI
+} // namespace UnityContextGen
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <vector>
+
+namespace UnityContextGen {
+namespace AI {
+
+// Interactive single-file reviews are admitted ahead of bulk project reviews
+enum class RequestPriority {
+    Interactive = 0,
+    Bulk = 1
+};
+
+struct RateLimits {
+    int requests_per_minute = 0; // 0 = unlimited
+    int tokens_per_minute = 0;   // Estimated input tokens; 0 = unlimited
+    int retry_base_delay_ms = 1000;
+    int retry_max_delay_ms = 60000;
+};
+
+// Client-side admission control for API requests. Two token buckets (requests
+// and input tokens per minute) refill continuously; a request is admitted when
+// both can cover it and no waiter of higher or equal priority queued earlier.
+// A rate-limit response pauses admission for everyone until the server's
+// retry-after has passed. Thread-safe.
+class RequestScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit RequestScheduler(const RateLimits& limits = RateLimits());
+    ~RequestScheduler() = default;
+
+    // Blocks until the request may be sent
+    void acquire(RequestPriority priority, int64_t tokens);
+
+    // Non-blocking admission for event loops: zero when admitted (and charged),
+    // otherwise how long to wait before asking again
+    std::chrono::milliseconds tryAcquire(RequestPriority priority, int64_t tokens);
+
+    // Holds back all admissions until the given time
+    void pauseUntil(Clock::time_point until);
+
+    // Exponential backoff with equal jitter (half fixed, half random) for the given zero-based retry attempt
+    std::chrono::milliseconds backoffDelay(int attempt);
+
+    const RateLimits& getLimits() const { return m_limits; }
+
+private:
+    struct Bucket {
+        double capacity;
+        double level;
+    };
+
+    struct Waiter {
+        RequestPriority priority;
+        uint64_t sequence;
+    };
+
+    RateLimits m_limits;
+    Bucket m_requests;
+    Bucket m_tokens;
+    Clock::time_point m_last_refill;
+    Clock::time_point m_paused_until;
+
+    std::vector<Waiter> m_waiters; // Heap ordered by (priority, sequence)
+    uint64_t m_next_sequence;
+
+    std::mutex m_mutex;
+    std::condition_variable m_waiters_changed;
+    std::mt19937 m_random;
+
+    void refill(Clock::time_point now);
+    Clock::duration waitTime(int64_t tokens, Clock::time_point now) const;
+    void charge(int64_t tokens);
+    bool outranked(RequestPriority priority) const;
+
+    static bool lowerPriority(const Waiter& a, const Waiter& b);
+};
+
+} // namespace AI
+} // namespace UnityContextGen
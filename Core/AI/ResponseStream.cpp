@@ -0,0 +1,138 @@
+#include "ResponseStream.h"
+
+namespace UnityContextGen {
+namespace AI {
+
+static const std::string BULLET_PREFIXES[] = {"- ", "• "};
+
+SSEParser::SSEParser(EventCallback on_event)
+    : m_on_event(std::move(on_event)), m_has_data(false), m_event_count(0), m_last_was_cr(false) {
+}
+
+void SSEParser::feed(const char* data, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        char c = data[i];
+        // Lines end in CRLF, LF or CR; the LF of a CRLF split across chunks is skipped
+        if (c == '\n' && m_last_was_cr) {
+            m_last_was_cr = false;
+            continue;
+        }
+        m_last_was_cr = (c == '\r');
+        if (c == '\n' || c == '\r') {
+            processLine(m_line);
+            m_line.clear();
+        } else {
+            m_line += c;
+        }
+    }
+}
+
+void SSEParser::processLine(const std::string& line) {
+    if (line.empty()) {
+        if (m_has_data) {
+            if (m_current.event.empty()) {
+                m_current.event = "message";
+            }
+            ++m_event_count;
+            if (m_on_event) {
+                m_on_event(m_current);
+            }
+        }
+        m_current = SSEEvent();
+        m_has_data = false;
+        return;
+    }
+    if (line[0] == ':') {
+        return; // Comment / keep-alive
+    }
+
+    size_t colon = line.find(':');
+    std::string field = line.substr(0, colon);
+    std::string value;
+    if (colon != std::string::npos) {
+        value = line.substr(colon + 1);
+        if (!value.empty() && value[0] == ' ') {
+            value.erase(0, 1);
+        }
+    }
+
+    if (field == "event") {
+        m_current.event = value;
+    } else if (field == "data") {
+        if (m_has_data) {
+            m_current.data += '\n';
+        }
+        m_current.data += value;
+        m_has_data = true;
+    }
+}
+
+InsightParser::InsightParser(InsightCallback on_insight)
+    : m_on_insight(std::move(on_insight)), m_section(InsightSection::None) {
+}
+
+void InsightParser::feed(const std::string& text) {
+    size_t start = 0;
+    size_t newline;
+    while ((newline = text.find('\n', start)) != std::string::npos) {
+        m_line.append(text, start, newline - start);
+        processLine(m_line);
+        m_line.clear();
+        start = newline + 1;
+    }
+    m_line.append(text, start, std::string::npos);
+}
+
+void InsightParser::finish() {
+    if (!m_line.empty()) {
+        processLine(m_line);
+        m_line.clear();
+    }
+}
+
+const char* InsightParser::sectionName(InsightSection section) {
+    switch (section) {
+        case InsightSection::Issues: return "Key Issues";
+        case InsightSection::Performance: return "Performance";
+        case InsightSection::BestPractices: return "Best Practices";
+        case InsightSection::Suggestions: return "Suggestions";
+        default: return "";
+    }
+}
+
+void InsightParser::processLine(const std::string& raw_line) {
+    std::string line = raw_line;
+    if (!line.empty() && line.back() == '\r') {
+        line.pop_back();
+    }
+
+    if (line.find("**") != std::string::npos) {
+        // This is a section header
+        if (line.find("Key Issues") != std::string::npos || line.find("Issues") != std::string::npos) {
+            m_section = InsightSection::Issues;
+        } else if (line.find("Performance") != std::string::npos) {
+            m_section = InsightSection::Performance;
+        } else if (line.find("Best Practices") != std::string::npos || line.find("Improvements") != std::string::npos) {
+            m_section = InsightSection::BestPractices;
+        } else if (line.find("Suggestions") != std::string::npos) {
+            m_section = InsightSection::Suggestions;
+        }
+        return;
+    }
+
+    // This is a bullet point
+    for (const auto& bullet : BULLET_PREFIXES) {
+        if (line.compare(0, bullet.size(), bullet) == 0) {
+            if (m_section != InsightSection::None) {
+                m_insights.push_back({m_section, line.substr(bullet.size())});
+                if (m_on_insight) {
+                    m_on_insight(m_insights.back());
+                }
+            }
+            return;
+        }
+    }
+}
+
+} // namespace AI
+} // namespace UnityContextGen
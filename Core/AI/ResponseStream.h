@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace UnityContextGen {
+namespace AI {
+
+// Incremental parsers for streamed model responses. Both accept input in
+// arbitrary chunks, buffer only the unfinished line, and report each complete
+// unit as soon as its terminator arrives.
+
+struct SSEEvent {
+    std::string event; // "message" when the server names none
+    std::string data;  // Multiple data lines joined with '\n'
+};
+
+// text/event-stream framing: field lines, events dispatched on a blank line
+class SSEParser {
+public:
+    using EventCallback = std::function<void(const SSEEvent&)>;
+
+    explicit SSEParser(EventCallback on_event);
+    ~SSEParser() = default;
+
+    void feed(const char* data, size_t size);
+
+    size_t eventCount() const { return m_event_count; }
+
+private:
+    EventCallback m_on_event;
+    std::string m_line;
+    SSEEvent m_current;
+    bool m_has_data;
+    size_t m_event_count;
+    bool m_last_was_cr;
+
+    void processLine(const std::string& line);
+};
+
+enum class InsightSection {
+    None,
+    Issues,
+    Performance,
+    BestPractices,
+    Suggestions
+};
+
+struct Insight {
+    InsightSection section;
+    std::string text;
+};
+
+// Splits review text into bulleted items under the section headers the system
+// message asks for (**Key Issues**, **Performance Concerns**, ...)
+class InsightParser {
+public:
+    using InsightCallback = std::function<void(const Insight&)>;
+
+    explicit InsightParser(InsightCallback on_insight = nullptr);
+    ~InsightParser() = default;
+
+    void feed(const std::string& text);
+    void finish(); // Flushes a final line that has no trailing newline
+
+    const std::vector<Insight>& insights() const { return m_insights; }
+
+    static const char* sectionName(InsightSection section);
+
+private:
+    InsightCallback m_on_insight;
+    std::string m_line;
+    InsightSection m_section;
+    std::vector<Insight> m_insights;
+
+    void processLine(const std::string& line);
+};
+
+} // namespace AI
+} // namespace UnityContextGen
@@ -0,0 +1,170 @@
+#include "ReviewTriage.h"
+#include "UnityAnalyzer/MonoBehaviourAnalyzer.h"
+#include "UnityAnalyzer/ComponentDependencyAnalyzer.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+
+namespace UnityContextGen {
+namespace AI {
+
+using json = nlohmann::json;
+
+static const float PERFORMANCE_WEIGHT = 0.35f;
+static const float HOT_PATH_WEIGHT = 0.30f;
+static const float CENTRALITY_WEIGHT = 0.20f;
+static const float RECENCY_WEIGHT = 0.15f;
+static const double RECENCY_HALF_LIFE_HOURS = 24.0;
+
+// Callbacks Unity runs every frame or physics step
+static const Unity::LifecyclePhase PER_FRAME_PHASES[] = {
+    Unity::LifecyclePhase::FrameUpdate,
+    Unity::LifecyclePhase::PhysicsUpdate,
+    Unity::LifecyclePhase::LateFrameUpdate,
+    Unity::LifecyclePhase::AnimationUpdate
+};
+
+ReviewTriage::ReviewTriage() {
+}
+
+std::vector<TriageEntry> ReviewTriage::rank(const std::vector<AIAnalysisRequest>& requests,
+                                            const Unity::ComponentGraph* dependency_graph) const {
+    std::vector<TriageEntry> entries;
+    entries.reserve(requests.size());
+    size_t max_performance = 1;
+    size_t max_hot_path = 1;
+    size_t max_degree = 1;
+
+    auto degree = [](const std::map<std::string, std::vector<std::string>>& edges,
+                     const std::string& component) -> size_t {
+        auto it = edges.find(component);
+        return it == edges.end() ? 0 : it->second.size();
+    };
+
+    auto now = std::filesystem::file_time_type::clock::now();
+    for (size_t i = 0; i < requests.size(); ++i) {
+        const auto& request = requests[i];
+        TriageEntry entry;
+        entry.request_index = i;
+        entry.component_name = request.component_name;
+        entry.file_path = request.file_path;
+        if (request.api_usage) {
+            entry.performance_sensitive_apis = request.api_usage->performance_sensitive_apis.size();
+        }
+        entry.hot_path_apis = countHotPathAPIs(request);
+        if (dependency_graph) {
+            entry.dependency_degree = degree(dependency_graph->dependencies, request.component_name) +
+                                      degree(dependency_graph->dependents, request.component_name);
+        }
+
+        std::error_code ec;
+        auto modified = std::filesystem::last_write_time(request.file_path, ec);
+        if (!ec) {
+            entry.hours_since_change =
+                std::max(0.0, std::chrono::duration<double, std::ratio<3600>>(now - modified).count());
+        }
+
+        max_performance = std::max(max_performance, entry.performance_sensitive_apis);
+        max_hot_path = std::max(max_hot_path, entry.hot_path_apis);
+        max_degree = std::max(max_degree, entry.dependency_degree);
+        entries.push_back(std::move(entry));
+    }
+
+    // Each signal is scaled to the riskiest file in this run
+    for (auto& entry : entries) {
+        entry.risk_score =
+            PERFORMANCE_WEIGHT * static_cast<float>(entry.performance_sensitive_apis) / static_cast<float>(max_performance) +
+            HOT_PATH_WEIGHT * static_cast<float>(entry.hot_path_apis) / static_cast<float>(max_hot_path) +
+            CENTRALITY_WEIGHT * static_cast<float>(entry.dependency_degree) / static_cast<float>(max_degree);
+        if (entry.hours_since_change >= 0) {
+            entry.risk_score += RECENCY_WEIGHT *
+                static_cast<float>(RECENCY_HALF_LIFE_HOURS / (RECENCY_HALF_LIFE_HOURS + entry.hours_since_change));
+        }
+    }
+
+    std::stable_sort(entries.begin(), entries.end(), [](const TriageEntry& a, const TriageEntry& b) {
+        return a.risk_score > b.risk_score;
+    });
+    return entries;
+}
+
+json ReviewTriage::createReport(const std::vector<TriageEntry>& ranking,
+                                const std::vector<AIAnalysisResult>& results,
+                                const Config::AIAnalysisConfig& config) {
+    json report;
+    // Batch jobs review every file, so the live review budgets are only reported when they applied
+    report["mode"] = config.enable_batch_jobs ? "batch_job" : "live";
+    if (!config.enable_batch_jobs) {
+        report["token_budget"] = config.review_token_budget;
+        report["time_budget_seconds"] = config.review_time_budget_seconds;
+    }
+
+    size_t reviewed = 0;
+    size_t skipped = 0;
+    size_t failed = 0;
+    json files = json::array();
+    for (size_t rank = 0; rank < ranking.size(); ++rank) {
+        const TriageEntry& entry = ranking[rank];
+        json file;
+        file["rank"] = rank + 1;
+        file["component"] = entry.component_name;
+        file["file"] = entry.file_path;
+        file["risk_score"] = entry.risk_score;
+        file["signals"] = {
+            {"performance_sensitive_apis", entry.performance_sensitive_apis},
+            {"hot_path_apis", entry.hot_path_apis},
+            {"dependency_degree", entry.dependency_degree},
+            {"hours_since_change", entry.hours_since_change >= 0 ? json(entry.hours_since_change) : json(nullptr)}
+        };
+
+        if (entry.request_index < results.size()) {
+            const AIAnalysisResult& result = results[entry.request_index];
+            if (result.success) {
+                file["status"] = "reviewed";
+                ++reviewed;
+            } else {
+                file["status"] = result.skipped ? "skipped" : "failed";
+                file["reason"] = result.error_message;
+                ++(result.skipped ? skipped : failed);
+            }
+        }
+        files.push_back(std::move(file));
+    }
+
+    report["reviewed"] = reviewed;
+    report["skipped"] = skipped;
+    report["failed"] = failed;
+    report["files"] = std::move(files);
+    return report;
+}
+
+size_t ReviewTriage::countHotPathAPIs(const AIAnalysisRequest& request) {
+    if (!request.api_usage) {
+        return 0;
+    }
+
+    size_t count = 0;
+    for (const auto& api : request.api_usage->detected_apis) {
+        // Parser spans are exact; the detector's context is a best-effort guess
+        std::string method = api.context;
+        if (request.component) {
+            for (const auto& span : request.component->method_spans) {
+                size_t line = static_cast<size_t>(std::max(0, api.line_number));
+                if (line >= span.start_line && line <= span.end_line) {
+                    method = span.name;
+                    break;
+                }
+            }
+        }
+
+        const Unity::UnityCallbackInfo* callback = Unity::findUnityCallback(method);
+        if (callback && std::find(std::begin(PER_FRAME_PHASES), std::end(PER_FRAME_PHASES), callback->phase) !=
+                            std::end(PER_FRAME_PHASES)) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+} // namespace AI
+} // namespace UnityContextGen
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "ClaudeAnalyzer.h"
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+namespace UnityContextGen {
+
+namespace Unity {
+struct ComponentGraph;
+}
+
+namespace AI {
+
+// Static risk signals for one review request and the score derived from them
+struct TriageEntry {
+    size_t request_index;
+    std::string component_name;
+    std::string file_path;
+    size_t performance_sensitive_apis = 0;
+    size_t hot_path_apis = 0;       // Detected calls inside per-frame callbacks
+    size_t dependency_degree = 0;   // Dependencies plus dependents in the component graph
+    double hours_since_change = -1; // Negative when the file could not be stamped
+    float risk_score = 0.0f;
+};
+
+// Orders review requests so a limited token or time budget is spent on the
+// files most likely to hide real problems: heavy use of performance-sensitive
+// APIs, API calls on per-frame paths, central components, recent edits.
+class ReviewTriage {
+public:
+    ReviewTriage();
+    ~ReviewTriage() = default;
+
+    // Highest risk first; ties keep request order
+    std::vector<TriageEntry> rank(const std::vector<AIAnalysisRequest>& requests,
+                                  const Unity::ComponentGraph* dependency_graph) const;
+
+    // The ranking with what happened to each file; results are in request order.
+    // The review budgets are left out for batch jobs, which do not apply them
+    static nlohmann::json createReport(const std::vector<TriageEntry>& ranking,
+                                       const std::vector<AIAnalysisResult>& results,
+                                       const Config::AIAnalysisConfig& config);
+
+private:
+    static size_t countHotPathAPIs(const AIAnalysisRequest& request);
+};
+
+} // namespace AI
+} // namespace UnityContextGen
@@ -7,68 +7,9 @@
 namespace UnityContextGen {
 namespace AI {
 
-UnityAPIDetector::UnityAPIDetector() : m_verbose(false) {
-    initializeAPIDatabase();
-    initializeRegexPatterns();
-}
-
-UnityAPIUsage UnityAPIDetector::analyzeFile(const std::string& file_path) {
-    std::ifstream file(file_path);
-    if (!file.is_open()) {
-        logVerbose("Failed to open file: " + file_path);
-        return UnityAPIUsage{};
-    }
-
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    std::string code_content = buffer.str();
-    file.close();
-
-    return analyzeCode(code_content, file_path);
-}
-
-UnityAPIUsage UnityAPIDetector::analyzeCode(const std::string& code_content, const std::string& file_path) {
-    UnityAPIUsage usage;
-    usage.file_path = file_path;
-    
-    // Extract class name from code
-    std::regex class_regex(R"(class\s+(\w+)(?:\s*:\s*[\w,\s]+)?)");
-    std::smatch class_match;
-    if (std::regex_search(code_content, class_match, class_regex)) {
-        usage.class_name = class_match[1].str();
-    }
-    
-    // Detect Unity API calls
-    usage.detected_apis = detectUnityAPICalls(code_content);
-    
-    // Categorize APIs
-    categorizeAPIs(usage);
-    
-    logVerbose("Detected " + std::to_string(usage.detected_apis.size()) + " Unity API calls in " + file_path);
-    
-    return usage;
-}
-
-std::vector<UnityAPIUsage> UnityAPIDetector::analyzeProject(const std::vector<std::string>& file_paths) {
-    std::vector<UnityAPIUsage> results;
-    
-    for (const auto& file_path : file_paths) {
-        if (file_path.find(".cs") != std::string::npos) { // Only analyze C# files
-            auto usage = analyzeFile(file_path);
-            if (!usage.detected_apis.empty()) {
-                results.push_back(usage);
-            }
-        }
-    }
-    
-    return results;
-}
-
-std::vector<DetectedAPI> UnityAPIDetector::detectUnityAPICalls(const std::string& code_content) {
-    std::vector<DetectedAPI> detected_apis;
-    
-    // Common Unity API patterns
-    std::vector<std::pair<std::regex, std::string>> api_patterns = {
+// Common Unity API patterns, compiled once per process on first use
+static const std::vector<std::pair<std::regex, std::string>>& unityAPIPatterns() {
+    static const std::vector<std::pair<std::regex, std::string>> api_patterns = {
         // Component access
         {std::regex(R"(GetComponent<(\w+)>\(\))"), "GetComponent"},
         {std::regex(R"(GetComponents?<(\w+)>\(\))"), "GetComponent"},
@@ -128,10 +69,75 @@ std::vector<DetectedAPI> UnityAPIDetector::detectUnityAPICalls(const std::string
         {std::regex(R"(Debug\.Log\w*\s*\()"), "Debug.Log"},
         {std::regex(R"(Debug\.DrawRay\s*\()"), "Debug.DrawRay"},
     };
+    return api_patterns;
+}
+
+static const std::regex CLASS_DECLARATION_REGEX(R"(class\s+(\w+)(?:\s*:\s*[\w,\s]+)?)");
+static const std::regex METHOD_DECLARATION_REGEX(R"((public|private|protected)\s+[\w<>\[\]]+\s+(\w+)\s*\([^)]*\))");
+
+UnityAPIDetector::UnityAPIDetector() : m_verbose(false) {
+    initializeAPIDatabase();
+    initializeRegexPatterns();
+}
+
+UnityAPIUsage UnityAPIDetector::analyzeFile(const std::string& file_path) {
+    std::ifstream file(file_path);
+    if (!file.is_open()) {
+        logVerbose("Failed to open file: " + file_path);
+        return UnityAPIUsage{};
+    }
+
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    std::string code_content = buffer.str();
+    file.close();
+
+    return analyzeCode(code_content, file_path);
+}
+
+UnityAPIUsage UnityAPIDetector::analyzeCode(const std::string& code_content, const std::string& file_path) {
+    UnityAPIUsage usage;
+    usage.file_path = file_path;
+    
+    // Extract class name from code
+    std::smatch class_match;
+    if (std::regex_search(code_content, class_match, CLASS_DECLARATION_REGEX)) {
+        usage.class_name = class_match[1].str();
+    }
+    
+    // Detect Unity API calls
+    usage.detected_apis = detectUnityAPICalls(code_content);
+    
+    // Categorize APIs
+    categorizeAPIs(usage);
+    
+    logVerbose("Detected " + std::to_string(usage.detected_apis.size()) + " Unity API calls in " + file_path);
+    
+    return usage;
+}
+
+std::vector<UnityAPIUsage> UnityAPIDetector::analyzeProject(const std::vector<std::string>& file_paths) {
+    std::vector<UnityAPIUsage> results;
+    
+    for (const auto& file_path : file_paths) {
+        if (file_path.find(".cs") != std::string::npos) { // Only analyze C# files
+            auto usage = analyzeFile(file_path);
+            if (!usage.detected_apis.empty()) {
+                results.push_back(usage);
+            }
+        }
+    }
+    
+    return results;
+}
+
+std::vector<DetectedAPI> UnityAPIDetector::detectUnityAPICalls(const std::string& code_content) {
+    std::vector<DetectedAPI> detected_apis;
+    
     
     auto lines = splitIntoLines(code_content);
     
-    for (const auto& [pattern, api_name] : api_patterns) {
+    for (const auto& [pattern, api_name] : unityAPIPatterns()) {
         std::sregex_iterator iter(code_content.begin(), code_content.end(), pattern);
         std::sregex_iterator end;
         
@@ -145,7 +151,7 @@ std::vector<DetectedAPI> UnityAPIDetector::detectUnityAPICalls(const std::string
             detected.line_number = findLineNumber(code_content, position);
             
             // Find containing method
-            detected.context = findContainingMethod(code_content, detected.line_number);
+            detected.context = findContainingMethod(lines, detected.line_number);
             detected.usage_pattern = detected.context;
             
             detected_apis.push_back(detected);
@@ -232,15 +238,12 @@ int UnityAPIDetector::findLineNumber(const std::string& content, size_t position
     return static_cast<int>(std::count(content.begin(), content.begin() + position, '\n')) + 1;
 }
 
-std::string UnityAPIDetector::findContainingMethod(const std::string& code_content, int line_number) {
-    auto lines = splitIntoLines(code_content);
-    
+std::string UnityAPIDetector::findContainingMethod(const std::vector<std::string>& lines, int line_number) {
     // Search backwards from the line to find method declaration
     for (int i = line_number - 1; i >= 0; --i) {
         if (i < lines.size()) {
-            std::regex method_regex(R"((public|private|protected)\s+[\w<>\[\]]+\s+(\w+)\s*\([^)]*\))");
             std::smatch match;
-            if (std::regex_search(lines[i], match, method_regex)) {
+            if (std::regex_search(lines[i], match, METHOD_DECLARATION_REGEX)) {
                 return match[2].str(); // Return method name
             }
         }
@@ -256,7 +259,8 @@ void UnityAPIDetector::initializeAPIDatabase() {
 }
 
 void UnityAPIDetector::initializeRegexPatterns() {
-    // Regex patterns are initialized in detectUnityAPICalls
+    // Compile the shared pattern table up front rather than on the first scan
+    unityAPIPatterns();
 }
 
 std::unordered_map<std::string, int> UnityAPIDetector::getAPIFrequency(const std::vector<UnityAPIUsage>& usages) {
@@ -94,7 +94,7 @@ private:
     int findLineNumber(const std::string& content, size_t position);
     
     // Context analysis
-    std::string findContainingMethod(const std::string& code_content, int line_number);
+    std::string findContainingMethod(const std::vector<std::string>& lines, int line_number);
     bool isInUpdateLoop(const std::string& context);
     bool isInPerformanceCriticalSection(const std::string& context);
     
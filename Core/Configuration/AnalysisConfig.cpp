@@ -104,6 +104,10 @@ nlohmann::json ConfigurationManager::optionsToJson() const {
     j["analysis"]["analyze_asset_references"] = m_analysis_options.analyze_asset_references;
     j["analysis"]["analyze_addressables"] = m_analysis_options.analyze_addressables;
     j["analysis"]["analyze_dots_ecs"] = m_analysis_options.analyze_dots_ecs;
+    j["analysis"]["pattern_rules_file"] = m_analysis_options.pattern_rules_file;
+    j["analysis"]["data_flow_max_paths"] = m_analysis_options.data_flow_max_paths;
+    j["analysis"]["data_flow_max_path_length"] = m_analysis_options.data_flow_max_path_length;
+    j["analysis"]["data_flow_time_budget_ms"] = m_analysis_options.data_flow_time_budget_ms;
     
     // Output options
     j["output"]["directory"] = m_analysis_options.output_directory;
@@ -130,6 +134,23 @@ nlohmann::json ConfigurationManager::optionsToJson() const {
     j["ai"]["max_context_length"] = ai.max_context_length;
     j["ai"]["max_retries"] = ai.max_retries;
     j["ai"]["timeout_seconds"] = ai.timeout_seconds;
+    j["ai"]["enable_prompt_caching"] = ai.enable_prompt_caching;
+    j["ai"]["max_concurrent_requests"] = ai.max_concurrent_requests;
+    j["ai"]["requests_per_minute"] = ai.requests_per_minute;
+    j["ai"]["tokens_per_minute"] = ai.tokens_per_minute;
+    j["ai"]["retry_base_delay_ms"] = ai.retry_base_delay_ms;
+    j["ai"]["retry_max_delay_ms"] = ai.retry_max_delay_ms;
+    j["ai"]["enable_response_cache"] = ai.enable_response_cache;
+    j["ai"]["response_cache_max_mb"] = ai.response_cache_max_mb;
+    j["ai"]["response_cache_path"] = ai.response_cache_path;
+    j["ai"]["enable_streaming"] = ai.enable_streaming;
+    j["ai"]["review_token_budget"] = ai.review_token_budget;
+    j["ai"]["review_time_budget_seconds"] = ai.review_time_budget_seconds;
+    j["ai"]["enable_batch_jobs"] = ai.enable_batch_jobs;
+    j["ai"]["batch_poll_interval_ms"] = ai.batch_poll_interval_ms;
+    j["ai"]["batch_max_wait_seconds"] = ai.batch_max_wait_seconds;
+    j["ai"]["batch_transfer_timeout_seconds"] = ai.batch_transfer_timeout_seconds;
+    j["ai"]["batch_journal_path"] = ai.batch_journal_path;
     
     // Real-time Configuration
     const auto& rt = m_analysis_options.realtime_config;
@@ -162,6 +183,10 @@ void ConfigurationManager::jsonToOptions(const nlohmann::json& j) {
         m_analysis_options.analyze_asset_references = analysis.value("analyze_asset_references", true);
         m_analysis_options.analyze_addressables = analysis.value("analyze_addressables", false);
         m_analysis_options.analyze_dots_ecs = analysis.value("analyze_dots_ecs", false);
+        m_analysis_options.pattern_rules_file = analysis.value("pattern_rules_file", "");
+        m_analysis_options.data_flow_max_paths = analysis.value("data_flow_max_paths", 10);
+        m_analysis_options.data_flow_max_path_length = analysis.value("data_flow_max_path_length", 16);
+        m_analysis_options.data_flow_time_budget_ms = analysis.value("data_flow_time_budget_ms", 100);
     }
     
     // Output options
@@ -195,6 +220,23 @@ void ConfigurationManager::jsonToOptions(const nlohmann::json& j) {
         m_analysis_options.ai_config.max_context_length = ai.value("max_context_length", 200000);
         m_analysis_options.ai_config.max_retries = ai.value("max_retries", 3);
         m_analysis_options.ai_config.timeout_seconds = ai.value("timeout_seconds", 30);
+        m_analysis_options.ai_config.enable_prompt_caching = ai.value("enable_prompt_caching", true);
+        m_analysis_options.ai_config.max_concurrent_requests = ai.value("max_concurrent_requests", 4);
+        m_analysis_options.ai_config.requests_per_minute = ai.value("requests_per_minute", 50);
+        m_analysis_options.ai_config.tokens_per_minute = ai.value("tokens_per_minute", 0);
+        m_analysis_options.ai_config.retry_base_delay_ms = ai.value("retry_base_delay_ms", 1000);
+        m_analysis_options.ai_config.retry_max_delay_ms = ai.value("retry_max_delay_ms", 60000);
+        m_analysis_options.ai_config.enable_response_cache = ai.value("enable_response_cache", true);
+        m_analysis_options.ai_config.response_cache_max_mb = ai.value("response_cache_max_mb", 64);
+        m_analysis_options.ai_config.response_cache_path = ai.value("response_cache_path", "");
+        m_analysis_options.ai_config.enable_streaming = ai.value("enable_streaming", true);
+        m_analysis_options.ai_config.review_token_budget = ai.value("review_token_budget", 0);
+        m_analysis_options.ai_config.review_time_budget_seconds = ai.value("review_time_budget_seconds", 0);
+        m_analysis_options.ai_config.enable_batch_jobs = ai.value("enable_batch_jobs", false);
+        m_analysis_options.ai_config.batch_poll_interval_ms = ai.value("batch_poll_interval_ms", 60000);
+        m_analysis_options.ai_config.batch_max_wait_seconds = ai.value("batch_max_wait_seconds", 0);
+        m_analysis_options.ai_config.batch_transfer_timeout_seconds = ai.value("batch_transfer_timeout_seconds", 600);
+        m_analysis_options.ai_config.batch_journal_path = ai.value("batch_journal_path", "");
         
         // Don't load API key from file for security
     }
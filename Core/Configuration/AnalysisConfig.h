@@ -23,6 +23,23 @@ struct AIAnalysisConfig {
     int max_context_length = 200000; // Claude 3.5 Sonnet context limit
     int max_retries = 3;
     int timeout_seconds = 30;
+    bool enable_prompt_caching = true; // Mark the shared prompt prefix with cache_control
+    int max_concurrent_requests = 4; // Batched reviews in flight at once; timeout_seconds is each one's deadline
+    int requests_per_minute = 50; // Client-side rate limit; 0 = unlimited
+    int tokens_per_minute = 0; // Estimated input tokens per minute; 0 = unlimited
+    int retry_base_delay_ms = 1000; // First retry backoff, doubled per attempt with jitter
+    int retry_max_delay_ms = 60000;
+    bool enable_response_cache = true; // Reuse results for unchanged files across runs
+    int response_cache_max_mb = 64;
+    std::string response_cache_path; // Empty = ai_response_cache.json in the output directory
+    bool enable_streaming = true; // Single-file reviews stream insights as they are generated
+    int review_token_budget = 0; // Estimated input+output tokens per project review, riskiest files first; 0 = unlimited
+    int review_time_budget_seconds = 0; // Requests not yet sent by then are skipped; 0 = unlimited
+    bool enable_batch_jobs = false; // Submit project reviews as Message Batches jobs instead of live requests
+    int batch_poll_interval_ms = 60000;
+    int batch_max_wait_seconds = 0; // Stop polling after this; a later run resumes from the journal. 0 = until done
+    int batch_transfer_timeout_seconds = 600; // Deadline for uploading a job or downloading its results, in place of timeout_seconds
+    std::string batch_journal_path; // Empty = ai_batch_journal.json in the output directory
     
     bool is_valid() const {
         return !api_key.empty() && !model_name.empty() && !api_base_url.empty();
@@ -59,6 +76,10 @@ struct AnalysisOptions {
     bool analyze_asset_references = true;
     bool analyze_addressables = false;
     bool analyze_dots_ecs = false; // Future feature
+    std::string pattern_rules_file = ""; // Extra pattern rules (JSON) on top of the built-in ones
+    int data_flow_max_paths = 10; // Data-flow paths ranked for the context summary
+    int data_flow_max_path_length = 16;
+    int data_flow_time_budget_ms = 100; // Path search stops early and reports it once this passes
     
     // Output options
     std::string output_directory = "./unity_context_analysis";
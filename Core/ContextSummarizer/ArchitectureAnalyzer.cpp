@@ -2,20 +2,103 @@
 #include <algorithm>
 #include <numeric>
 #include <sstream>
+#include <unordered_set>
 
 namespace UnityContextGen {
 namespace Context {
 
+int ProjectStatistics::countAbove(const std::map<int, int>& distribution, int threshold) const {
+    int count = 0;
+    for (auto it = distribution.upper_bound(threshold); it != distribution.end(); ++it) {
+        count += it->second;
+    }
+    return count;
+}
+
 ArchitectureAnalyzer::ArchitectureAnalyzer() {
 }
 
+ProjectStatistics ArchitectureAnalyzer::computeProjectStatistics(const Metadata::ProjectMetadata& project_metadata) const {
+    ProjectStatistics statistics;
+    
+    for (const auto& comp_pair : project_metadata.components) {
+        const auto& comp = comp_pair.second;
+        
+        statistics.method_count_distribution[comp.metrics.method_count]++;
+        statistics.responsibility_block_distribution[static_cast<int>(comp.responsibility_blocks.block_order.size())]++;
+        statistics.complexity_distribution[comp.metrics.complexity_score]++;
+        
+        for (const auto& method : comp.lifecycle.methods) {
+            if (method == "Update") {
+                statistics.update_method_count++;
+            }
+        }
+        
+        std::string class_name = comp_pair.first;
+        std::transform(class_name.begin(), class_name.end(), class_name.begin(), ::tolower);
+        
+        if (class_name.find("manager") != std::string::npos) {
+            statistics.manager_count++;
+        }
+        if (class_name.find("controller") != std::string::npos) {
+            statistics.controller_count++;
+        }
+    }
+    
+    statistics.has_circular_dependencies = project_metadata.dependencies.has_circular_dependencies;
+    statistics.high_coupling_count = static_cast<int>(project_metadata.dependencies.high_coupling_components.size());
+    
+    for (const auto& pattern_pair : project_metadata.patterns.pattern_frequency) {
+        statistics.total_pattern_instances += pattern_pair.second;
+        
+        if (pattern_pair.first.find("MVC") != std::string::npos) {
+            statistics.has_mvc_pattern = true;
+        } else if (pattern_pair.first.find("ECS") != std::string::npos || 
+                   pattern_pair.first.find("Entity") != std::string::npos) {
+            statistics.has_ecs_pattern = true;
+        } else if (pattern_pair.first.find("Observer") != std::string::npos) {
+            statistics.has_observer_pattern = true;
+        } else if (pattern_pair.first.find("Service") != std::string::npos) {
+            statistics.has_service_pattern = true;
+        }
+    }
+    
+    for (const auto& system_group : project_metadata.systems.system_groups) {
+        SystemEdgeCounts& edges = statistics.system_edges[system_group.first];
+        std::unordered_set<std::string> members(system_group.second.begin(), system_group.second.end());
+        std::map<std::string, int> dependency_users;
+        
+        for (const auto& component : system_group.second) {
+            auto comp_it = project_metadata.components.find(component);
+            if (comp_it == project_metadata.components.end()) continue;
+            
+            for (const auto& dep : comp_it->second.dependencies) {
+                edges.total_edges++;
+                if (members.find(dep) == members.end()) {
+                    edges.external_edges++;
+                }
+                if (++dependency_users[dep] == 2) {
+                    edges.shared_dependencies++;
+                }
+            }
+        }
+    }
+    
+    return statistics;
+}
+
 ArchitectureInsight ArchitectureAnalyzer::analyzeArchitecture(const Metadata::ProjectMetadata& project_metadata) const {
+    return analyzeArchitecture(project_metadata, computeProjectStatistics(project_metadata));
+}
+
+ArchitectureInsight ArchitectureAnalyzer::analyzeArchitecture(const Metadata::ProjectMetadata& project_metadata,
+                                                              const ProjectStatistics& statistics) const {
     ArchitectureInsight insight;
     
-    insight.primary_type = detectPrimaryArchitecture(project_metadata);
-    insight.secondary_types = detectSecondaryArchitectures(project_metadata);
-    insight.confidence_score = calculateArchitectureConfidence(insight.primary_type, project_metadata);
-    insight.evidence = gatherArchitectureEvidence(insight.primary_type, project_metadata);
+    insight.primary_type = detectPrimaryArchitecture(project_metadata, statistics);
+    insight.secondary_types = detectSecondaryArchitectures(insight.primary_type, project_metadata, statistics);
+    insight.evidence = gatherArchitectureEvidence(insight.primary_type, project_metadata, statistics);
+    insight.confidence_score = calculateArchitectureConfidence(insight.evidence, insight.primary_type, project_metadata);
     insight.description = getArchitectureDescription(insight.primary_type);
     
     insight.characteristics.push_back("Unity MonoBehaviour-based structure");
@@ -45,6 +128,11 @@ ArchitectureInsight ArchitectureAnalyzer::analyzeArchitecture(const Metadata::Pr
 }
 
 std::vector<SystemCohesion> ArchitectureAnalyzer::analyzeSystemCohesion(const Metadata::ProjectMetadata& project_metadata) const {
+    return analyzeSystemCohesion(project_metadata, computeProjectStatistics(project_metadata));
+}
+
+std::vector<SystemCohesion> ArchitectureAnalyzer::analyzeSystemCohesion(const Metadata::ProjectMetadata& project_metadata,
+                                                                        const ProjectStatistics& statistics) const {
     std::vector<SystemCohesion> cohesion_analysis;
     
     for (const auto& system_group : project_metadata.systems.system_groups) {
@@ -52,8 +140,14 @@ std::vector<SystemCohesion> ArchitectureAnalyzer::analyzeSystemCohesion(const Me
         cohesion.system_name = system_group.first;
         cohesion.components = system_group.second;
         
-        cohesion.cohesion_score = calculateSystemCohesion(system_group.second, project_metadata);
-        cohesion.coupling_score = calculateSystemCoupling(system_group.second, project_metadata);
+        SystemEdgeCounts edges;
+        auto edges_it = statistics.system_edges.find(system_group.first);
+        if (edges_it != statistics.system_edges.end()) {
+            edges = edges_it->second;
+        }
+        
+        cohesion.cohesion_score = system_group.second.empty() ? 0.0f : calculateSystemCohesion(edges);
+        cohesion.coupling_score = calculateSystemCoupling(edges);
         
         std::string system_name_lower = system_group.first;
         std::transform(system_name_lower.begin(), system_name_lower.end(), system_name_lower.begin(), ::tolower);
@@ -88,12 +182,17 @@ std::vector<SystemCohesion> ArchitectureAnalyzer::analyzeSystemCohesion(const Me
 }
 
 ArchitectureHealth ArchitectureAnalyzer::assessArchitectureHealth(const Metadata::ProjectMetadata& project_metadata) const {
+    return assessArchitectureHealth(project_metadata, computeProjectStatistics(project_metadata));
+}
+
+ArchitectureHealth ArchitectureAnalyzer::assessArchitectureHealth(const Metadata::ProjectMetadata& project_metadata,
+                                                                  const ProjectStatistics& statistics) const {
     ArchitectureHealth health;
     
-    health.separation_of_concerns_score = assessSeparationOfConcerns(project_metadata);
-    health.dependency_inversion_score = assessDependencyInversion(project_metadata);
-    health.single_responsibility_score = assessSingleResponsibility(project_metadata);
-    health.open_closed_score = assessOpenClosed(project_metadata);
+    health.separation_of_concerns_score = assessSeparationOfConcerns(statistics);
+    health.dependency_inversion_score = assessDependencyInversion(statistics);
+    health.single_responsibility_score = assessSingleResponsibility(statistics);
+    health.open_closed_score = assessOpenClosed(statistics);
     
     health.overall_health_score = (health.separation_of_concerns_score +
                                   health.dependency_inversion_score +
@@ -106,63 +205,31 @@ ArchitectureHealth ArchitectureAnalyzer::assessArchitectureHealth(const Metadata
     return health;
 }
 
-ArchitectureType ArchitectureAnalyzer::detectPrimaryArchitecture(const Metadata::ProjectMetadata& project_metadata) const {
+ArchitectureType ArchitectureAnalyzer::detectPrimaryArchitecture(const Metadata::ProjectMetadata& project_metadata,
+                                                                 const ProjectStatistics& statistics) const {
     std::map<ArchitectureType, float> architecture_scores;
     
-    bool has_mvc_pattern = false;
-    bool has_ecs_pattern = false;
-    bool has_event_pattern = false;
-    bool has_service_pattern = false;
-    
-    for (const auto& pattern_pair : project_metadata.patterns.pattern_frequency) {
-        if (pattern_pair.first.find("MVC") != std::string::npos) {
-            has_mvc_pattern = true;
-        } else if (pattern_pair.first.find("ECS") != std::string::npos || 
-                   pattern_pair.first.find("Entity") != std::string::npos) {
-            has_ecs_pattern = true;
-        } else if (pattern_pair.first.find("Observer") != std::string::npos) {
-            has_event_pattern = true;
-        } else if (pattern_pair.first.find("Service") != std::string::npos) {
-            has_service_pattern = true;
-        }
-    }
-    
-    if (has_mvc_pattern) {
+    if (statistics.has_mvc_pattern) {
         architecture_scores[ArchitectureType::ModelViewController] = 0.8f;
     }
     
-    if (has_ecs_pattern) {
+    if (statistics.has_ecs_pattern) {
         architecture_scores[ArchitectureType::EntityComponentSystem] = 0.9f;
     }
     
-    if (has_event_pattern) {
+    if (statistics.has_observer_pattern) {
         architecture_scores[ArchitectureType::EventDrivenArchitecture] = 0.7f;
     }
     
-    if (has_service_pattern) {
+    if (statistics.has_service_pattern) {
         architecture_scores[ArchitectureType::ServiceOrientedArchitecture] = 0.6f;
     }
     
-    int manager_count = 0;
-    int controller_count = 0;
-    
-    for (const auto& comp_pair : project_metadata.components) {
-        std::string class_name = comp_pair.first;
-        std::transform(class_name.begin(), class_name.end(), class_name.begin(), ::tolower);
-        
-        if (class_name.find("manager") != std::string::npos) {
-            manager_count++;
-        }
-        if (class_name.find("controller") != std::string::npos) {
-            controller_count++;
-        }
-    }
-    
-    if (manager_count >= 3) {
+    if (statistics.manager_count >= 3) {
         architecture_scores[ArchitectureType::ServiceOrientedArchitecture] += 0.3f;
     }
     
-    if (controller_count >= 2) {
+    if (statistics.controller_count >= 2) {
         architecture_scores[ArchitectureType::ModelViewController] += 0.2f;
     }
     
@@ -185,24 +252,16 @@ ArchitectureType ArchitectureAnalyzer::detectPrimaryArchitecture(const Metadata:
     return primary_type;
 }
 
-std::vector<ArchitectureType> ArchitectureAnalyzer::detectSecondaryArchitectures(const Metadata::ProjectMetadata& project_metadata) const {
+std::vector<ArchitectureType> ArchitectureAnalyzer::detectSecondaryArchitectures(ArchitectureType primary,
+                                                                                 const Metadata::ProjectMetadata& project_metadata,
+                                                                                 const ProjectStatistics& statistics) const {
     std::vector<ArchitectureType> secondary_types;
     
-    ArchitectureType primary = detectPrimaryArchitecture(project_metadata);
-    
     if (primary != ArchitectureType::ComponentBasedEntity) {
         secondary_types.push_back(ArchitectureType::ComponentBasedEntity);
     }
     
-    bool has_event_driven = false;
-    for (const auto& pattern_pair : project_metadata.patterns.pattern_frequency) {
-        if (pattern_pair.first.find("Observer") != std::string::npos) {
-            has_event_driven = true;
-            break;
-        }
-    }
-    
-    if (has_event_driven && primary != ArchitectureType::EventDrivenArchitecture) {
+    if (statistics.has_observer_pattern && primary != ArchitectureType::EventDrivenArchitecture) {
         secondary_types.push_back(ArchitectureType::EventDrivenArchitecture);
     }
     
@@ -214,11 +273,11 @@ std::vector<ArchitectureType> ArchitectureAnalyzer::detectSecondaryArchitectures
     return secondary_types;
 }
 
-float ArchitectureAnalyzer::calculateArchitectureConfidence(ArchitectureType type,
+float ArchitectureAnalyzer::calculateArchitectureConfidence(const std::vector<std::string>& evidence,
+                                                           ArchitectureType type,
                                                            const Metadata::ProjectMetadata& project_metadata) const {
     float confidence = 0.5f;
     
-    auto evidence = gatherArchitectureEvidence(type, project_metadata);
     confidence += evidence.size() * 0.1f;
     
     if (type == ArchitectureType::ComponentBasedEntity) {
@@ -231,7 +290,8 @@ float ArchitectureAnalyzer::calculateArchitectureConfidence(ArchitectureType typ
 }
 
 std::vector<std::string> ArchitectureAnalyzer::gatherArchitectureEvidence(ArchitectureType type,
-                                                                         const Metadata::ProjectMetadata& project_metadata) const {
+                                                                         const Metadata::ProjectMetadata& project_metadata,
+                                                                         const ProjectStatistics& statistics) const {
     std::vector<std::string> evidence;
     
     switch (type) {
@@ -244,11 +304,8 @@ std::vector<std::string> ArchitectureAnalyzer::gatherArchitectureEvidence(Archit
             break;
             
         case ArchitectureType::ModelViewController:
-            for (const auto& pattern_pair : project_metadata.patterns.pattern_frequency) {
-                if (pattern_pair.first.find("MVC") != std::string::npos) {
-                    evidence.push_back("MVC pattern implementation found");
-                    break;
-                }
+            if (statistics.has_mvc_pattern) {
+                evidence.push_back("MVC pattern implementation found");
             }
             break;
             
@@ -262,20 +319,14 @@ std::vector<std::string> ArchitectureAnalyzer::gatherArchitectureEvidence(Archit
             break;
             
         case ArchitectureType::EventDrivenArchitecture:
-            for (const auto& pattern_pair : project_metadata.patterns.pattern_frequency) {
-                if (pattern_pair.first.find("Observer") != std::string::npos) {
-                    evidence.push_back("Observer pattern for event handling");
-                    break;
-                }
+            if (statistics.has_observer_pattern) {
+                evidence.push_back("Observer pattern for event handling");
             }
             break;
             
         case ArchitectureType::ServiceOrientedArchitecture:
-            for (const auto& pattern_pair : project_metadata.patterns.pattern_frequency) {
-                if (pattern_pair.first.find("Service") != std::string::npos) {
-                    evidence.push_back("Service locator pattern detected");
-                    break;
-                }
+            if (statistics.has_service_pattern) {
+                evidence.push_back("Service locator pattern detected");
             }
             break;
             
@@ -298,120 +349,57 @@ std::vector<std::string> ArchitectureAnalyzer::gatherArchitectureEvidence(Archit
     return evidence;
 }
 
-float ArchitectureAnalyzer::calculateSystemCohesion(const std::vector<std::string>& components,
-                                                   const Metadata::ProjectMetadata& project_metadata) const {
-    if (components.empty()) return 0.0f;
-    
+float ArchitectureAnalyzer::calculateSystemCohesion(const SystemEdgeCounts& edges) const {
     float cohesion_score = 0.8f;
     
-    std::map<std::string, int> shared_dependencies;
-    for (const auto& component : components) {
-        auto comp_it = project_metadata.components.find(component);
-        if (comp_it != project_metadata.components.end()) {
-            for (const auto& dep : comp_it->second.dependencies) {
-                shared_dependencies[dep]++;
-            }
-        }
-    }
-    
-    int total_shared = 0;
-    for (const auto& dep_pair : shared_dependencies) {
-        if (dep_pair.second > 1) {
-            total_shared++;
-        }
-    }
-    
-    if (total_shared > 0) {
+    if (edges.shared_dependencies > 0) {
         cohesion_score += 0.1f;
     }
     
     return std::min(1.0f, cohesion_score);
 }
 
-float ArchitectureAnalyzer::calculateSystemCoupling(const std::vector<std::string>& components,
-                                                   const Metadata::ProjectMetadata& project_metadata) const {
-    if (components.empty()) return 0.0f;
-    
-    int external_dependencies = 0;
-    int total_dependencies = 0;
-    
-    for (const auto& component : components) {
-        auto comp_it = project_metadata.components.find(component);
-        if (comp_it != project_metadata.components.end()) {
-            for (const auto& dep : comp_it->second.dependencies) {
-                total_dependencies++;
-                
-                if (std::find(components.begin(), components.end(), dep) == components.end()) {
-                    external_dependencies++;
-                }
-            }
-        }
-    }
+float ArchitectureAnalyzer::calculateSystemCoupling(const SystemEdgeCounts& edges) const {
+    if (edges.total_edges == 0) return 0.0f;
     
-    if (total_dependencies == 0) return 0.0f;
-    
-    return static_cast<float>(external_dependencies) / total_dependencies;
+    return static_cast<float>(edges.external_edges) / edges.total_edges;
 }
 
-float ArchitectureAnalyzer::assessSeparationOfConcerns(const Metadata::ProjectMetadata& project_metadata) const {
+float ArchitectureAnalyzer::assessSeparationOfConcerns(const ProjectStatistics& statistics) const {
     float score = 100.0f;
     
-    for (const auto& comp_pair : project_metadata.components) {
-        const auto& comp = comp_pair.second;
-        
-        if (comp.responsibility_blocks.block_order.size() > 5) {
-            score -= 5.0f;
-        }
-        
-        if (comp.metrics.complexity_score > 50) {
-            score -= 10.0f;
-        }
-    }
+    score -= statistics.countAbove(statistics.responsibility_block_distribution, 5) * 5.0f;
+    score -= statistics.countAbove(statistics.complexity_distribution, 50) * 10.0f;
     
     return std::max(0.0f, std::min(100.0f, score));
 }
 
-float ArchitectureAnalyzer::assessDependencyInversion(const Metadata::ProjectMetadata& project_metadata) const {
+float ArchitectureAnalyzer::assessDependencyInversion(const ProjectStatistics& statistics) const {
     float score = 80.0f;
     
-    if (project_metadata.dependencies.has_circular_dependencies) {
+    if (statistics.has_circular_dependencies) {
         score -= 30.0f;
     }
     
-    int high_coupling_count = project_metadata.dependencies.high_coupling_components.size();
-    score -= high_coupling_count * 5.0f;
+    score -= statistics.high_coupling_count * 5.0f;
     
     return std::max(0.0f, std::min(100.0f, score));
 }
 
-float ArchitectureAnalyzer::assessSingleResponsibility(const Metadata::ProjectMetadata& project_metadata) const {
+float ArchitectureAnalyzer::assessSingleResponsibility(const ProjectStatistics& statistics) const {
     float score = 100.0f;
     
-    for (const auto& comp_pair : project_metadata.components) {
-        const auto& comp = comp_pair.second;
-        
-        if (comp.metrics.method_count > 15) {
-            score -= 5.0f;
-        }
-        
-        if (comp.responsibility_blocks.block_order.size() > 4) {
-            score -= 3.0f;
-        }
-    }
+    score -= statistics.countAbove(statistics.method_count_distribution, 15) * 5.0f;
+    score -= statistics.countAbove(statistics.responsibility_block_distribution, 4) * 3.0f;
     
     return std::max(0.0f, std::min(100.0f, score));
 }
 
-float ArchitectureAnalyzer::assessOpenClosed(const Metadata::ProjectMetadata& project_metadata) const {
+float ArchitectureAnalyzer::assessOpenClosed(const ProjectStatistics& statistics) const {
     float score = 70.0f;
     
-    int pattern_count = 0;
-    for (const auto& pattern_pair : project_metadata.patterns.pattern_frequency) {
-        pattern_count += pattern_pair.second;
-    }
-    
-    if (pattern_count > 0) {
-        score += pattern_count * 5.0f;
+    if (statistics.total_pattern_instances > 0) {
+        score += statistics.total_pattern_instances * 5.0f;
     }
     
     return std::max(0.0f, std::min(100.0f, score));
@@ -472,8 +460,9 @@ std::vector<std::string> ArchitectureAnalyzer::identifyArchitecturalStrengths(co
 std::string ArchitectureAnalyzer::generateArchitectureSummary(const Metadata::ProjectMetadata& project_metadata) const {
     std::stringstream summary;
     
-    auto insight = analyzeArchitecture(project_metadata);
-    auto health = assessArchitectureHealth(project_metadata);
+    auto statistics = computeProjectStatistics(project_metadata);
+    auto insight = analyzeArchitecture(project_metadata, statistics);
+    auto health = assessArchitectureHealth(project_metadata, statistics);
     
     summary << "Architecture Analysis Summary\n";
     summary << "============================\n\n";
@@ -38,6 +38,37 @@ struct SystemCohesion {
     bool is_well_designed;
 };
 
+struct SystemEdgeCounts {
+    int total_edges = 0;
+    int external_edges = 0;
+    int shared_dependencies = 0;
+};
+
+// Project-wide aggregates gathered in a single walk over the components
+struct ProjectStatistics {
+    int total_pattern_instances = 0;
+    int update_method_count = 0;
+    int manager_count = 0;
+    int controller_count = 0;
+    
+    bool has_mvc_pattern = false;
+    bool has_ecs_pattern = false;
+    bool has_observer_pattern = false;
+    bool has_service_pattern = false;
+    
+    bool has_circular_dependencies = false;
+    int high_coupling_count = 0;
+    
+    // value -> number of components with that value
+    std::map<int, int> method_count_distribution;
+    std::map<int, int> responsibility_block_distribution;
+    std::map<int, int> complexity_distribution;
+    
+    std::map<std::string, SystemEdgeCounts> system_edges;
+    
+    int countAbove(const std::map<int, int>& distribution, int threshold) const;
+};
+
 struct ArchitectureHealth {
     float separation_of_concerns_score;
     float dependency_inversion_score;
@@ -53,9 +84,17 @@ public:
     ArchitectureAnalyzer();
     ~ArchitectureAnalyzer() = default;
 
+    ProjectStatistics computeProjectStatistics(const Metadata::ProjectMetadata& project_metadata) const;
+    
     ArchitectureInsight analyzeArchitecture(const Metadata::ProjectMetadata& project_metadata) const;
+    ArchitectureInsight analyzeArchitecture(const Metadata::ProjectMetadata& project_metadata,
+                                            const ProjectStatistics& statistics) const;
     std::vector<SystemCohesion> analyzeSystemCohesion(const Metadata::ProjectMetadata& project_metadata) const;
+    std::vector<SystemCohesion> analyzeSystemCohesion(const Metadata::ProjectMetadata& project_metadata,
+                                                      const ProjectStatistics& statistics) const;
     ArchitectureHealth assessArchitectureHealth(const Metadata::ProjectMetadata& project_metadata) const;
+    ArchitectureHealth assessArchitectureHealth(const Metadata::ProjectMetadata& project_metadata,
+                                                const ProjectStatistics& statistics) const;
     
     std::string generateArchitectureSummary(const Metadata::ProjectMetadata& project_metadata) const;
     std::string generateImprovementPlan(const Metadata::ProjectMetadata& project_metadata) const;
@@ -64,25 +103,27 @@ public:
     std::vector<std::string> detectAntiPatterns(const Metadata::ProjectMetadata& project_metadata) const;
 
 private:
-    ArchitectureType detectPrimaryArchitecture(const Metadata::ProjectMetadata& project_metadata) const;
-    std::vector<ArchitectureType> detectSecondaryArchitectures(const Metadata::ProjectMetadata& project_metadata) const;
+    ArchitectureType detectPrimaryArchitecture(const Metadata::ProjectMetadata& project_metadata,
+                                               const ProjectStatistics& statistics) const;
+    std::vector<ArchitectureType> detectSecondaryArchitectures(ArchitectureType primary,
+                                                               const Metadata::ProjectMetadata& project_metadata,
+                                                               const ProjectStatistics& statistics) const;
     
-    float calculateArchitectureConfidence(ArchitectureType type, 
+    float calculateArchitectureConfidence(const std::vector<std::string>& evidence,
+                                         ArchitectureType type,
                                          const Metadata::ProjectMetadata& project_metadata) const;
     
     std::vector<std::string> gatherArchitectureEvidence(ArchitectureType type,
-                                                        const Metadata::ProjectMetadata& project_metadata) const;
-    
-    float calculateSystemCohesion(const std::vector<std::string>& components,
-                                 const Metadata::ProjectMetadata& project_metadata) const;
+                                                        const Metadata::ProjectMetadata& project_metadata,
+                                                        const ProjectStatistics& statistics) const;
     
-    float calculateSystemCoupling(const std::vector<std::string>& components,
-                                 const Metadata::ProjectMetadata& project_metadata) const;
+    float calculateSystemCohesion(const SystemEdgeCounts& edges) const;
+    float calculateSystemCoupling(const SystemEdgeCounts& edges) const;
     
-    float assessSeparationOfConcerns(const Metadata::ProjectMetadata& project_metadata) const;
-    float assessDependencyInversion(const Metadata::ProjectMetadata& project_metadata) const;
-    float assessSingleResponsibility(const Metadata::ProjectMetadata& project_metadata) const;
-    float assessOpenClosed(const Metadata::ProjectMetadata& project_metadata) const;
+    float assessSeparationOfConcerns(const ProjectStatistics& statistics) const;
+    float assessDependencyInversion(const ProjectStatistics& statistics) const;
+    float assessSingleResponsibility(const ProjectStatistics& statistics) const;
+    float assessOpenClosed(const ProjectStatistics& statistics) const;
     
     std::vector<std::string> identifySOLIDViolations(const Metadata::ProjectMetadata& project_metadata) const;
     std::vector<std::string> identifyArchitecturalStrengths(const Metadata::ProjectMetadata& project_metadata) const;
@@ -0,0 +1,311 @@
+#include "ComponentIndex.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace UnityContextGen {
+namespace Context {
+
+static const int INDEX_FORMAT_VERSION = 1;
+static const int MAX_FOCUS_HOPS = 8;
+static const uint32_t NOT_VISITED = UINT32_MAX;
+
+ComponentIndex::ComponentIndex() {
+}
+
+void ComponentIndex::build(const Metadata::ProjectMetadata& metadata, const std::vector<std::string>& source_files) {
+    *this = ComponentIndex();
+
+    for (const auto& comp_pair : metadata.components) {
+        const auto& component = comp_pair.second;
+        uint32_t id = static_cast<uint32_t>(m_names.size());
+        if (!m_by_name.emplace(component.class_name, id).second) {
+            continue;
+        }
+        m_names.push_back(component.class_name);
+        m_files.push_back(component.file_path);
+        m_cards.push_back(renderCard(component));
+    }
+
+    // Dependencies on types outside the project (engine classes etc.) are not nodes
+    std::vector<std::vector<uint32_t>> outgoing(m_names.size());
+    for (const auto& comp_pair : metadata.components) {
+        const auto& component = comp_pair.second;
+        uint32_t id = m_by_name[component.class_name];
+        for (const auto& dependency : component.dependencies) {
+            auto it = m_by_name.find(dependency);
+            if (it != m_by_name.end() && it->second != id) {
+                outgoing[id].push_back(it->second);
+            }
+        }
+        for (const auto& dependent : component.dependents) {
+            auto it = m_by_name.find(dependent);
+            if (it != m_by_name.end() && it->second != id) {
+                outgoing[it->second].push_back(id);
+            }
+        }
+    }
+
+    m_sources = stampSourceFiles(source_files);
+
+    finalize(outgoing);
+}
+
+void ComponentIndex::writeJSON(Metadata::JSONStreamWriter& writer) const {
+    writer.beginObject();
+    writer.field("format_version", INDEX_FORMAT_VERSION);
+
+    writer.key("sources");
+    writeSourceStampsJSON(m_sources, writer);
+
+    writer.key("components");
+    writer.beginArray();
+    for (size_t id = 0; id < m_names.size(); ++id) {
+        writer.beginObject();
+        writer.field("name", m_names[id]);
+        writer.field("file", m_files[id]);
+        writer.field("card", m_cards[id]);
+        writer.key("depends_on");
+        writer.beginArray();
+        for (uint32_t e = m_edge_offsets[id]; e < m_edge_offsets[id + 1]; ++e) {
+            if (m_edge_outgoing[e]) {
+                writer.value(static_cast<size_t>(m_edge_targets[e]));
+            }
+        }
+        writer.endArray();
+        writer.endObject();
+    }
+    writer.endArray();
+
+    writer.endObject();
+}
+
+bool ComponentIndex::load(const std::string& index_path) {
+    try {
+        std::ifstream file(index_path);
+        if (!file.is_open()) {
+            return false;
+        }
+
+        nlohmann::json j = nlohmann::json::parse(file);
+        if (j.value("format_version", 0) != INDEX_FORMAT_VERSION) {
+            return false;
+        }
+
+        ComponentIndex loaded;
+        loaded.m_sources = readSourceStamps(j.at("sources"));
+
+        const auto& components = j.at("components");
+        std::vector<std::vector<uint32_t>> outgoing(components.size());
+        for (const auto& component : components) {
+            uint32_t id = static_cast<uint32_t>(loaded.m_names.size());
+            loaded.m_names.push_back(component.at("name").get<std::string>());
+            loaded.m_files.push_back(component.value("file", ""));
+            loaded.m_cards.push_back(component.value("card", ""));
+            loaded.m_by_name.emplace(loaded.m_names.back(), id);
+
+            for (const auto& target : component.at("depends_on")) {
+                uint32_t target_id = target.get<uint32_t>();
+                if (target_id >= components.size()) {
+                    std::cerr << "Component index references unknown component: " << index_path << std::endl;
+                    return false;
+                }
+                outgoing[id].push_back(target_id);
+            }
+        }
+
+        loaded.finalize(outgoing);
+        *this = std::move(loaded);
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Error reading component index: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool ComponentIndex::isFresh(const std::vector<std::string>& source_files) const {
+    return sourcesUnchanged(m_sources, source_files);
+}
+
+FocusedContext ComponentIndex::query(const std::string& target, int hops) const {
+    FocusedContext context;
+    uint32_t focus = 0;
+    if (!resolve(target, focus)) {
+        return context;
+    }
+
+    hops = std::max(0, std::min(hops, MAX_FOCUS_HOPS));
+    context.found = true;
+    context.focus = m_names[focus];
+
+    // Bounded BFS over both edge directions
+    std::unordered_map<uint32_t, uint32_t> distance;
+    std::vector<uint32_t> frontier{focus};
+    distance[focus] = 0;
+    for (int depth = 1; depth <= hops && !frontier.empty(); ++depth) {
+        std::vector<uint32_t> next;
+        for (uint32_t node : frontier) {
+            for (uint32_t e = m_edge_offsets[node]; e < m_edge_offsets[node + 1]; ++e) {
+                uint32_t neighbour = m_edge_targets[e];
+                if (distance.emplace(neighbour, static_cast<uint32_t>(depth)).second) {
+                    next.push_back(neighbour);
+                }
+            }
+        }
+        frontier = std::move(next);
+    }
+
+    std::vector<std::pair<uint32_t, uint32_t>> ordered; // (distance, id)
+    for (const auto& visit : distance) {
+        if (visit.first != focus) {
+            ordered.emplace_back(visit.second, visit.first);
+        }
+    }
+    std::sort(ordered.begin(), ordered.end(), [this](const auto& a, const auto& b) {
+        return a.first != b.first ? a.first < b.first : m_names[a.second] < m_names[b.second];
+    });
+
+    // Direct relationships of the focus, for labelling one-hop neighbours
+    std::unordered_map<uint32_t, std::string> relation;
+    for (uint32_t e = m_edge_offsets[focus]; e < m_edge_offsets[focus + 1]; ++e) {
+        std::string& label = relation[m_edge_targets[e]];
+        const char* kind = m_edge_outgoing[e] ? "dependency" : "dependent";
+        label = label.empty() ? kind : "dependency and dependent";
+    }
+
+    std::stringstream prompt;
+    prompt << "# Focused Context: " << context.focus << "\n\n";
+    prompt << "**Scope:** " << ordered.size() << " neighbouring component(s) within "
+           << hops << " hop(s) of " << m_names.size() << " indexed\n\n";
+    prompt << "## " << context.focus << "\n" << m_cards[focus] << "\n";
+
+    if (!ordered.empty()) {
+        prompt << "## Neighbours\n";
+    }
+    for (const auto& entry : ordered) {
+        context.neighbours.push_back({m_names[entry.second], static_cast<int>(entry.first)});
+
+        prompt << "### " << m_names[entry.second] << " (";
+        auto relation_it = relation.find(entry.second);
+        if (relation_it != relation.end()) {
+            prompt << relation_it->second;
+        } else {
+            prompt << entry.first << " hops away";
+        }
+        prompt << ")\n" << m_cards[entry.second] << "\n";
+    }
+
+    context.prompt = prompt.str();
+    return context;
+}
+
+void ComponentIndex::finalize(const std::vector<std::vector<uint32_t>>& outgoing) {
+    // Each node lists its dependencies then its dependents, sorted and deduplicated
+    std::vector<std::vector<std::pair<uint32_t, uint8_t>>> adjacency(m_names.size());
+    for (uint32_t source = 0; source < outgoing.size(); ++source) {
+        for (uint32_t target : outgoing[source]) {
+            adjacency[source].emplace_back(target, 1);
+            adjacency[target].emplace_back(source, 0);
+        }
+    }
+
+    m_edge_offsets.assign(1, 0);
+    m_edge_targets.clear();
+    m_edge_outgoing.clear();
+    for (auto& edges : adjacency) {
+        std::sort(edges.begin(), edges.end());
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+        for (const auto& edge : edges) {
+            m_edge_targets.push_back(edge.first);
+            m_edge_outgoing.push_back(edge.second);
+        }
+        m_edge_offsets.push_back(static_cast<uint32_t>(m_edge_targets.size()));
+    }
+
+    // Script paths resolve by full path, and by file name when that is unambiguous
+    m_by_file.clear();
+    std::unordered_map<std::string, int> file_name_counts;
+    for (const auto& file : m_files) {
+        ++file_name_counts[std::filesystem::path(file).filename().string()];
+    }
+    for (uint32_t id = 0; id < m_files.size(); ++id) {
+        if (m_files[id].empty()) {
+            continue;
+        }
+        m_by_file.emplace(normalizeSourcePath(m_files[id]), id);
+        std::string file_name = std::filesystem::path(m_files[id]).filename().string();
+        if (file_name_counts[file_name] == 1) {
+            m_by_file.emplace(file_name, id);
+        }
+    }
+}
+
+bool ComponentIndex::resolve(const std::string& target, uint32_t& id) const {
+    auto name_it = m_by_name.find(target);
+    if (name_it != m_by_name.end()) {
+        id = name_it->second;
+        return true;
+    }
+
+    auto file_it = m_by_file.find(normalizeSourcePath(target));
+    if (file_it == m_by_file.end()) {
+        file_it = m_by_file.find(std::filesystem::path(target).filename().string());
+    }
+    if (file_it != m_by_file.end()) {
+        id = file_it->second;
+        return true;
+    }
+
+    auto lower = [](std::string text) {
+        std::transform(text.begin(), text.end(), text.begin(), ::tolower);
+        return text;
+    };
+    std::string wanted = lower(target);
+    for (uint32_t i = 0; i < m_names.size(); ++i) {
+        if (lower(m_names[i]) == wanted) {
+            id = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string ComponentIndex::renderCard(const Metadata::ComponentMetadata& component) {
+    auto join = [](const std::vector<std::string>& items, const char* separator) {
+        std::string joined;
+        for (size_t i = 0; i < items.size(); ++i) {
+            if (i > 0) joined += separator;
+            joined += items[i];
+        }
+        return joined;
+    };
+
+    std::stringstream card;
+    card << "**File:** " << component.file_path << " (lines " << component.start_line
+         << "-" << component.end_line << ")\n";
+    card << "**Purpose:** " << component.purpose << "\n";
+    if (!component.dependencies.empty()) {
+        card << "**Depends on:** " << join(component.dependencies, ", ") << "\n";
+    }
+    if (!component.dependents.empty()) {
+        card << "**Used by:** " << join(component.dependents, ", ") << "\n";
+    }
+    if (!component.lifecycle.execution_order.empty()) {
+        card << "**Lifecycle:** " << join(component.lifecycle.execution_order, " → ") << "\n";
+    }
+    if (!component.responsibility_blocks.block_order.empty()) {
+        card << "**Responsibilities:** " << join(component.responsibility_blocks.block_order, ", ") << "\n";
+    }
+    if (!component.design_patterns.empty()) {
+        card << "**Patterns:** " << join(component.design_patterns, ", ") << "\n";
+    }
+    card << "**Complexity:** " << component.metrics.complexity_score << "\n";
+    return card.str();
+}
+
+} // namespace Context
+} // namespace UnityContextGen
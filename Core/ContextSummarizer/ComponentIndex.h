@@ -0,0 +1,66 @@
+#pragma once
+
+#include "../MetadataGenerator/ProjectMetadata.h"
+#include "../MetadataGenerator/JSONStreamWriter.h"
+#include "SourceStamp.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace UnityContextGen {
+namespace Context {
+
+struct FocusedNeighbour {
+    std::string component;
+    int distance;
+};
+
+struct FocusedContext {
+    bool found = false;
+    std::string focus;
+    std::vector<FocusedNeighbour> neighbours; // Ordered by distance, then name
+    std::string prompt;
+};
+
+// Prebuilt dependency-graph index answering "component and its k-hop
+// neighbourhood" queries without reanalysis. Names are interned to ids,
+// adjacency is stored in CSR form, and each component's prompt card is
+// rendered once at build time, so a query is a bounded BFS plus concatenation.
+class ComponentIndex {
+public:
+    ComponentIndex();
+    ~ComponentIndex() = default;
+
+    void build(const Metadata::ProjectMetadata& metadata, const std::vector<std::string>& source_files);
+
+    void writeJSON(Metadata::JSONStreamWriter& writer) const;
+    bool load(const std::string& index_path);
+
+    // True when the index was built from exactly these files, unmodified since
+    bool isFresh(const std::vector<std::string>& source_files) const;
+
+    // Accepts a component name or a script path; hops is clamped to [0, 8]
+    FocusedContext query(const std::string& target, int hops) const;
+
+    size_t size() const { return m_names.size(); }
+
+private:
+    std::vector<std::string> m_names;
+    std::vector<std::string> m_files;
+    std::vector<std::string> m_cards;
+    std::vector<uint32_t> m_edge_offsets;     // CSR: edges of node i are [offsets[i], offsets[i+1])
+    std::vector<uint32_t> m_edge_targets;
+    std::vector<uint8_t> m_edge_outgoing;      // 1 = depends on target, 0 = used by target
+    std::unordered_map<std::string, uint32_t> m_by_name;
+    std::unordered_map<std::string, uint32_t> m_by_file;
+    std::vector<SourceStamp> m_sources;
+
+    void finalize(const std::vector<std::vector<uint32_t>>& outgoing);
+    bool resolve(const std::string& target, uint32_t& id) const;
+
+    static std::string renderCard(const Metadata::ComponentMetadata& component);
+};
+
+} // namespace Context
+} // namespace UnityContextGen
@@ -0,0 +1,178 @@
+#include "ContextPacker.h"
+#include <algorithm>
+
+namespace UnityContextGen {
+namespace Context {
+
+static const size_t CHARS_PER_WORD_TOKEN = 5;
+static const size_t OMISSION_NOTE_RESERVE = 96;
+
+size_t estimateTokens(std::string_view text) {
+    size_t tokens = 0;
+    size_t run = 0;
+
+    for (char c : text) {
+        unsigned char uc = static_cast<unsigned char>(c);
+        bool alnum = (uc >= '0' && uc <= '9') || (uc >= 'a' && uc <= 'z') || (uc >= 'A' && uc <= 'Z') || uc == '_';
+        if (alnum) {
+            ++run;
+            continue;
+        }
+
+        tokens += (run + CHARS_PER_WORD_TOKEN - 1) / CHARS_PER_WORD_TOKEN;
+        run = 0;
+
+        if (uc >= 0x80) {
+            // Count UTF-8 lead bytes only, so each code point costs one token
+            if ((uc & 0xC0) != 0x80) {
+                ++tokens;
+            }
+        } else if (uc != ' ' && uc != '\n' && uc != '\t' && uc != '\r') {
+            ++tokens;
+        }
+    }
+
+    return tokens + (run + CHARS_PER_WORD_TOKEN - 1) / CHARS_PER_WORD_TOKEN;
+}
+
+ContextPacker::ContextPacker() {
+}
+
+std::string ContextPacker::pack(const std::vector<ContextGroup>& groups,
+                                const std::vector<ContextSection>& sections,
+                                size_t token_budget,
+                                PackingReport* report) const {
+    std::vector<bool> keep(sections.size(), token_budget == 0);
+    std::vector<size_t> section_tokens(sections.size());
+    std::vector<size_t> group_tokens(groups.size());
+    std::vector<bool> group_charged(groups.size(), false);
+
+    for (size_t i = 0; i < sections.size(); ++i) {
+        section_tokens[i] = estimateTokens(sections[i].text);
+    }
+    for (size_t g = 0; g < groups.size(); ++g) {
+        group_tokens[g] = estimateTokens(groups[g].header) + estimateTokens(groups[g].footer);
+    }
+
+    auto costOf = [&](size_t i) {
+        int g = sections[i].group;
+        bool uncharged = g >= 0 && !group_charged[g];
+        return section_tokens[i] + (uncharged ? group_tokens[g] : 0);
+    };
+    auto take = [&](size_t i) {
+        keep[i] = true;
+        if (sections[i].group >= 0) {
+            group_charged[sections[i].group] = true;
+        }
+    };
+
+    size_t used = 0;
+    PackingReport local_report;
+    local_report.token_budget = token_budget;
+
+    if (token_budget > 0) {
+        for (size_t i = 0; i < sections.size(); ++i) {
+            if (sections[i].required) {
+                used += costOf(i);
+                take(i);
+            }
+        }
+        local_report.over_budget = used > token_budget;
+
+        // Most relevant first; ties keep document order
+        std::vector<size_t> candidates;
+        for (size_t i = 0; i < sections.size(); ++i) {
+            if (!sections[i].required) {
+                candidates.push_back(i);
+            }
+        }
+        std::stable_sort(candidates.begin(), candidates.end(), [&](size_t a, size_t b) {
+            return sections[a].relevance > sections[b].relevance;
+        });
+
+        size_t limit = token_budget > OMISSION_NOTE_RESERVE ? token_budget - OMISSION_NOTE_RESERVE : 0;
+        for (size_t i : candidates) {
+            size_t cost = costOf(i);
+            if (used + cost <= limit) {
+                used += cost;
+                take(i);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < sections.size(); ++i) {
+        if (keep[i]) {
+            local_report.included.push_back(sections[i].label);
+        } else {
+            local_report.dropped.push_back(sections[i].label);
+            local_report.dropped_tokens += section_tokens[i];
+        }
+    }
+
+    std::string packed = render(groups, sections, keep);
+    if (!local_report.dropped.empty()) {
+        size_t allowance = token_budget > used ? token_budget - used : 0;
+        packed += formatOmissionNote(local_report.dropped, local_report.dropped_tokens, allowance);
+    }
+    local_report.estimated_tokens = estimateTokens(packed);
+
+    if (report) {
+        *report = std::move(local_report);
+    }
+    return packed;
+}
+
+std::string ContextPacker::render(const std::vector<ContextGroup>& groups,
+                                  const std::vector<ContextSection>& sections,
+                                  const std::vector<bool>& keep) const {
+    std::string output;
+    int open_group = -1;
+
+    for (size_t i = 0; i < sections.size(); ++i) {
+        if (!keep[i]) {
+            continue;
+        }
+        if (sections[i].group != open_group) {
+            if (open_group >= 0) {
+                output += groups[open_group].footer;
+            }
+            open_group = sections[i].group;
+            if (open_group >= 0) {
+                output += groups[open_group].header;
+            }
+        }
+        output += sections[i].text;
+    }
+
+    if (open_group >= 0) {
+        output += groups[open_group].footer;
+    }
+    return output;
+}
+
+std::string ContextPacker::formatOmissionNote(const std::vector<std::string>& dropped,
+                                              size_t dropped_tokens, size_t token_allowance) const {
+    std::string note = "## Omitted for Context Budget\n";
+    note += std::to_string(dropped.size()) + " item(s), about " + std::to_string(dropped_tokens) +
+            " tokens, were left out: ";
+
+    // Name as many dropped items as the remaining allowance permits
+    size_t named = 0;
+    for (const auto& label : dropped) {
+        std::string candidate = note + (named > 0 ? ", " : "") + label;
+        size_t remaining = dropped.size() - named - 1;
+        std::string tail = remaining > 0 ? ", and " + std::to_string(remaining) + " more\n" : "\n";
+        if (named > 0 && estimateTokens(candidate + tail) > token_allowance) {
+            break;
+        }
+        note = std::move(candidate);
+        ++named;
+    }
+
+    size_t remaining = dropped.size() - named;
+    note += remaining > 0 ? ", and " + std::to_string(remaining) + " more\n" : "\n";
+    return note;
+}
+
+} // namespace Context
+} // namespace UnityContextGen
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace UnityContextGen {
+namespace Context {
+
+// Conservative local token estimate: alphanumeric runs cost one token per five
+// characters, punctuation one token each, and each non-ASCII code point one token.
+size_t estimateTokens(std::string_view text);
+
+// Header and footer emitted around a run of included sections, e.g. a heading
+// over component entries. Charged once, with the first member that fits.
+struct ContextGroup {
+    std::string header;
+    std::string footer;
+};
+
+struct ContextSection {
+    std::string label;          // Name reported when the section is dropped
+    std::string text;
+    float relevance = 0.0f;     // 0..1, higher is kept first
+    bool required = false;      // Always included, even over budget
+    int group = -1;             // Index into the group list, or -1
+};
+
+struct PackingReport {
+    size_t token_budget = 0;
+    size_t estimated_tokens = 0;
+    size_t dropped_tokens = 0;
+    bool over_budget = false;   // Required sections alone exceed the budget
+    std::vector<std::string> included;
+    std::vector<std::string> dropped;
+};
+
+class ContextPacker {
+public:
+    ContextPacker();
+    ~ContextPacker() = default;
+
+    // Greedily keeps the most relevant sections that fit `token_budget` (0 means
+    // unlimited), renders them in their original order and appends a note naming
+    // what was left out.
+    std::string pack(const std::vector<ContextGroup>& groups,
+                     const std::vector<ContextSection>& sections,
+                     size_t token_budget,
+                     PackingReport* report = nullptr) const;
+
+private:
+    std::string render(const std::vector<ContextGroup>& groups,
+                       const std::vector<ContextSection>& sections,
+                       const std::vector<bool>& keep) const;
+    std::string formatOmissionNote(const std::vector<std::string>& dropped,
+                                   size_t dropped_tokens, size_t token_allowance) const;
+};
+
+} // namespace Context
+} // namespace UnityContextGen
@@ -1,24 +1,46 @@
 #include "DataFlowAnalyzer.h"
 #include <algorithm>
+#include <chrono>
+#include <limits>
 #include <numeric>
 #include <sstream>
+#include <unordered_map>
 
 namespace UnityContextGen {
 namespace Context {
 
-DataFlowAnalyzer::DataFlowAnalyzer() {
+// Every node field that path ranking reads
+static bool sameFlowGraph(const std::vector<DataFlowNode>& a, const std::vector<DataFlowNode>& b) {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+                      [](const DataFlowNode& x, const DataFlowNode& y) {
+                          return x.component_name == y.component_name &&
+                                 x.direction == y.direction &&
+                                 x.data_type == y.data_type &&
+                                 x.criticality_weight == y.criticality_weight &&
+                                 x.connected_components == y.connected_components;
+                      });
+}
+
+DataFlowAnalyzer::DataFlowAnalyzer()
+    : m_has_cached_paths(false) {
+}
+
+void DataFlowAnalyzer::setBudget(const DataFlowBudget& budget) {
+    std::lock_guard<std::mutex> lock(m_path_cache_mutex);
+    m_budget = budget;
+    m_has_cached_paths = false;
+}
+
+DataFlowBudget DataFlowAnalyzer::getBudget() const {
+    std::lock_guard<std::mutex> lock(m_path_cache_mutex);
+    return m_budget;
 }
 
 DataFlowInsights DataFlowAnalyzer::analyzeDataFlow(const Metadata::ProjectMetadata& project_metadata) const {
     DataFlowInsights insights;
     
     auto nodes = buildDataFlowGraph(project_metadata);
-    auto all_flows = traceDataPaths(nodes);
-    
-    std::sort(all_flows.begin(), all_flows.end(),
-              [](const DataFlowPath& a, const DataFlowPath& b) {
-                  return a.criticality_score > b.criticality_score;
-              });
+    auto all_flows = traceDataPaths(nodes, &insights.path_budget_exhausted);
     
     size_t primary_count = std::min(static_cast<size_t>(3), all_flows.size());
     insights.primary_flows.assign(all_flows.begin(), all_flows.begin() + primary_count);
@@ -62,6 +84,7 @@ std::vector<DataFlowNode> DataFlowAnalyzer::buildDataFlowGraph(const Metadata::P
         node.connected_components = comp_metadata.dependencies;
         node.responsibility = comp_metadata.purpose;
         node.priority_level = calculatePriority(comp_metadata);
+        node.criticality_weight = calculateCriticalityWeight(comp_metadata);
         
         nodes.push_back(node);
     }
@@ -72,11 +95,6 @@ std::vector<DataFlowNode> DataFlowAnalyzer::buildDataFlowGraph(const Metadata::P
 std::vector<DataFlowPath> DataFlowAnalyzer::identifyPrimaryFlows(const std::vector<DataFlowNode>& nodes) const {
     auto flows = traceDataPaths(nodes);
     
-    std::sort(flows.begin(), flows.end(),
-              [](const DataFlowPath& a, const DataFlowPath& b) {
-                  return a.criticality_score > b.criticality_score;
-              });
-    
     size_t primary_count = std::min(static_cast<size_t>(5), flows.size());
     return std::vector<DataFlowPath>(flows.begin(), flows.begin() + primary_count);
 }
@@ -145,59 +163,220 @@ int DataFlowAnalyzer::calculatePriority(const Metadata::ComponentMetadata& metad
     return std::min(5, priority);
 }
 
-std::vector<DataFlowPath> DataFlowAnalyzer::traceDataPaths(const std::vector<DataFlowNode>& nodes) const {
-    std::vector<DataFlowPath> paths;
+std::vector<DataFlowPath> DataFlowAnalyzer::traceDataPaths(const std::vector<DataFlowNode>& nodes,
+                                                           bool* budget_exhausted) const {
+    std::lock_guard<std::mutex> lock(m_path_cache_mutex);
+    if (m_has_cached_paths && sameFlowGraph(m_cached_nodes, nodes)) {
+        if (budget_exhausted) {
+            *budget_exhausted = false;
+        }
+        return m_cached_paths;
+    }
     
-    std::map<std::string, DataFlowNode> node_map;
-    for (const auto& node : nodes) {
-        node_map[node.component_name] = node;
+    bool exhausted = false;
+    auto paths = rankDataPaths(nodes, exhausted);
+    if (budget_exhausted) {
+        *budget_exhausted = exhausted;
+    }
+    
+    // A run cut short by the deadline is not the answer for this graph; the next call tries again
+    if (!exhausted) {
+        m_cached_nodes = nodes;
+        m_cached_paths = paths;
+        m_has_cached_paths = true;
+    }
+    return paths;
+}
+
+std::vector<DataFlowPath> DataFlowAnalyzer::rankDataPaths(const std::vector<DataFlowNode>& nodes,
+                                                         bool& budget_exhausted) const {
+    budget_exhausted = false;
+    const size_t node_count = nodes.size();
+    const size_t none = std::numeric_limits<size_t>::max();
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(m_budget.time_budget_ms);
+    
+    std::unordered_map<std::string, size_t> node_index;
+    for (size_t i = 0; i < node_count; ++i) {
+        node_index[nodes[i].component_name] = i;
     }
     
-    for (const auto& start_node : nodes) {
-        if (start_node.direction == DataFlowDirection::Input) {
-            std::vector<std::string> visited;
-            std::vector<std::string> current_path;
+    std::vector<std::vector<size_t>> adjacency(node_count);
+    for (size_t i = 0; i < node_count; ++i) {
+        for (const auto& connected : nodes[i].connected_components) {
+            auto it = node_index.find(connected);
+            if (it != node_index.end() && it->second != i) {
+                adjacency[i].push_back(it->second);
+            }
+        }
+    }
+    
+    // Iterative Tarjan; components come out in reverse topological order (sinks first)
+    std::vector<size_t> component_of(node_count, none);
+    std::vector<std::vector<size_t>> components;
+    {
+        std::vector<size_t> discovery(node_count, none);
+        std::vector<size_t> low_link(node_count, 0);
+        std::vector<bool> on_stack(node_count, false);
+        std::vector<size_t> stack;
+        std::vector<std::pair<size_t, size_t>> call_stack;
+        size_t counter = 0;
+        
+        for (size_t root = 0; root < node_count; ++root) {
+            if (discovery[root] != none) continue;
             
-            std::function<void(const std::string&)> tracePath = [&](const std::string& comp_name) {
-                if (std::find(visited.begin(), visited.end(), comp_name) != visited.end()) {
-                    return;
-                }
+            call_stack.push_back({root, 0});
+            while (!call_stack.empty()) {
+                size_t v = call_stack.back().first;
+                size_t& edge = call_stack.back().second;
                 
-                visited.push_back(comp_name);
-                current_path.push_back(comp_name);
+                if (edge == 0 && discovery[v] == none) {
+                    discovery[v] = low_link[v] = counter++;
+                    stack.push_back(v);
+                    on_stack[v] = true;
+                }
                 
-                auto node_it = node_map.find(comp_name);
-                if (node_it != node_map.end()) {
-                    for (const auto& connected : node_it->second.connected_components) {
-                        if (std::find(visited.begin(), visited.end(), connected) == visited.end()) {
-                            tracePath(connected);
-                        }
+                if (edge < adjacency[v].size()) {
+                    size_t w = adjacency[v][edge++];
+                    if (discovery[w] == none) {
+                        call_stack.push_back({w, 0});
+                    } else if (on_stack[w]) {
+                        low_link[v] = std::min(low_link[v], discovery[w]);
                     }
+                    continue;
                 }
                 
-                if (current_path.size() >= 2) {
-                    DataFlowPath path;
-                    path.path_components = current_path;
-                    path.data_description = start_node.data_type + " flow";
-                    path.flow_type = identifyFlowType(path);
-                    
-                    paths.push_back(path);
+                if (low_link[v] == discovery[v]) {
+                    std::vector<size_t> members;
+                    size_t w;
+                    do {
+                        w = stack.back();
+                        stack.pop_back();
+                        on_stack[w] = false;
+                        component_of[w] = components.size();
+                        members.push_back(w);
+                    } while (w != v);
+                    // Stack order depends on edge order; node order keeps paths deterministic
+                    std::sort(members.begin(), members.end());
+                    components.push_back(members);
                 }
                 
-                current_path.pop_back();
-            };
+                call_stack.pop_back();
+                if (!call_stack.empty()) {
+                    size_t parent = call_stack.back().first;
+                    low_link[parent] = std::min(low_link[parent], low_link[v]);
+                }
+            }
+        }
+    }
+    
+    // Best-k suffixes per condensation node, ranked by accumulated criticality weight
+    struct Suffix {
+        float weight;
+        size_t length;
+        size_t next_component;
+        size_t next_rank;
+    };
+    
+    const size_t component_count = components.size();
+    const size_t k = std::max<size_t>(1, m_budget.max_paths);
+    std::vector<std::vector<Suffix>> best_suffixes(component_count);
+    
+    for (size_t c = 0; c < component_count; ++c) {
+        float weight = 0.0f;
+        for (size_t member : components[c]) {
+            weight += nodes[member].criticality_weight;
+        }
+        size_t length = components[c].size();
+        
+        std::vector<Suffix> candidates;
+        if (!budget_exhausted && std::chrono::steady_clock::now() > deadline) {
+            budget_exhausted = true;
+        }
+        
+        if (!budget_exhausted) {
+            std::vector<size_t> successors;
+            for (size_t member : components[c]) {
+                for (size_t target : adjacency[member]) {
+                    if (component_of[target] != c) {
+                        successors.push_back(component_of[target]);
+                    }
+                }
+            }
+            std::sort(successors.begin(), successors.end());
+            successors.erase(std::unique(successors.begin(), successors.end()), successors.end());
             
-            tracePath(start_node.component_name);
+            for (size_t next : successors) {
+                for (size_t rank = 0; rank < best_suffixes[next].size(); ++rank) {
+                    const Suffix& suffix = best_suffixes[next][rank];
+                    if (length + suffix.length <= m_budget.max_path_length) {
+                        candidates.push_back({weight + suffix.weight, length + suffix.length, next, rank});
+                    }
+                }
+            }
         }
+        
+        if (candidates.empty()) {
+            candidates.push_back({weight, length, none, 0});
+        }
+        
+        auto better = [](const Suffix& a, const Suffix& b) {
+            if (a.weight != b.weight) return a.weight > b.weight;
+            return a.length > b.length;
+        };
+        size_t keep = std::min(k, candidates.size());
+        std::partial_sort(candidates.begin(), candidates.begin() + keep, candidates.end(), better);
+        candidates.resize(keep);
+        best_suffixes[c] = std::move(candidates);
     }
     
-    std::sort(paths.begin(), paths.end(),
-              [](const DataFlowPath& a, const DataFlowPath& b) {
-                  return a.path_components.size() > b.path_components.size();
-              });
+    std::vector<DataFlowPath> paths;
+    for (size_t start = 0; start < node_count; ++start) {
+        if (nodes[start].direction != DataFlowDirection::Input) continue;
+        
+        size_t start_component = component_of[start];
+        for (const auto& head : best_suffixes[start_component]) {
+            DataFlowPath path;
+            path.path_components.push_back(nodes[start].component_name);
+            for (size_t member : components[start_component]) {
+                if (member != start) {
+                    path.path_components.push_back(nodes[member].component_name);
+                }
+            }
+            
+            size_t component = head.next_component;
+            size_t rank = head.next_rank;
+            while (component != none) {
+                for (size_t member : components[component]) {
+                    path.path_components.push_back(nodes[member].component_name);
+                }
+                const Suffix& suffix = best_suffixes[component][rank];
+                component = suffix.next_component;
+                rank = suffix.next_rank;
+            }
+            
+            if (path.path_components.size() > m_budget.max_path_length) {
+                path.path_components.resize(m_budget.max_path_length);
+            }
+            if (path.path_components.size() < 2) continue;
+            
+            path.data_description = nodes[start].data_type + " flow";
+            path.flow_type = identifyFlowType(path);
+            path.criticality_score = calculateCriticality(head.weight, nodes[start].component_name);
+            paths.push_back(path);
+        }
+    }
     
-    size_t max_paths = std::min(static_cast<size_t>(10), paths.size());
-    paths.resize(max_paths);
+    std::stable_sort(paths.begin(), paths.end(),
+                     [](const DataFlowPath& a, const DataFlowPath& b) {
+                         if (a.criticality_score != b.criticality_score) {
+                             return a.criticality_score > b.criticality_score;
+                         }
+                         return a.path_components.size() > b.path_components.size();
+                     });
+    
+    if (paths.size() > m_budget.max_paths) {
+        paths.resize(m_budget.max_paths);
+    }
     
     return paths;
 }
@@ -237,24 +416,22 @@ std::string DataFlowAnalyzer::identifyFlowType(const DataFlowPath& path) const {
     }
 }
 
-float DataFlowAnalyzer::calculateCriticality(const DataFlowPath& path,
-                                            const Metadata::ProjectMetadata& project_metadata) const {
-    float criticality = 0.5f;
+float DataFlowAnalyzer::calculateCriticalityWeight(const Metadata::ComponentMetadata& metadata) const {
+    float weight = 0.1f;
     
-    criticality += path.path_components.size() * 0.1f;
+    weight += metadata.dependents.size() * 0.05f;
     
-    for (const auto& comp : path.path_components) {
-        auto comp_it = project_metadata.components.find(comp);
-        if (comp_it != project_metadata.components.end()) {
-            criticality += comp_it->second.dependents.size() * 0.05f;
-            
-            if (comp_it->second.metrics.complexity_score > 30) {
-                criticality += 0.1f;
-            }
-        }
+    if (metadata.metrics.complexity_score > 30) {
+        weight += 0.1f;
     }
     
-    std::string first_comp_lower = path.path_components[0];
+    return weight;
+}
+
+float DataFlowAnalyzer::calculateCriticality(float path_weight, const std::string& start_component) const {
+    float criticality = 0.5f + path_weight;
+    
+    std::string first_comp_lower = start_component;
     std::transform(first_comp_lower.begin(), first_comp_lower.end(), first_comp_lower.begin(), ::tolower);
     
     if (first_comp_lower.find("player") != std::string::npos) {
@@ -5,6 +5,7 @@
 #include <vector>
 #include <map>
 #include <set>
+#include <mutex>
 
 namespace UnityContextGen {
 namespace Context {
@@ -24,6 +25,7 @@ struct DataFlowNode {
     std::vector<std::string> connected_components;
     std::string responsibility;
     int priority_level;
+    float criticality_weight;
 };
 
 struct DataFlowPath {
@@ -41,6 +43,14 @@ struct DataFlowInsights {
     std::vector<std::string> isolated_components;
     std::string dominant_flow_pattern;
     float flow_efficiency_score;
+    bool path_budget_exhausted = false;
+};
+
+// Limits for path enumeration; the time budget is checked while ranking paths
+struct DataFlowBudget {
+    size_t max_paths = 10;
+    size_t max_path_length = 16;
+    int time_budget_ms = 100;
 };
 
 class DataFlowAnalyzer {
@@ -59,18 +69,32 @@ public:
     std::vector<std::string> findDataHotspots(const std::vector<DataFlowNode>& nodes) const;
     
     float calculateFlowEfficiency(const std::vector<DataFlowPath>& flows) const;
+    
+    void setBudget(const DataFlowBudget& budget);
+    DataFlowBudget getBudget() const;
 
 private:
+    DataFlowBudget m_budget;
+    
+    // Complete paths for the most recent graph, shared by analyzeDataFlow and identifyPrimaryFlows
+    mutable std::mutex m_path_cache_mutex;
+    mutable bool m_has_cached_paths;
+    mutable std::vector<DataFlowNode> m_cached_nodes;
+    mutable std::vector<DataFlowPath> m_cached_paths;
+    
     DataFlowDirection inferDataDirection(const std::string& component_name,
                                        const Metadata::ComponentMetadata& metadata) const;
     
     std::string inferDataType(const Metadata::ComponentMetadata& metadata) const;
     int calculatePriority(const Metadata::ComponentMetadata& metadata) const;
     
-    std::vector<DataFlowPath> traceDataPaths(const std::vector<DataFlowNode>& nodes) const;
+    std::vector<DataFlowPath> traceDataPaths(const std::vector<DataFlowNode>& nodes,
+                                           bool* budget_exhausted = nullptr) const;
+    std::vector<DataFlowPath> rankDataPaths(const std::vector<DataFlowNode>& nodes,
+                                          bool& budget_exhausted) const;
     std::string identifyFlowType(const DataFlowPath& path) const;
-    float calculateCriticality(const DataFlowPath& path, 
-                              const Metadata::ProjectMetadata& project_metadata) const;
+    float calculateCriticalityWeight(const Metadata::ComponentMetadata& metadata) const;
+    float calculateCriticality(float path_weight, const std::string& start_component) const;
     
     std::string determineDominantPattern(const std::vector<DataFlowPath>& flows) const;
     
@@ -1,5 +1,8 @@
 #include "ProjectSummarizer.h"
 #include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <set>
 #include <sstream>
 #include <iomanip>
 
@@ -9,9 +12,15 @@ namespace Context {
 ProjectSummarizer::ProjectSummarizer() {
 }
 
+void ProjectSummarizer::setDataFlowBudget(const DataFlowBudget& budget) {
+    m_data_flow_analyzer.setBudget(budget);
+}
+
 ProjectContext ProjectSummarizer::generateProjectContext(const Metadata::ProjectMetadata& project_metadata) const {
     ProjectContext context;
     
+    auto statistics = m_architecture_analyzer.computeProjectStatistics(project_metadata);
+    
     context.summary.project_type = project_metadata.project_summary.game_type;
     context.summary.architecture_pattern = project_metadata.project_summary.architecture_pattern;
     context.summary.complexity_level = project_metadata.project_summary.complexity_level;
@@ -19,12 +28,12 @@ ProjectContext ProjectSummarizer::generateProjectContext(const Metadata::Project
     context.summary.key_characteristics = extractKeyCharacteristics(project_metadata);
     context.summary.quality_score = calculateOverallQuality(project_metadata);
     
-    context.architecture = m_architecture_analyzer.analyzeArchitecture(project_metadata);
+    context.architecture = m_architecture_analyzer.analyzeArchitecture(project_metadata, statistics);
     context.data_flow = m_data_flow_analyzer.analyzeDataFlow(project_metadata);
     
     context.guidance.coding_conventions = generateCodingConventions(project_metadata);
     context.guidance.architectural_principles = generateArchitecturalPrinciples(context.architecture);
-    context.guidance.performance_guidelines = generatePerformanceGuidelines(project_metadata);
+    context.guidance.performance_guidelines = generatePerformanceGuidelines(project_metadata, statistics);
     context.guidance.unity_best_practices = generateUnityBestPractices(project_metadata);
     context.guidance.recommended_approach = "Follow established patterns and maintain component separation";
     
@@ -40,13 +49,58 @@ ProjectContext ProjectSummarizer::generateProjectContext(const Metadata::Project
     
     context.critical_components = identifyCriticalComponents(project_metadata);
     context.improvement_priorities = prioritizeImprovements(project_metadata, context.architecture);
+    context.component_relevance = scoreComponentRelevance(context, &project_metadata);
     
     return context;
 }
 
 std::string ProjectSummarizer::generateLLMContextPrompt(const ProjectContext& context) const {
-    std::stringstream prompt;
+    std::vector<ContextGroup> groups;
+    std::vector<ContextSection> sections;
+    auto relevance = context.component_relevance.empty() ? scoreComponentRelevance(context, nullptr)
+                                                         : context.component_relevance;
+    buildPromptSections(context, relevance, groups, sections);
+    return m_context_packer.pack(groups, sections, 0);
+}
+
+std::string ProjectSummarizer::generateLLMContextPrompt(const ProjectContext& context,
+                                                        const Metadata::ProjectMetadata& project_metadata,
+                                                        size_t token_budget,
+                                                        PackingReport* report) const {
+    std::vector<ContextGroup> groups;
+    std::vector<ContextSection> sections;
+    // Every exported prompt reuses the analysis-time scores instead of re-reading the sources
+    auto relevance = context.component_relevance.empty() ? scoreComponentRelevance(context, &project_metadata)
+                                                         : context.component_relevance;
+    buildPromptSections(context, relevance, groups, sections);
+    return m_context_packer.pack(groups, sections, token_budget, report);
+}
+
+std::string ProjectSummarizer::generateReviewContextPrompt(const ProjectContext& context,
+                                                           const Metadata::ProjectMetadata& project_metadata,
+                                                           size_t token_budget) const {
+    std::vector<ContextGroup> groups;
+    std::vector<ContextSection> sections;
+    buildPromptSections(context, scoreComponentRelevance(context, &project_metadata, false), groups, sections);
+    return m_context_packer.pack(groups, sections, token_budget);
+}
+
+void ProjectSummarizer::buildPromptSections(const ProjectContext& context,
+                                            const std::map<std::string, float>& relevance,
+                                            std::vector<ContextGroup>& groups,
+                                            std::vector<ContextSection>& sections) const {
+    enum { COMPONENT_GROUP, GUIDELINES_GROUP };
+    groups = {
+        {"## Component Overview\n", "\n"},
+        {"## Development Guidelines\n", ""}
+    };
+    
+    auto addSection = [&sections](const std::string& label, const std::stringstream& text,
+                                  float relevance, bool required = false, int group = -1) {
+        sections.push_back({label, text.str(), relevance, required, group});
+    };
     
+    std::stringstream prompt;
     prompt << "# Unity Project Context\n\n";
     
     prompt << "## Project Overview\n";
@@ -63,7 +117,9 @@ std::string ProjectSummarizer::generateLLMContextPrompt(const ProjectContext& co
         }
         prompt << "\n";
     }
+    addSection("Project Overview", prompt, 1.0f, true);
     
+    prompt.str("");
     prompt << "## Architecture Insights\n";
     prompt << "**Primary Pattern:** " << context.architecture.description << "\n";
     prompt << "**Confidence:** " << static_cast<int>(context.architecture.confidence_score * 100) << "%\n\n";
@@ -75,7 +131,9 @@ std::string ProjectSummarizer::generateLLMContextPrompt(const ProjectContext& co
         }
         prompt << "\n";
     }
+    addSection("Architecture Insights", prompt, 0.9f);
     
+    prompt.str("");
     prompt << "## Data Flow\n";
     prompt << "**Dominant Pattern:** " << context.data_flow.dominant_flow_pattern << "\n";
     prompt << "**Efficiency:** " << static_cast<int>(context.data_flow.flow_efficiency_score * 100) << "%\n\n";
@@ -93,52 +151,125 @@ std::string ProjectSummarizer::generateLLMContextPrompt(const ProjectContext& co
         }
         prompt << "\n";
     }
+    addSection("Data Flow", prompt, 0.6f);
     
-    prompt << "## Component Overview\n";
     for (const auto& purpose_pair : context.llm_context.component_purposes) {
+        prompt.str("");
         prompt << "**" << purpose_pair.first << ":** " << purpose_pair.second << "\n";
+        auto score_it = relevance.find(purpose_pair.first);
+        addSection(purpose_pair.first, prompt, score_it != relevance.end() ? score_it->second : 0.0f,
+                   false, COMPONENT_GROUP);
     }
-    prompt << "\n";
     
     if (!context.critical_components.empty()) {
+        prompt.str("");
         prompt << "## Critical Components\n";
         for (const auto& component : context.critical_components) {
             prompt << "- " << component << "\n";
         }
         prompt << "\n";
+        addSection("Critical Components", prompt, 0.95f);
     }
     
-    prompt << "## Development Guidelines\n";
+    prompt.str("");
     prompt << "**Style:** " << context.llm_context.development_style << "\n\n";
+    addSection("Development Style", prompt, 0.8f, false, GUIDELINES_GROUP);
     
     if (!context.llm_context.key_patterns.empty()) {
+        prompt.str("");
         prompt << "**Key Patterns to Follow:**\n";
         for (const auto& pattern : context.llm_context.key_patterns) {
             prompt << "- " << pattern << "\n";
         }
         prompt << "\n";
+        addSection("Key Patterns", prompt, 0.85f, false, GUIDELINES_GROUP);
     }
     
     if (!context.guidance.coding_conventions.empty()) {
+        prompt.str("");
         prompt << "**Coding Conventions:**\n";
         for (const auto& convention : context.guidance.coding_conventions) {
             prompt << "- " << convention << "\n";
         }
         prompt << "\n";
+        addSection("Coding Conventions", prompt, 0.7f, false, GUIDELINES_GROUP);
     }
     
     if (!context.improvement_priorities.empty()) {
+        prompt.str("");
         prompt << "## Improvement Priorities\n";
         for (size_t i = 0; i < context.improvement_priorities.size(); ++i) {
             prompt << (i + 1) << ". " << context.improvement_priorities[i] << "\n";
         }
         prompt << "\n";
+        addSection("Improvement Priorities", prompt, 0.5f);
     }
     
+    prompt.str("");
     prompt << "## Recommended Approach\n";
     prompt << context.guidance.recommended_approach << "\n";
+    addSection("Recommended Approach", prompt, 0.75f);
+}
+
+std::map<std::string, float> ProjectSummarizer::scoreComponentRelevance(
+    const ProjectContext& context, const Metadata::ProjectMetadata* project_metadata, bool include_recency) const {
+    static const float CRITICALITY_WEIGHT = 0.5f;
+    static const float CENTRALITY_WEIGHT = 0.3f;
+    static const float RECENCY_WEIGHT = 0.2f;
+    static const double RECENCY_HALF_LIFE_HOURS = 24.0;
+    
+    std::set<std::string> critical(context.critical_components.begin(), context.critical_components.end());
+    std::map<std::string, float> scores;
+    for (const auto& purpose_pair : context.llm_context.component_purposes) {
+        scores[purpose_pair.first] = critical.count(purpose_pair.first) ? CRITICALITY_WEIGHT : 0.0f;
+    }
     
-    return prompt.str();
+    if (!project_metadata) {
+        return scores;
+    }
+    
+    size_t max_degree = 1;
+    for (const auto& comp_pair : project_metadata->components) {
+        const auto& comp = comp_pair.second;
+        max_degree = std::max(max_degree, comp.dependencies.size() + comp.dependents.size());
+    }
+    
+    // Recently edited scripts are the likeliest subject of the next request.
+    // Ages are measured from the newest script, not the clock, so the same
+    // tree always ranks (and packs) the same way
+    std::map<std::string, std::filesystem::file_time_type> modified_times;
+    if (include_recency) {
+        for (const auto& comp_pair : project_metadata->components) {
+            std::error_code ec;
+            auto modified = std::filesystem::last_write_time(comp_pair.second.file_path, ec);
+            if (!ec) {
+                modified_times[comp_pair.first] = modified;
+            }
+        }
+    }
+    auto newest = std::filesystem::file_time_type::min();
+    for (const auto& modified_pair : modified_times) {
+        newest = std::max(newest, modified_pair.second);
+    }
+    
+    for (const auto& comp_pair : project_metadata->components) {
+        const auto& comp = comp_pair.second;
+        auto score_it = scores.find(comp_pair.first);
+        if (score_it == scores.end()) {
+            continue;
+        }
+        
+        float degree = static_cast<float>(comp.dependencies.size() + comp.dependents.size());
+        score_it->second += CENTRALITY_WEIGHT * degree / static_cast<float>(max_degree);
+        
+        auto modified_it = modified_times.find(comp_pair.first);
+        if (modified_it != modified_times.end()) {
+            double age_hours = std::chrono::duration<double, std::ratio<3600>>(newest - modified_it->second).count();
+            score_it->second += RECENCY_WEIGHT * static_cast<float>(RECENCY_HALF_LIFE_HOURS / (RECENCY_HALF_LIFE_HOURS + age_hours));
+        }
+    }
+    
+    return scores;
 }
 
 std::string ProjectSummarizer::generateComponentGuidance(const std::string& component_name,
@@ -354,19 +485,11 @@ std::vector<std::string> ProjectSummarizer::generateArchitecturalPrinciples(cons
     return principles;
 }
 
-std::vector<std::string> ProjectSummarizer::generatePerformanceGuidelines(const Metadata::ProjectMetadata& project_metadata) const {
+std::vector<std::string> ProjectSummarizer::generatePerformanceGuidelines(const Metadata::ProjectMetadata& project_metadata,
+                                                                         const ProjectStatistics& statistics) const {
     std::vector<std::string> guidelines;
     
-    int update_method_count = 0;
-    for (const auto& comp_pair : project_metadata.components) {
-        for (const auto& method : comp_pair.second.lifecycle.methods) {
-            if (method == "Update") {
-                update_method_count++;
-            }
-        }
-    }
-    
-    if (update_method_count > 10) {
+    if (statistics.update_method_count > 10) {
         guidelines.push_back("Minimize Update() method usage - consider event-driven alternatives");
         guidelines.push_back("Use coroutines for time-based operations instead of Update() checks");
     }
@@ -571,7 +694,8 @@ nlohmann::json ProjectSummarizer::exportContextToJSON(const ProjectContext& cont
         {"dominant_pattern", context.data_flow.dominant_flow_pattern},
         {"efficiency_score", context.data_flow.flow_efficiency_score},
         {"data_hotspots", context.data_flow.data_hotspots},
-        {"isolated_components", context.data_flow.isolated_components}
+        {"isolated_components", context.data_flow.isolated_components},
+        {"path_budget_exhausted", context.data_flow.path_budget_exhausted}
     };
     
     json_context["guidance"] = {
@@ -630,6 +754,101 @@ nlohmann::json ProjectSummarizer::exportLLMOptimizedJSON(const ProjectContext& c
     return optimized;
 }
 
+// Keys are written in the sorted order nlohmann::json uses, matching exportContextToJSON
+void ProjectSummarizer::writeContextJSON(const ProjectContext& context, Metadata::JSONStreamWriter& writer) const {
+    writer.beginObject();
+    
+    writer.key("architecture");
+    writer.beginObject();
+    writer.field("characteristics", context.architecture.characteristics);
+    writer.field("confidence_score", context.architecture.confidence_score);
+    writer.field("description", context.architecture.description);
+    writer.field("evidence", context.architecture.evidence);
+    writer.endObject();
+    
+    writer.field("critical_components", context.critical_components);
+    
+    writer.key("data_flow");
+    writer.beginObject();
+    writer.field("data_hotspots", context.data_flow.data_hotspots);
+    writer.field("dominant_pattern", context.data_flow.dominant_flow_pattern);
+    writer.field("efficiency_score", context.data_flow.flow_efficiency_score);
+    writer.field("isolated_components", context.data_flow.isolated_components);
+    writer.field("path_budget_exhausted", context.data_flow.path_budget_exhausted);
+    writer.endObject();
+    
+    writer.key("guidance");
+    writer.beginObject();
+    writer.field("architectural_principles", context.guidance.architectural_principles);
+    writer.field("coding_conventions", context.guidance.coding_conventions);
+    writer.field("performance_guidelines", context.guidance.performance_guidelines);
+    writer.field("recommended_approach", context.guidance.recommended_approach);
+    writer.field("unity_best_practices", context.guidance.unity_best_practices);
+    writer.endObject();
+    
+    writer.field("improvement_priorities", context.improvement_priorities);
+    
+    writer.key("llm_context");
+    writer.beginObject();
+    writer.field("component_purposes", context.llm_context.component_purposes);
+    writer.field("component_template", context.llm_context.component_template);
+    writer.field("context_prompt", context.llm_context.context_prompt);
+    writer.field("development_style", context.llm_context.development_style);
+    writer.field("key_patterns", context.llm_context.key_patterns);
+    writer.endObject();
+    
+    writer.key("summary");
+    writer.beginObject();
+    writer.field("architecture_pattern", context.summary.architecture_pattern);
+    writer.field("complexity_level", context.summary.complexity_level);
+    writer.field("development_stage", context.summary.development_stage);
+    writer.field("key_characteristics", context.summary.key_characteristics);
+    writer.field("project_type", context.summary.project_type);
+    writer.field("quality_score", context.summary.quality_score);
+    writer.endObject();
+    
+    writer.endObject();
+}
+
+void ProjectSummarizer::writeLLMOptimizedJSON(const ProjectContext& context, Metadata::JSONStreamWriter& writer) const {
+    std::set<std::string> critical_components(context.critical_components.begin(),
+                                              context.critical_components.end());
+    
+    writer.beginObject();
+    
+    writer.key("architecture_info");
+    writer.beginObject();
+    writer.field("confidence", context.architecture.confidence_score);
+    writer.field("data_flow", context.data_flow.dominant_flow_pattern);
+    writer.field("pattern", context.summary.architecture_pattern);
+    writer.endObject();
+    
+    writer.key("coding_guidelines");
+    writer.beginObject();
+    writer.field("conventions", context.guidance.coding_conventions);
+    writer.field("performance", context.guidance.performance_guidelines);
+    writer.field("unity_practices", context.guidance.unity_best_practices);
+    writer.endObject();
+    
+    writer.key("component_guidance");
+    writer.beginObject();
+    for (const auto& purpose_pair : context.llm_context.component_purposes) {
+        writer.key(purpose_pair.first);
+        writer.beginObject();
+        writer.field("is_critical", critical_components.count(purpose_pair.first) > 0);
+        writer.field("purpose", purpose_pair.second);
+        writer.endObject();
+    }
+    writer.endObject();
+    
+    writer.field("development_style", context.llm_context.development_style);
+    writer.field("improvement_focus", context.improvement_priorities);
+    writer.field("key_patterns", context.llm_context.key_patterns);
+    writer.field("project_context", context.llm_context.context_prompt);
+    
+    writer.endObject();
+}
+
 std::string ProjectSummarizer::generateDevelopmentGuidelines(const ProjectContext& context) const {
     std::stringstream guidelines;
     
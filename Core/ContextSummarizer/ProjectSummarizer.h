@@ -2,7 +2,9 @@
 
 #include "ArchitectureAnalyzer.h"
 #include "DataFlowAnalyzer.h"
+#include "ContextPacker.h"
 #include "../MetadataGenerator/ProjectMetadata.h"
+#include "../MetadataGenerator/JSONStreamWriter.h"
 #include <nlohmann/json.hpp>
 #include <string>
 #include <vector>
@@ -40,6 +42,10 @@ struct ProjectContext {
     DataFlowInsights data_flow;
     std::vector<std::string> critical_components;
     std::vector<std::string> improvement_priorities;
+    
+    // Prompt packing relevance, scored once at analysis time (reads source timestamps,
+    // relative to the newest source so an unchanged tree scores the same)
+    std::map<std::string, float> component_relevance;
 };
 
 class ProjectSummarizer {
@@ -48,14 +54,27 @@ public:
     ~ProjectSummarizer() = default;
 
     ProjectContext generateProjectContext(const Metadata::ProjectMetadata& project_metadata) const;
+    void setDataFlowBudget(const DataFlowBudget& budget);
     
     std::string generateLLMContextPrompt(const ProjectContext& context) const;
+    // Keeps the most relevant sections within token_budget (0 for unlimited)
+    std::string generateLLMContextPrompt(const ProjectContext& context,
+                                         const Metadata::ProjectMetadata& project_metadata,
+                                         size_t token_budget,
+                                         PackingReport* report = nullptr) const;
+    // Project prefix shared by AI reviews. Ranked without file timestamps, so
+    // it only changes when the analyzed project does and stays cacheable
+    std::string generateReviewContextPrompt(const ProjectContext& context,
+                                            const Metadata::ProjectMetadata& project_metadata,
+                                            size_t token_budget) const;
     std::string generateComponentGuidance(const std::string& component_name,
                                         const ProjectContext& context) const;
     std::string generateArchitectureOverview(const ProjectContext& context) const;
     
     nlohmann::json exportContextToJSON(const ProjectContext& context) const;
     nlohmann::json exportLLMOptimizedJSON(const ProjectContext& context) const;
+    void writeContextJSON(const ProjectContext& context, Metadata::JSONStreamWriter& writer) const;
+    void writeLLMOptimizedJSON(const ProjectContext& context, Metadata::JSONStreamWriter& writer) const;
     
     std::string generateDevelopmentGuidelines(const ProjectContext& context) const;
     std::string generateQuickReference(const ProjectContext& context) const;
@@ -63,6 +82,15 @@ public:
 private:
     ArchitectureAnalyzer m_architecture_analyzer;
     DataFlowAnalyzer m_data_flow_analyzer;
+    ContextPacker m_context_packer;
+    
+    void buildPromptSections(const ProjectContext& context,
+                             const std::map<std::string, float>& relevance,
+                             std::vector<ContextGroup>& groups,
+                             std::vector<ContextSection>& sections) const;
+    std::map<std::string, float> scoreComponentRelevance(const ProjectContext& context,
+                                                         const Metadata::ProjectMetadata* project_metadata,
+                                                         bool include_recency = true) const;
     
     std::string inferDevelopmentStage(const Metadata::ProjectMetadata& project_metadata) const;
     std::vector<std::string> extractKeyCharacteristics(const Metadata::ProjectMetadata& project_metadata) const;
@@ -70,7 +98,8 @@ private:
     
     std::vector<std::string> generateCodingConventions(const Metadata::ProjectMetadata& project_metadata) const;
     std::vector<std::string> generateArchitecturalPrinciples(const ArchitectureInsight& architecture) const;
-    std::vector<std::string> generatePerformanceGuidelines(const Metadata::ProjectMetadata& project_metadata) const;
+    std::vector<std::string> generatePerformanceGuidelines(const Metadata::ProjectMetadata& project_metadata,
+                                                           const ProjectStatistics& statistics) const;
     std::vector<std::string> generateUnityBestPractices(const Metadata::ProjectMetadata& project_metadata) const;
     
     std::string generateContextPrompt(const Metadata::ProjectMetadata& project_metadata,
@@ -0,0 +1,75 @@
+#include "SourceStamp.h"
+#include <algorithm>
+#include <filesystem>
+
+namespace UnityContextGen {
+namespace Context {
+
+std::string normalizeSourcePath(const std::string& path) {
+    return std::filesystem::path(path).lexically_normal().generic_string();
+}
+
+SourceStamp stampSourceFile(const std::string& path) {
+    SourceStamp stamp{normalizeSourcePath(path), 0, 0};
+    std::error_code ec;
+    auto modified = std::filesystem::last_write_time(path, ec);
+    if (!ec) {
+        stamp.modified = static_cast<int64_t>(modified.time_since_epoch().count());
+    }
+    uintmax_t size = std::filesystem::file_size(path, ec);
+    if (!ec) {
+        stamp.size = size;
+    }
+    return stamp;
+}
+
+std::vector<SourceStamp> stampSourceFiles(const std::vector<std::string>& source_files) {
+    std::vector<SourceStamp> stamps;
+    stamps.reserve(source_files.size());
+    for (const auto& path : source_files) {
+        stamps.push_back(stampSourceFile(path));
+    }
+    std::sort(stamps.begin(), stamps.end(),
+              [](const SourceStamp& a, const SourceStamp& b) { return a.path < b.path; });
+    return stamps;
+}
+
+bool sourcesUnchanged(const std::vector<SourceStamp>& recorded, const std::vector<std::string>& source_files) {
+    if (source_files.size() != recorded.size()) {
+        return false;
+    }
+
+    std::vector<SourceStamp> current = stampSourceFiles(source_files);
+    for (size_t i = 0; i < current.size(); ++i) {
+        if (current[i].path != recorded[i].path || current[i].modified != recorded[i].modified ||
+            current[i].size != recorded[i].size) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void writeSourceStampsJSON(const std::vector<SourceStamp>& stamps, Metadata::JSONStreamWriter& writer) {
+    writer.beginArray();
+    for (const auto& stamp : stamps) {
+        writer.beginObject();
+        writer.field("path", stamp.path);
+        writer.field("modified", stamp.modified);
+        writer.field("size", static_cast<size_t>(stamp.size));
+        writer.endObject();
+    }
+    writer.endArray();
+}
+
+std::vector<SourceStamp> readSourceStamps(const nlohmann::json& stamps) {
+    std::vector<SourceStamp> result;
+    for (const auto& stamp : stamps) {
+        result.push_back({stamp.at("path").get<std::string>(),
+                          stamp.at("modified").get<int64_t>(),
+                          stamp.at("size").get<uintmax_t>()});
+    }
+    return result;
+}
+
+} // namespace Context
+} // namespace UnityContextGen
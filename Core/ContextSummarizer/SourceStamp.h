@@ -0,0 +1,32 @@
+#pragma once
+
+#include "../MetadataGenerator/JSONStreamWriter.h"
+#include <nlohmann/json.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace UnityContextGen {
+namespace Context {
+
+// Size and modification time of a source file an on-disk index was built from
+struct SourceStamp {
+    std::string path;
+    int64_t modified;
+    uintmax_t size;
+};
+
+std::string normalizeSourcePath(const std::string& path);
+SourceStamp stampSourceFile(const std::string& path);
+
+// Stamps sorted by normalized path
+std::vector<SourceStamp> stampSourceFiles(const std::vector<std::string>& source_files);
+
+// True when source_files is exactly the recorded set, none modified since
+bool sourcesUnchanged(const std::vector<SourceStamp>& recorded, const std::vector<std::string>& source_files);
+
+void writeSourceStampsJSON(const std::vector<SourceStamp>& stamps, Metadata::JSONStreamWriter& writer);
+std::vector<SourceStamp> readSourceStamps(const nlohmann::json& stamps);
+
+} // namespace Context
+} // namespace UnityContextGen
@@ -0,0 +1,359 @@
+#include "SymbolIndex.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <unordered_set>
+
+namespace UnityContextGen {
+namespace Context {
+
+static const int INDEX_FORMAT_VERSION = 2;
+
+// Field weights: a hit on the class name says more than one on a field type
+static const float CLASS_WEIGHT = 3.0f;
+static const float METHOD_WEIGHT = 2.0f;
+static const float FIELD_WEIGHT = 1.0f;
+static const float ATTRIBUTE_WEIGHT = 1.0f;
+static const float DEPENDENCY_WEIGHT = 1.5f;
+static const float API_WEIGHT = 1.0f;
+static const float SCOPED_API_WEIGHT = 1.0f;
+
+// BM25 parameters
+static const double BM25_K1 = 1.2;
+static const double BM25_B = 0.75;
+
+static const std::unordered_set<std::string> STOP_WORDS = {
+    "a", "an", "and", "are", "by", "call", "calls", "components", "do", "does",
+    "for", "from", "in", "inside", "is", "it", "of", "on", "or", "that", "the", "to", "touch",
+    "touches", "use", "used", "uses", "using", "what", "where", "which", "who", "with"
+};
+
+static std::string toLower(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return text;
+}
+
+SymbolIndex::SymbolIndex() : m_average_length(1.0f), m_includes_api_usage(false) {
+}
+
+void SymbolIndex::build(const std::vector<Unity::MonoBehaviourInfo>& monobehaviours,
+                        const std::vector<AI::UnityAPIUsage>& api_usage,
+                        const std::vector<std::string>& source_files,
+                        bool includes_api_usage) {
+    *this = SymbolIndex();
+    m_includes_api_usage = includes_api_usage;
+    m_sources = stampSourceFiles(source_files);
+
+    std::vector<std::unordered_map<std::string, float>> term_weights(monobehaviours.size());
+    std::unordered_map<std::string, std::vector<uint32_t>> by_class;
+    std::unordered_map<std::string, std::vector<uint32_t>> by_file;
+
+    for (const auto& mb : monobehaviours) {
+        uint32_t id = static_cast<uint32_t>(m_documents.size());
+        m_documents.push_back({mb.class_name, mb.file_path, 0.0f});
+        by_class[mb.class_name].push_back(id);
+        by_file[normalizeSourcePath(mb.file_path)].push_back(id);
+
+        auto add = [&](const std::vector<std::string>& symbols, float weight) {
+            for (const auto& symbol : symbols) {
+                for (const auto& token : tokenize(symbol)) {
+                    term_weights[id][token] += weight;
+                    m_documents[id].length += weight;
+                }
+            }
+        };
+        add({mb.class_name}, CLASS_WEIGHT);
+        add(mb.unity_methods, METHOD_WEIGHT);
+        add(mb.custom_methods, METHOD_WEIGHT);
+        add(mb.serialized_fields, FIELD_WEIGHT);
+        add(mb.attributes, ATTRIBUTE_WEIGHT);
+        add(mb.component_dependencies, DEPENDENCY_WEIGHT);
+    }
+
+    // API usage is reported per file; attribute it to the class when it is known
+    for (const auto& usage : api_usage) {
+        auto class_it = by_class.find(usage.class_name);
+        const std::vector<uint32_t>* targets = nullptr;
+        if (class_it != by_class.end()) {
+            targets = &class_it->second;
+        } else {
+            auto file_it = by_file.find(normalizeSourcePath(usage.file_path));
+            if (file_it != by_file.end()) {
+                targets = &file_it->second;
+            }
+        }
+        if (!targets) {
+            continue;
+        }
+
+        for (const auto& api : usage.detected_apis) {
+            std::vector<std::string> symbol_tokens = tokenize(api.api_name + " " + api.full_call);
+            std::string method = toLower(api.context);
+            bool scoped = !method.empty() &&
+                          std::all_of(method.begin(), method.end(),
+                                      [](unsigned char c) { return std::isalnum(c) || c == '_'; });
+
+            for (uint32_t id : *targets) {
+                for (const auto& token : symbol_tokens) {
+                    term_weights[id][token] += API_WEIGHT;
+                    m_documents[id].length += API_WEIGHT;
+                    if (scoped) {
+                        term_weights[id][scopedTerm(method, token)] += SCOPED_API_WEIGHT;
+                    }
+                }
+            }
+        }
+    }
+
+    for (uint32_t id = 0; id < term_weights.size(); ++id) {
+        for (const auto& term : term_weights[id]) {
+            m_postings[term.first].push_back({id, term.second});
+        }
+    }
+
+    finalize();
+}
+
+void SymbolIndex::writeJSON(Metadata::JSONStreamWriter& writer) const {
+    writer.beginObject();
+    writer.field("format_version", INDEX_FORMAT_VERSION);
+    writer.field("includes_api_usage", m_includes_api_usage);
+
+    writer.key("sources");
+    writeSourceStampsJSON(m_sources, writer);
+
+    writer.key("documents");
+    writer.beginArray();
+    for (const auto& document : m_documents) {
+        writer.beginObject();
+        writer.field("component", document.component);
+        writer.field("file", document.file_path);
+        writer.field("length", document.length);
+        writer.endObject();
+    }
+    writer.endArray();
+
+    // Sorted so an unchanged project produces a byte-identical index
+    std::vector<const std::string*> terms;
+    terms.reserve(m_postings.size());
+    for (const auto& posting_list : m_postings) {
+        terms.push_back(&posting_list.first);
+    }
+    std::sort(terms.begin(), terms.end(), [](const std::string* a, const std::string* b) { return *a < *b; });
+
+    // Each posting list is flattened to [document, weight, document, weight, ...]
+    writer.key("terms");
+    writer.beginObject();
+    for (const std::string* term : terms) {
+        writer.key(*term);
+        writer.beginArray();
+        for (const auto& posting : m_postings.at(*term)) {
+            writer.value(static_cast<size_t>(posting.document));
+            writer.value(posting.weight);
+        }
+        writer.endArray();
+    }
+    writer.endObject();
+
+    writer.endObject();
+}
+
+bool SymbolIndex::load(const std::string& index_path) {
+    try {
+        std::ifstream file(index_path);
+        if (!file.is_open()) {
+            return false;
+        }
+
+        nlohmann::json j = nlohmann::json::parse(file);
+        if (j.value("format_version", 0) != INDEX_FORMAT_VERSION) {
+            return false;
+        }
+
+        SymbolIndex loaded;
+        loaded.m_includes_api_usage = j.value("includes_api_usage", false);
+        loaded.m_sources = readSourceStamps(j.at("sources"));
+
+        for (const auto& document : j.at("documents")) {
+            loaded.m_documents.push_back({document.at("component").get<std::string>(),
+                                          document.value("file", ""),
+                                          document.value("length", 0.0f)});
+        }
+
+        for (const auto& term : j.at("terms").items()) {
+            const auto& flat = term.value();
+            auto& postings = loaded.m_postings[term.key()];
+            postings.reserve(flat.size() / 2);
+            for (size_t i = 0; i + 1 < flat.size(); i += 2) {
+                uint32_t document = flat[i].get<uint32_t>();
+                if (document >= loaded.m_documents.size()) {
+                    std::cerr << "Symbol index references unknown document: " << index_path << std::endl;
+                    return false;
+                }
+                postings.push_back({document, flat[i + 1].get<float>()});
+            }
+        }
+
+        loaded.finalize();
+        *this = std::move(loaded);
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Error reading symbol index: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool SymbolIndex::isFresh(const std::vector<std::string>& source_files) const {
+    return sourcesUnchanged(m_sources, source_files);
+}
+
+std::vector<SymbolMatch> SymbolIndex::search(const std::string& query, size_t max_results) const {
+    std::vector<std::string> tokens;
+    for (auto& token : tokenize(query)) {
+        if (std::find(tokens.begin(), tokens.end(), token) == tokens.end()) {
+            tokens.push_back(std::move(token));
+        }
+    }
+    if (tokens.empty() || m_documents.empty()) {
+        return {};
+    }
+
+    double document_count = static_cast<double>(m_documents.size());
+    std::vector<double> scores(m_documents.size(), 0.0);
+    std::vector<std::vector<std::string>> matched(m_documents.size());
+
+    auto accumulate = [&](const std::string& term, const std::string& label) {
+        auto it = m_postings.find(term);
+        if (it == m_postings.end()) {
+            return;
+        }
+
+        double frequency = static_cast<double>(it->second.size());
+        double idf = std::log(1.0 + (document_count - frequency + 0.5) / (frequency + 0.5));
+        for (const auto& posting : it->second) {
+            double tf = posting.weight;
+            double length_ratio = m_documents[posting.document].length / m_average_length;
+            double norm = BM25_K1 * (1.0 - BM25_B + BM25_B * length_ratio);
+            scores[posting.document] += idf * tf * (BM25_K1 + 1.0) / (tf + norm);
+            matched[posting.document].push_back(label);
+        }
+    };
+
+    for (const auto& token : tokens) {
+        accumulate(token, token);
+    }
+
+    // Any query word may name the method another query word is used in
+    for (const auto& method : tokens) {
+        for (const auto& symbol : tokens) {
+            if (method != symbol) {
+                accumulate(scopedTerm(method, symbol), symbol + " in " + method);
+            }
+        }
+    }
+
+    std::vector<uint32_t> ranked;
+    for (uint32_t id = 0; id < scores.size(); ++id) {
+        if (scores[id] > 0.0) {
+            ranked.push_back(id);
+        }
+    }
+    std::sort(ranked.begin(), ranked.end(), [&](uint32_t a, uint32_t b) {
+        return scores[a] != scores[b] ? scores[a] > scores[b]
+                                      : m_documents[a].component < m_documents[b].component;
+    });
+    if (ranked.size() > max_results) {
+        ranked.resize(max_results);
+    }
+
+    std::vector<SymbolMatch> results;
+    results.reserve(ranked.size());
+    for (uint32_t id : ranked) {
+        results.push_back({m_documents[id].component, m_documents[id].file_path, scores[id], std::move(matched[id])});
+    }
+    return results;
+}
+
+std::vector<std::string> SymbolIndex::tokenize(const std::string& text) {
+    std::vector<std::string> tokens;
+    auto emit = [&tokens](const std::string& token) {
+        if (token.size() >= 2 && STOP_WORDS.count(token) == 0) {
+            tokens.push_back(token);
+        }
+    };
+
+    size_t i = 0;
+    while (i < text.size()) {
+        if (!std::isalnum(static_cast<unsigned char>(text[i])) && text[i] != '_') {
+            ++i;
+            continue;
+        }
+
+        size_t start = i;
+        while (i < text.size() && (std::isalnum(static_cast<unsigned char>(text[i])) || text[i] == '_')) {
+            ++i;
+        }
+        std::string identifier = text.substr(start, i - start);
+
+        // Split on underscores, lower-to-upper and acronym-to-word boundaries, and digits
+        std::vector<std::string> parts;
+        std::string part;
+        for (size_t k = 0; k < identifier.size(); ++k) {
+            unsigned char c = static_cast<unsigned char>(identifier[k]);
+            if (c == '_') {
+                if (!part.empty()) parts.push_back(toLower(part));
+                part.clear();
+                continue;
+            }
+            if (!part.empty()) {
+                unsigned char previous = static_cast<unsigned char>(identifier[k - 1]);
+                bool next_lower = k + 1 < identifier.size() &&
+                                  std::islower(static_cast<unsigned char>(identifier[k + 1]));
+                bool boundary = (std::isupper(c) && (std::islower(previous) || std::isdigit(previous))) ||
+                                (std::isupper(c) && std::isupper(previous) && next_lower) ||
+                                (std::isdigit(c) != 0) != (std::isdigit(previous) != 0);
+                if (boundary) {
+                    parts.push_back(toLower(part));
+                    part.clear();
+                }
+            }
+            part += static_cast<char>(c);
+        }
+        if (!part.empty()) {
+            parts.push_back(toLower(part));
+        }
+
+        emit(toLower(identifier));
+        if (parts.size() > 1) {
+            for (const auto& word : parts) {
+                emit(word);
+            }
+        }
+        // Adjacent pairs let "NavMesh" find NavMeshAgent
+        for (size_t k = 0; parts.size() > 2 && k + 1 < parts.size(); ++k) {
+            emit(parts[k] + parts[k + 1]);
+        }
+    }
+    return tokens;
+}
+
+void SymbolIndex::finalize() {
+    double total_length = 0.0;
+    for (const auto& document : m_documents) {
+        total_length += document.length;
+    }
+    m_average_length = m_documents.empty() || total_length <= 0.0
+        ? 1.0f
+        : static_cast<float>(total_length / m_documents.size());
+}
+
+std::string SymbolIndex::scopedTerm(const std::string& method_token, const std::string& symbol_token) {
+    return method_token + "@" + symbol_token;
+}
+
+} // namespace Context
+} // namespace UnityContextGen
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "../UnityAnalyzer/MonoBehaviourAnalyzer.h"
+#include "../AI/UnityAPIDetector.h"
+#include "../MetadataGenerator/JSONStreamWriter.h"
+#include "SourceStamp.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace UnityContextGen {
+namespace Context {
+
+struct SymbolMatch {
+    std::string component;
+    std::string file_path;
+    double score;
+    std::vector<std::string> matched_terms;
+};
+
+// Inverted index over the symbols each component declares or touches: class,
+// method, serialized field and attribute names, required component types and
+// detected Unity API calls. Search is BM25 over field-weighted term counts.
+// API calls are also indexed together with their containing method, so a
+// query naming both ("Rigidbody in FixedUpdate") ranks co-located use first.
+class SymbolIndex {
+public:
+    SymbolIndex();
+    ~SymbolIndex() = default;
+
+    void build(const std::vector<Unity::MonoBehaviourInfo>& monobehaviours,
+               const std::vector<AI::UnityAPIUsage>& api_usage,
+               const std::vector<std::string>& source_files,
+               bool includes_api_usage);
+
+    void writeJSON(Metadata::JSONStreamWriter& writer) const;
+    bool load(const std::string& index_path);
+
+    bool isFresh(const std::vector<std::string>& source_files) const;
+    bool includesAPIUsage() const { return m_includes_api_usage; }
+
+    std::vector<SymbolMatch> search(const std::string& query, size_t max_results = 10) const;
+
+    size_t size() const { return m_documents.size(); }
+
+    // Lowercased identifiers plus their camelCase/snake_case parts, minus stop words
+    static std::vector<std::string> tokenize(const std::string& text);
+
+private:
+    struct Document {
+        std::string component;
+        std::string file_path;
+        float length;
+    };
+
+    struct Posting {
+        uint32_t document;
+        float weight;
+    };
+
+    std::vector<Document> m_documents;
+    std::unordered_map<std::string, std::vector<Posting>> m_postings;
+    std::vector<SourceStamp> m_sources;
+    float m_average_length;
+    bool m_includes_api_usage;
+
+    void finalize();
+
+    static std::string scopedTerm(const std::string& method_token, const std::string& symbol_token);
+};
+
+} // namespace Context
+} // namespace UnityContextGen
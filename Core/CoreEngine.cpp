@@ -1,18 +1,46 @@
 #include "CoreEngine.h"
 #include "MetadataGenerator/JSONExporter.h"
+#include "MetadataGenerator/ArtifactWriter.h"
+#include "AI/BatchJobJournal.h"
 #include "Configuration/AnalysisConfig.h"
 #include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <chrono>
 #include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <unordered_map>
 
 namespace UnityContextGen {
 
+// Size of the project overview shared by every AI review request
+static const size_t AI_PROJECT_CONTEXT_TOKEN_BUDGET = 4000;
+
 CoreEngine::CoreEngine() : m_verbose(false) {
     // Load configuration
     Config::ConfigurationManager::getInstance().loadConfig();
     
+    const auto& analysis_config = Config::ConfigurationManager::getInstance().getAnalysisOptions();
+    
+    // Shared pool for parallel work such as artifact rendering
+    size_t worker_threads = analysis_config.enable_multithreading
+        ? static_cast<size_t>(std::max(0, analysis_config.max_worker_threads))
+        : 0;
+    m_worker_pool = std::make_unique<WorkerPool>(worker_threads);
+    
+    // Studio-specific pattern rules
+    const auto& rules_file = analysis_config.pattern_rules_file;
+    if (!rules_file.empty() && !m_pattern_detector.loadPatternRules(rules_file)) {
+        logError("Failed to load pattern rules from: " + rules_file);
+    }
+    
+    Context::DataFlowBudget data_flow_budget;
+    data_flow_budget.max_paths = static_cast<size_t>(std::max(1, analysis_config.data_flow_max_paths));
+    data_flow_budget.max_path_length = static_cast<size_t>(std::max(2, analysis_config.data_flow_max_path_length));
+    data_flow_budget.time_budget_ms = analysis_config.data_flow_time_budget_ms;
+    m_context_summarizer.setDataFlowBudget(data_flow_budget);
+    
     // Initialize Claude analyzer if API key is available
     auto& config = Config::ConfigurationManager::getInstance().getAIConfig();
     if (config.enable_ai_analysis && !config.api_key.empty()) {
@@ -35,6 +63,8 @@ AnalysisResult CoreEngine::analyzeProject(const std::vector<std::string>& source
     
     logVerbose("Starting project analysis for " + std::to_string(source_files.size()) + " files");
     
+    AnalysisStageSet stages = planAnalysisStages(options);
+    
     try {
         std::vector<Unity::MonoBehaviourInfo> all_monobehaviours;
         
@@ -46,39 +76,42 @@ AnalysisResult CoreEngine::analyzeProject(const std::vector<std::string>& source
             
             logVerbose("Analyzing file: " + file_path);
             
+            ++m_source_files_parsed;
             if (!m_mb_analyzer.analyzeFile(file_path)) {
                 logError("Failed to analyze file: " + file_path);
                 continue;
             }
             
-            auto file_monobehaviours = m_mb_analyzer.getMonoBehaviours();
+            auto file_monobehaviours = m_mb_analyzer.takeMonoBehaviours();
             all_monobehaviours.insert(all_monobehaviours.end(),
-                                    file_monobehaviours.begin(),
-                                    file_monobehaviours.end());
+                                    std::make_move_iterator(file_monobehaviours.begin()),
+                                    std::make_move_iterator(file_monobehaviours.end()));
         }
         
-        result.monobehaviours = all_monobehaviours;
-        logVerbose("Found " + std::to_string(all_monobehaviours.size()) + " MonoBehaviour components");
+        // Later stages borrow result.monobehaviours instead of holding their own copies
+        result.monobehaviours = std::move(all_monobehaviours);
+        const auto& monobehaviours = result.monobehaviours;
+        logVerbose("Found " + std::to_string(monobehaviours.size()) + " MonoBehaviour components");
         
-        if (options.analyze_dependencies) {
+        if (options.analyze_dependencies && hasStage(stages, AnalysisStage::Dependencies)) {
             logVerbose("Analyzing component dependencies");
-            m_dep_analyzer.analyzeProject(all_monobehaviours);
+            m_dep_analyzer.analyzeProject(monobehaviours);
             result.dependency_graph = m_dep_analyzer.buildDependencyGraph();
         }
         
-        if (options.analyze_lifecycle) {
+        if (options.analyze_lifecycle && hasStage(stages, AnalysisStage::Lifecycle)) {
             logVerbose("Analyzing Unity lifecycle methods");
-            m_lifecycle_analyzer.analyzeProject(all_monobehaviours);
+            m_lifecycle_analyzer.analyzeProject(monobehaviours);
             result.lifecycle_flows = m_lifecycle_analyzer.getAllLifecycleFlows();
         }
         
-        if (options.detect_patterns) {
+        if (options.detect_patterns && hasStage(stages, AnalysisStage::Patterns)) {
             logVerbose("Detecting Unity design patterns");
-            m_pattern_detector.analyzeProject(all_monobehaviours, result.dependency_graph);
-            result.patterns = m_pattern_detector.getDetectedPatterns();
+            m_pattern_detector.analyzeProject(monobehaviours, result.dependency_graph);
+            result.patterns = m_pattern_detector.takeDetectedPatterns();
         }
         
-        if (options.analyze_scriptable_objects) {
+        if (options.analyze_scriptable_objects && hasStage(stages, AnalysisStage::ScriptableObjects)) {
             logVerbose("Analyzing ScriptableObjects");
             m_scriptable_object_analyzer.analyzeProject(source_files);
             result.scriptable_objects = m_scriptable_object_analyzer.getScriptableObjects();
@@ -86,21 +119,60 @@ AnalysisResult CoreEngine::analyzeProject(const std::vector<std::string>& source
         }
         
         // AI-powered Unity API analysis
-        logVerbose("Detecting Unity API usage");
-        m_api_detector.setVerbose(m_verbose);
-        result.api_usage = m_api_detector.analyzeProject(source_files);
+        if (hasStage(stages, AnalysisStage::APIUsage)) {
+            logVerbose("Detecting Unity API usage");
+            m_api_detector.setVerbose(m_verbose);
+            result.api_usage = m_api_detector.analyzeProject(source_files);
+        }
+        
+        if (options.generate_metadata && hasStage(stages, AnalysisStage::Metadata)) {
+            logVerbose("Generating project metadata");
+            m_metadata_generator.analyzeProject(monobehaviours,
+                                              result.dependency_graph,
+                                              result.lifecycle_flows,
+                                              result.patterns,
+                                              source_files);
+            result.project_metadata = m_metadata_generator.getProjectMetadata();
+        }
+        
+        if (options.generate_context && hasStage(stages, AnalysisStage::Context)) {
+            logVerbose("Generating project context summary");
+            result.project_context = m_context_summarizer.generateProjectContext(result.project_metadata);
+        }
         
         // Claude AI analysis (if available and enabled)
-        if (m_claude_analyzer && Config::ConfigurationManager::getInstance().getAIConfig().enable_ai_analysis) {
+        if (m_claude_analyzer && hasStage(stages, AnalysisStage::AIAnalysis) &&
+            Config::ConfigurationManager::getInstance().getAIConfig().enable_ai_analysis) {
             logVerbose("Running AI-powered code analysis");
             
+            std::unordered_map<std::string, const Unity::MonoBehaviourInfo*> components_by_file;
+            for (const auto& mb : monobehaviours) {
+                components_by_file.emplace(mb.file_path, &mb);
+            }
+            
+            // Every review shares this cache-marked prefix. The API only caches prefixes of at least
+            // 1024 tokens (2048 on Haiku models); a shorter one is simply sent uncached
+            std::string project_context = "Unity game development project";
+            if (options.generate_context && hasStage(stages, AnalysisStage::Context)) {
+                project_context = m_context_summarizer.generateReviewContextPrompt(result.project_context, result.project_metadata,
+                                                                                   AI_PROJECT_CONTEXT_TOKEN_BUDGET);
+            }
+            
+            std::vector<AI::AIAnalysisRequest> requests;
             for (const auto& usage : result.api_usage) {
                 if (!usage.detected_apis.empty()) {
                     AI::AIAnalysisRequest request;
                     request.component_name = usage.class_name;
                     request.file_path = usage.file_path;
                     request.analysis_type = "code_review";
-                    request.project_context = "Unity game development project";
+                    request.project_context = project_context;
+                    
+                    // Hand over what earlier stages found so the analyzer does not rescan
+                    request.api_usage = &usage;
+                    auto component = components_by_file.find(usage.file_path);
+                    if (component != components_by_file.end()) {
+                        request.component = component->second;
+                    }
                     
                     // Read file content for Claude analysis
                     std::ifstream file(usage.file_path);
@@ -109,31 +181,79 @@ AnalysisResult CoreEngine::analyzeProject(const std::vector<std::string>& source
                         buffer << file.rdbuf();
                         request.code_content = buffer.str();
                         file.close();
-                        
-                        // Get AI analysis
-                        auto ai_result = m_claude_analyzer->analyzeCode(request);
-                        if (ai_result.success) {
-                            result.ai_analysis_results.push_back(ai_result);
-                            logVerbose("AI analysis completed for " + usage.class_name);
-                        }
+                        requests.push_back(std::move(request));
                     }
                 }
             }
-        }
-        
-        if (options.generate_metadata) {
-            logVerbose("Generating project metadata");
-            m_metadata_generator.analyzeProject(all_monobehaviours,
-                                              result.dependency_graph,
-                                              result.lifecycle_flows,
-                                              result.patterns,
-                                              source_files);
-            result.project_metadata = m_metadata_generator.getProjectMetadata();
-        }
-        
-        if (options.generate_context) {
-            logVerbose("Generating project context summary");
-            result.project_context = m_context_summarizer.generateProjectContext(result.project_metadata);
+            
+            // Riskiest files first, so a review budget is spent where it matters most
+            auto ranking = AI::ReviewTriage().rank(requests, &result.dependency_graph);
+            std::vector<AI::AIAnalysisRequest> ranked_requests;
+            ranked_requests.reserve(requests.size());
+            for (auto& entry : ranking) {
+                ranked_requests.push_back(std::move(requests[entry.request_index]));
+                entry.request_index = ranked_requests.size() - 1;
+            }
+            requests = std::move(ranked_requests);
+            
+            std::string cache_path = acquireResponseCache(options);
+            const auto& ai_config = Config::ConfigurationManager::getInstance().getAIConfig();
+            
+            auto log_result = [this, &requests](size_t index, const AI::AIAnalysisResult& ai_result) {
+                if (ai_result.success) {
+                    logVerbose("AI analysis completed for " + requests[index].component_name);
+                } else if (ai_result.skipped) {
+                    logVerbose("AI analysis skipped for " + requests[index].component_name + ": " + ai_result.error_message);
+                } else {
+                    logVerbose("AI analysis failed for " + requests[index].component_name + ": " + ai_result.error_message);
+                }
+            };
+            
+            // Reviews run concurrently, or as an offline batch job; results are kept in triage order
+            std::vector<AI::AIAnalysisResult> ai_results;
+            std::string journal_path;
+            if (ai_config.enable_batch_jobs) {
+                journal_path = ai_config.batch_journal_path.empty()
+                    ? createOutputFileName("ai_batch_journal", "json", options)
+                    : ai_config.batch_journal_path;
+                std::error_code journal_ec;
+                std::filesystem::create_directories(std::filesystem::path(journal_path).parent_path(), journal_ec);
+                ai_results = m_claude_analyzer->analyzeBatchJob(requests, journal_path, log_result);
+            } else {
+                ai_results = m_claude_analyzer->analyzeBatch(requests, log_result);
+            }
+            
+            result.ai_triage_report = AI::ReviewTriage::createReport(ranking, ai_results, ai_config);
+            auto& triage_report = result.ai_triage_report;
+            logVerbose("AI triage: " + triage_report["reviewed"].dump() + " reviewed, " +
+                       triage_report["skipped"].dump() + " skipped, " + triage_report["failed"].dump() + " failed");
+            auto connections = AI::HTTPClient::connectionStats();
+            logVerbose("AI connections this process: " + std::to_string(connections.new_connections) + " opened (" +
+                       std::to_string(connections.tls_handshakes) + " TLS handshakes), " +
+                       std::to_string(connections.reused_connections) + " requests on reused connections, " +
+                       std::to_string(connections.http2_transfers) + " over HTTP/2");
+            
+            for (auto& ai_result : ai_results) {
+                if (ai_result.success) {
+                    result.ai_analysis_results.push_back(std::move(ai_result));
+                }
+            }
+            
+            // Batch job replies leave the journal only once they are safely in the saved response cache
+            bool results_persisted = true;
+            if (m_ai_response_cache) {
+                auto cache_stats = m_ai_response_cache->getStats();
+                logVerbose("AI response cache: " + std::to_string(cache_stats.hits) + " hits, " +
+                           std::to_string(cache_stats.misses) + " misses, " +
+                           std::to_string(cache_stats.evictions) + " evictions");
+                if (!m_ai_response_cache->save(cache_path)) {
+                    logError("Failed to save AI response cache: " + cache_path);
+                    results_persisted = false;
+                }
+            }
+            if (!journal_path.empty() && results_persisted) {
+                AI::BatchJobJournal::release(journal_path);
+            }
         }
         
         result.success = true;
@@ -182,52 +302,159 @@ bool CoreEngine::exportResults(const AnalysisResult& result, const AnalysisOptio
         return false;
     }
     
+    struct ArtifactJob {
+        std::string file_path;
+        std::string description;
+        std::function<void(std::ostream&)> render;
+        std::function<bool()> on_written = nullptr; // Runs only once the artifact is safely on disk
+    };
+    
+    OutputArtifactSet artifacts = artifactsForFormat(options.output_format);
+    bool pretty_json = !options.compact_json;
+    Metadata::JSONExporter exporter;
+    Metadata::ShardedExporter shard_exporter;
+    shard_exporter.setGranularity(options.shard_granularity);
+    std::vector<ArtifactJob> jobs;
+    
+    if (hasArtifact(artifacts, OutputArtifact::ProjectMetadata) && options.sharded_export) {
+        std::string manifest_path = (std::filesystem::path(options.output_directory) /
+                                     Metadata::ShardedExporter::MANIFEST_FILE_NAME).string();
+        jobs.push_back({manifest_path, "metadata shards",
+                        [&](std::ostream& out) {
+                            Metadata::ShardManifest manifest;
+                            if (!shard_exporter.writeShards(result.project_metadata, options.output_directory, manifest)) {
+                                throw std::runtime_error("could not write shard files");
+                            }
+                            Metadata::JSONStreamWriter writer(out, pretty_json);
+                            shard_exporter.writeManifestJSON(result.project_metadata, manifest, writer);
+                        }});
+    } else if (hasArtifact(artifacts, OutputArtifact::ProjectMetadata)) {
+        jobs.push_back({createOutputFileName("project_metadata", "json", options), "project metadata",
+                        [&](std::ostream& out) {
+                            Metadata::JSONStreamWriter writer(out, pretty_json);
+                            exporter.writeClaudeCodeOptimizedJSON(result.project_metadata, writer);
+                        }});
+    }
+    
+    if (hasArtifact(artifacts, OutputArtifact::ProjectMetadata)) {
+        jobs.push_back({createOutputFileName("component_index", "json", options), "component index",
+                        [&](std::ostream& out) {
+                            auto index = std::make_shared<Context::ComponentIndex>();
+                            index->build(result.project_metadata, result.project_metadata.files_analyzed);
+                            Metadata::JSONStreamWriter writer(out, false);
+                            index->writeJSON(writer);
+                            
+                            std::lock_guard<std::mutex> lock(m_index_mutex);
+                            m_component_index = index;
+                        }});
+    }
+    
+    if (hasArtifact(artifacts, OutputArtifact::ProjectMetadata)) {
+        // Mirrors planAnalysisStages: API detection only runs when every artifact is requested
+        bool includes_api_usage = options.output_format == OutputFormat::All ||
+                                  hasStage(stagesForArtifacts(artifacts), AnalysisStage::APIUsage);
+        jobs.push_back({createOutputFileName("symbol_index", "json", options), "symbol index",
+                        [&, includes_api_usage](std::ostream& out) {
+                            auto index = std::make_shared<Context::SymbolIndex>();
+                            index->build(result.monobehaviours, result.api_usage,
+                                         result.project_metadata.files_analyzed, includes_api_usage);
+                            Metadata::JSONStreamWriter writer(out, false);
+                            index->writeJSON(writer);
+                            
+                            std::lock_guard<std::mutex> lock(m_index_mutex);
+                            m_symbol_index = index;
+                        }});
+    }
+    
+    if (hasArtifact(artifacts, OutputArtifact::ProjectMetadata) && options.delta_export) {
+        bool include_context = hasArtifact(artifacts, OutputArtifact::ProjectContext);
+        auto snapshot = std::make_shared<std::string>();
+        // The snapshot is the next run's baseline, so it is only replaced after the delta against it is written
+        jobs.push_back({createOutputFileName("project_delta", "json", options), "project delta",
+                        [&, include_context, snapshot](std::ostream& out) {
+                            writeProjectDelta(result, options, include_context, out, *snapshot);
+                        },
+                        [&, snapshot]() {
+                            return writeArtifact(createOutputFileName("project_snapshot", "json", options),
+                                                 [&snapshot](std::ostream& out) { out << *snapshot; });
+                        }});
+    }
+    
+    if (hasArtifact(artifacts, OutputArtifact::ProjectContext)) {
+        jobs.push_back({createOutputFileName("project_context", "json", options), "project context",
+                        [&](std::ostream& out) {
+                            Metadata::JSONStreamWriter writer(out, pretty_json);
+                            m_context_summarizer.writeContextJSON(result.project_context, writer);
+                        }});
+    }
+    
+    if (hasArtifact(artifacts, OutputArtifact::LLMOptimized)) {
+        jobs.push_back({createOutputFileName("llm_optimized", "json", options), "LLM-optimized data",
+                        [&](std::ostream& out) {
+                            Metadata::JSONStreamWriter writer(out, pretty_json);
+                            m_context_summarizer.writeLLMOptimizedJSON(result.project_context, writer);
+                        }});
+    }
+    
+    if (hasArtifact(artifacts, OutputArtifact::Summary)) {
+        jobs.push_back({createOutputFileName("summary", "md", options), "summary",
+                        [&](std::ostream& out) { out << generateQuickSummary(result); }});
+    }
+    
+    if (hasArtifact(artifacts, OutputArtifact::DetailedReport)) {
+        jobs.push_back({createOutputFileName("detailed_report", "md", options), "detailed report",
+                        [&](std::ostream& out) { out << generateDetailedReport(result); }});
+    }
+    
+    if (hasArtifact(artifacts, OutputArtifact::LLMPrompt)) {
+        jobs.push_back({createOutputFileName("llm_prompt", "md", options), "LLM prompt",
+                        [&](std::ostream& out) {
+                            Context::PackingReport report;
+                            out << generateLLMPrompt(result, options.context_token_budget, &report);
+                            if (!report.dropped.empty()) {
+                                logVerbose("LLM prompt budget of " + std::to_string(report.token_budget) +
+                                           " tokens dropped " + std::to_string(report.dropped.size()) +
+                                           " sections (~" + std::to_string(report.dropped_tokens) + " tokens)");
+                            }
+                        }});
+    }
+    
+    if (hasArtifact(artifacts, OutputArtifact::AITriage) && !result.ai_triage_report.is_null()) {
+        jobs.push_back({createOutputFileName("ai_triage", "json", options), "AI review triage",
+                        [&](std::ostream& out) { out << result.ai_triage_report.dump(pretty_json ? 2 : -1) << '\n'; }});
+    }
+    
     try {
         std::filesystem::create_directories(options.output_directory);
-        
-        Metadata::JSONExporter exporter;
-        
-        std::string project_file = createOutputFileName("project_metadata", "json", options);
-        if (exporter.exportProjectMetadata(result.project_metadata, project_file)) {
-            logVerbose("Exported project metadata to: " + project_file);
-        }
-        
-        std::string context_file = createOutputFileName("project_context", "json", options);
-        auto context_json = m_context_summarizer.exportContextToJSON(result.project_context);
-        if (exporter.writeToFile(context_json, context_file)) {
-            logVerbose("Exported project context to: " + context_file);
-        }
-        
-        std::string llm_file = createOutputFileName("llm_optimized", "json", options);
-        auto llm_json = m_context_summarizer.exportLLMOptimizedJSON(result.project_context);
-        if (exporter.writeToFile(llm_json, llm_file)) {
-            logVerbose("Exported LLM-optimized data to: " + llm_file);
-        }
-        
-        std::string summary_file = createOutputFileName("summary", "md", options);
-        std::string summary_content = generateQuickSummary(result);
-        if (writeToFile(summary_content, summary_file)) {
-            logVerbose("Exported summary to: " + summary_file);
-        }
-        
-        std::string report_file = createOutputFileName("detailed_report", "md", options);
-        std::string report_content = generateDetailedReport(result);
-        if (writeToFile(report_content, report_file)) {
-            logVerbose("Exported detailed report to: " + report_file);
-        }
-        
-        std::string prompt_file = createOutputFileName("llm_prompt", "md", options);
-        std::string prompt_content = generateLLMPrompt(result);
-        if (writeToFile(prompt_content, prompt_file)) {
-            logVerbose("Exported LLM prompt to: " + prompt_file);
-        }
-        
-        return true;
-        
     } catch (const std::exception& e) {
         logError("Failed to export results: " + std::string(e.what()));
         return false;
     }
+    
+    // Renderers only read the result, so they run side by side on the shared pool
+    std::vector<std::future<bool>> pending;
+    pending.reserve(jobs.size());
+    for (const auto& job : jobs) {
+        pending.push_back(m_worker_pool->submit([this, &job]() {
+            return writeArtifact(job.file_path, job.render) && (!job.on_written || job.on_written());
+        }));
+    }
+    
+    bool all_written = true;
+    for (size_t i = 0; i < pending.size(); ++i) {
+        try {
+            if (pending[i].get()) {
+                logVerbose("Exported " + jobs[i].description + " to: " + jobs[i].file_path);
+            } else {
+                all_written = false;
+            }
+        } catch (const std::exception& e) {
+            logError("Failed to export " + jobs[i].description + ": " + std::string(e.what()));
+            all_written = false;
+        }
+    }
+    
+    return all_written;
 }
 
 std::string CoreEngine::generateLLMPrompt(const AnalysisResult& result) const {
@@ -235,7 +462,69 @@ std::string CoreEngine::generateLLMPrompt(const AnalysisResult& result) const {
         return "Analysis failed: " + result.error_message;
     }
     
-    return m_context_summarizer.generateLLMContextPrompt(result.project_context);
+    return generateLLMPrompt(result, 0);
+}
+
+std::string CoreEngine::generateLLMPrompt(const AnalysisResult& result, size_t token_budget,
+                                          Context::PackingReport* report) const {
+    if (!result.success) {
+        return "Analysis failed: " + result.error_message;
+    }
+    
+    if (token_budget == 0) {
+        int configured = Config::ConfigurationManager::getInstance().getAIConfig().max_context_length;
+        token_budget = configured > 0 ? static_cast<size_t>(configured) : 0;
+    }
+    
+    return m_context_summarizer.generateLLMContextPrompt(result.project_context, result.project_metadata,
+                                                         token_budget, report);
+}
+
+Context::FocusedContext CoreEngine::generateFocusedContext(const std::vector<std::string>& source_files,
+                                                           const std::string& target, int hops,
+                                                           const AnalysisOptions& options) const {
+    auto index = acquireComponentIndex(source_files, options);
+    if (!index) {
+        return Context::FocusedContext();
+    }
+    
+    Context::FocusedContext focused = index->query(target, hops);
+    if (!focused.found) {
+        logError("Component not found in index: " + target);
+    }
+    return focused;
+}
+
+Context::FocusedContext CoreEngine::generateFocusedContextForDirectory(const std::string& directory_path,
+                                                                       const std::string& target, int hops,
+                                                                       const AnalysisOptions& options) const {
+    auto source_files = findCSharpFiles(directory_path);
+    if (source_files.empty()) {
+        logError("No C# files found in directory: " + directory_path);
+        return Context::FocusedContext();
+    }
+    return generateFocusedContext(source_files, target, hops, options);
+}
+
+std::vector<Context::SymbolMatch> CoreEngine::searchSymbols(const std::vector<std::string>& source_files,
+                                                            const std::string& query, size_t max_results,
+                                                            const AnalysisOptions& options) const {
+    auto index = acquireSymbolIndex(source_files, options);
+    if (!index) {
+        return {};
+    }
+    return index->search(query, max_results);
+}
+
+std::vector<Context::SymbolMatch> CoreEngine::searchSymbolsInDirectory(const std::string& directory_path,
+                                                                       const std::string& query, size_t max_results,
+                                                                       const AnalysisOptions& options) const {
+    auto source_files = findCSharpFiles(directory_path);
+    if (source_files.empty()) {
+        logError("No C# files found in directory: " + directory_path);
+        return {};
+    }
+    return searchSymbols(source_files, query, max_results, options);
 }
 
 std::string CoreEngine::generateQuickSummary(const AnalysisResult& result) const {
@@ -380,6 +669,19 @@ std::string CoreEngine::generateDetailedReport(const AnalysisResult& result) con
     return report.str();
 }
 
+AnalysisStageSet CoreEngine::planAnalysisStages(const AnalysisOptions& options) const {
+    // With every artifact requested the full result is kept for in-memory consumers too
+    if (options.output_format == OutputFormat::All) {
+        return ALL_ANALYSIS_STAGES;
+    }
+    
+    AnalysisStageSet stages = stagesForArtifacts(artifactsForFormat(options.output_format));
+    if (stages != ALL_ANALYSIS_STAGES) {
+        logVerbose("Requested outputs skip some analysis stages (stage mask " + std::to_string(stages) + ")");
+    }
+    return stages;
+}
+
 std::vector<std::string> CoreEngine::findCSharpFiles(const std::string& directory_path) const {
     std::vector<std::string> cs_files;
     
@@ -421,21 +723,175 @@ std::string CoreEngine::createOutputFileName(const std::string& base_name,
 }
 
 bool CoreEngine::writeToFile(const std::string& content, const std::string& file_path) const {
-    try {
-        std::ofstream file(file_path);
-        if (!file.is_open()) {
-            logError("Failed to open file for writing: " + file_path);
+    return writeArtifact(file_path, [&content](std::ostream& out) { out << content; });
+}
+
+bool CoreEngine::writeArtifact(const std::string& file_path,
+                               const std::function<void(std::ostream&)>& render) const {
+    std::string error;
+    switch (Metadata::writeArtifactIfChanged(file_path, render, error)) {
+        case Metadata::ArtifactWriteStatus::Written:
+            return true;
+        case Metadata::ArtifactWriteStatus::Unchanged:
+            logVerbose("Unchanged, skipped rewrite: " + file_path);
+            return true;
+        case Metadata::ArtifactWriteStatus::Failed:
+        default:
+            logError(error);
             return false;
+    }
+}
+
+void CoreEngine::writeProjectDelta(const AnalysisResult& result, const AnalysisOptions& options,
+                                   bool include_context, std::ostream& out, std::string& snapshot_text) const {
+    Metadata::DeltaExporter delta_exporter;
+    nlohmann::json snapshot = delta_exporter.createSnapshot(result.project_metadata);
+    if (include_context) {
+        snapshot["context"] = m_context_summarizer.exportContextToJSON(result.project_context);
+    }
+    Metadata::DeltaExporter::sealSnapshot(snapshot);
+    
+    // Without a readable previous snapshot the delta adds everything
+    std::string snapshot_path = createOutputFileName("project_snapshot", "json", options);
+    nlohmann::json previous = nlohmann::json::object();
+    {
+        std::ifstream previous_file(snapshot_path);
+        if (previous_file.is_open()) {
+            try {
+                previous = nlohmann::json::parse(previous_file);
+            } catch (const std::exception& e) {
+                logVerbose("Ignoring unreadable snapshot " + snapshot_path + ": " + std::string(e.what()));
+            }
+        }
+    }
+    
+    nlohmann::json patch = Metadata::DeltaExporter::createPatch(previous, snapshot);
+    auto changes = Metadata::DeltaExporter::summarizeChanges(previous, snapshot, patch);
+    logVerbose("Delta: " + std::to_string(changes.operation_count) + " operations, " +
+               std::to_string(changes.added_components.size()) + " added, " +
+               std::to_string(changes.removed_components.size()) + " removed, " +
+               std::to_string(changes.modified_components.size()) + " modified components");
+    
+    int indent = options.compact_json ? -1 : 2;
+    out << patch.dump(indent) << '\n';
+    snapshot_text = snapshot.dump(indent) + '\n';
+}
+
+std::shared_ptr<const Context::ComponentIndex> CoreEngine::acquireComponentIndex(const std::vector<std::string>& source_files,
+                                                                                const AnalysisOptions& options) const {
+    {
+        std::lock_guard<std::mutex> lock(m_index_mutex);
+        if (m_component_index && m_component_index->isFresh(source_files)) {
+            logVerbose("Using in-memory component index");
+            return m_component_index;
         }
+    }
+    
+    std::string index_path = createOutputFileName("component_index", "json", options);
+    auto index = std::make_shared<Context::ComponentIndex>();
+    if (index->load(index_path) && index->isFresh(source_files)) {
+        logVerbose("Loaded component index: " + index_path);
+    } else {
+        // Only the metadata stage and its prerequisites are needed to rebuild
+        logVerbose("Component index missing or stale, analyzing " + std::to_string(source_files.size()) + " files");
+        AnalysisOptions index_options = options;
+        index_options.output_format = OutputFormat::JSON;
+        index_options.generate_context = false;
+        index_options.export_json = false;
         
-        file << content;
-        file.close();
+        AnalysisResult result = analyzeProject(source_files, index_options);
+        if (!result.success) {
+            return nullptr;
+        }
+        index->build(result.project_metadata, source_files);
         
-        return true;
-    } catch (const std::exception& e) {
-        logError("Error writing to file " + file_path + ": " + std::string(e.what()));
-        return false;
+        std::error_code ec;
+        std::filesystem::create_directories(options.output_directory, ec);
+        writeArtifact(index_path, [&index](std::ostream& out) {
+            Metadata::JSONStreamWriter writer(out, false);
+            index->writeJSON(writer);
+        });
     }
+    
+    std::lock_guard<std::mutex> lock(m_index_mutex);
+    m_component_index = index;
+    return index;
+}
+
+std::shared_ptr<const Context::SymbolIndex> CoreEngine::acquireSymbolIndex(const std::vector<std::string>& source_files,
+                                                                          const AnalysisOptions& options) const {
+    {
+        std::lock_guard<std::mutex> lock(m_index_mutex);
+        if (m_symbol_index && m_symbol_index->includesAPIUsage() && m_symbol_index->isFresh(source_files)) {
+            logVerbose("Using in-memory symbol index");
+            return m_symbol_index;
+        }
+    }
+    
+    std::string index_path = createOutputFileName("symbol_index", "json", options);
+    auto index = std::make_shared<Context::SymbolIndex>();
+    if (index->load(index_path) && index->includesAPIUsage() && index->isFresh(source_files)) {
+        logVerbose("Loaded symbol index: " + index_path);
+    } else {
+        // Symbols only need MonoBehaviour extraction and API detection, never the AI stage
+        logVerbose("Symbol index missing or stale, parsing " + std::to_string(source_files.size()) + " files");
+        AnalysisOptions index_options = options;
+        index_options.output_format = OutputFormat::JSON;
+        index_options.analyze_dependencies = false;
+        index_options.analyze_lifecycle = false;
+        index_options.detect_patterns = false;
+        index_options.generate_metadata = false;
+        index_options.generate_context = false;
+        index_options.export_json = false;
+        
+        AnalysisResult result = analyzeProject(source_files, index_options);
+        if (!result.success) {
+            return nullptr;
+        }
+        m_api_detector.setVerbose(m_verbose);
+        auto api_usage = m_api_detector.analyzeProject(source_files);
+        index->build(result.monobehaviours, api_usage, source_files, true);
+        
+        std::error_code ec;
+        std::filesystem::create_directories(options.output_directory, ec);
+        writeArtifact(index_path, [&index](std::ostream& out) {
+            Metadata::JSONStreamWriter writer(out, false);
+            index->writeJSON(writer);
+        });
+    }
+    
+    std::lock_guard<std::mutex> lock(m_index_mutex);
+    m_symbol_index = index;
+    return index;
+}
+
+std::string CoreEngine::acquireResponseCache(const AnalysisOptions& options) const {
+    const auto& ai_config = Config::ConfigurationManager::getInstance().getAIConfig();
+    if (!ai_config.enable_response_cache) {
+        m_ai_response_cache.reset();
+        m_claude_analyzer->setResponseCache(nullptr);
+        return "";
+    }
+    
+    std::string cache_path = ai_config.response_cache_path.empty()
+        ? createOutputFileName("ai_response_cache", "json", options)
+        : ai_config.response_cache_path;
+    
+    if (!m_ai_response_cache || m_ai_response_cache_path != cache_path) {
+        size_t max_bytes = static_cast<size_t>(std::max(1, ai_config.response_cache_max_mb)) * 1024 * 1024;
+        m_ai_response_cache = std::make_shared<AI::AIResponseCache>(max_bytes);
+        m_ai_response_cache_path = cache_path;
+        if (m_ai_response_cache->load(cache_path)) {
+            logVerbose("Loaded AI response cache: " + cache_path + " (" +
+                       std::to_string(m_ai_response_cache->getStats().entries) + " entries)");
+        }
+        
+        std::error_code ec;
+        std::filesystem::create_directories(std::filesystem::path(cache_path).parent_path(), ec);
+    }
+    
+    m_claude_analyzer->setResponseCache(m_ai_response_cache);
+    return cache_path;
 }
 
 double CoreEngine::getCurrentTimeMs() const {
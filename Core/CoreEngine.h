@@ -7,13 +7,25 @@
 #include "UnityAnalyzer/UnityPatternDetector.h"
 #include "UnityAnalyzer/ScriptableObjectAnalyzer.h"
 #include "MetadataGenerator/ProjectMetadata.h"
+#include "MetadataGenerator/ShardedExporter.h"
+#include "MetadataGenerator/DeltaExporter.h"
 #include "ContextSummarizer/ProjectSummarizer.h"
+#include "ContextSummarizer/ComponentIndex.h"
+#include "ContextSummarizer/SymbolIndex.h"
 #include "AI/ClaudeAnalyzer.h"
+#include "AI/AIResponseCache.h"
+#include "AI/ReviewTriage.h"
 #include "AI/UnityAPIDetector.h"
 #include "Configuration/AnalysisConfig.h"
+#include "OutputPlan.h"
+#include "WorkerPool.h"
+#include <atomic>
+#include <functional>
+#include <ostream>
 #include <string>
 #include <vector>
 #include <memory>
+#include <mutex>
 
 namespace UnityContextGen {
 
@@ -31,7 +43,13 @@ struct AnalysisOptions {
     bool analyze_addressables = false;
     
     std::string output_directory = "./output";
+    OutputFormat output_format = OutputFormat::All; // Stages no requested artifact needs are skipped
     bool verbose_output = false;
+    bool compact_json = false;
+    bool sharded_export = false; // Replaces project_metadata.json with shards plus a manifest
+    Metadata::ShardGranularity shard_granularity = Metadata::ShardGranularity::SystemGroup;
+    bool delta_export = false; // Also writes a JSON Patch against the previous run's snapshot
+    size_t context_token_budget = 0; // LLM prompt budget; 0 uses the configured max_context_length
 };
 
 struct AnalysisResult {
@@ -50,6 +68,7 @@ struct AnalysisResult {
     // AI analysis results
     std::vector<AI::UnityAPIUsage> api_usage;
     std::vector<AI::AIAnalysisResult> ai_analysis_results;
+    nlohmann::json ai_triage_report; // Null unless the AI stage ran
     
     Metadata::ProjectMetadata project_metadata;
     Context::ProjectContext project_context;
@@ -76,11 +95,32 @@ public:
                       const AnalysisOptions& options) const;
     
     std::string generateLLMPrompt(const AnalysisResult& result) const;
+    std::string generateLLMPrompt(const AnalysisResult& result, size_t token_budget,
+                                  Context::PackingReport* report = nullptr) const;
+    // Component plus its k-hop dependency neighbourhood, served from component_index.json
+    // in the output directory (or memory) and only reanalyzing when sources changed
+    Context::FocusedContext generateFocusedContext(const std::vector<std::string>& source_files,
+                                                   const std::string& target, int hops,
+                                                   const AnalysisOptions& options = AnalysisOptions()) const;
+    Context::FocusedContext generateFocusedContextForDirectory(const std::string& directory_path,
+                                                               const std::string& target, int hops,
+                                                               const AnalysisOptions& options = AnalysisOptions()) const;
+    // Ranked symbol lookup ("Rigidbody in FixedUpdate"), served from symbol_index.json
+    // in the output directory (or memory) and only reparsing when sources changed
+    std::vector<Context::SymbolMatch> searchSymbols(const std::vector<std::string>& source_files,
+                                                    const std::string& query, size_t max_results = 10,
+                                                    const AnalysisOptions& options = AnalysisOptions()) const;
+    std::vector<Context::SymbolMatch> searchSymbolsInDirectory(const std::string& directory_path,
+                                                               const std::string& query, size_t max_results = 10,
+                                                               const AnalysisOptions& options = AnalysisOptions()) const;
     std::string generateQuickSummary(const AnalysisResult& result) const;
     std::string generateDetailedReport(const AnalysisResult& result) const;
     
     void setVerbose(bool verbose) { m_verbose = verbose; }
     bool getVerbose() const { return m_verbose; }
+    
+    // Source files parsed so far; exports and index lookups served from memory leave it unchanged
+    size_t getSourceFilesParsed() const { return m_source_files_parsed; }
 
 private:
     bool m_verbose;
@@ -95,6 +135,15 @@ private:
     mutable Context::ProjectSummarizer m_context_summarizer;
     mutable AI::UnityAPIDetector m_api_detector;
     mutable std::unique_ptr<AI::ClaudeAnalyzer> m_claude_analyzer;
+    std::unique_ptr<WorkerPool> m_worker_pool;
+    mutable std::mutex m_index_mutex;
+    mutable std::shared_ptr<const Context::ComponentIndex> m_component_index;
+    mutable std::shared_ptr<const Context::SymbolIndex> m_symbol_index;
+    mutable std::shared_ptr<AI::AIResponseCache> m_ai_response_cache;
+    mutable std::string m_ai_response_cache_path;
+    mutable std::atomic<size_t> m_source_files_parsed{0};
+    
+    AnalysisStageSet planAnalysisStages(const AnalysisOptions& options) const;
     
     std::vector<std::string> findCSharpFiles(const std::string& directory_path) const;
     bool isValidCSharpFile(const std::string& file_path) const;
@@ -109,6 +158,24 @@ private:
     bool writeToFile(const std::string& content, 
                     const std::string& file_path) const;
     
+    // Renders the patch to out and the new snapshot to snapshot_text; the caller
+    // commits the snapshot only after the patch is written
+    void writeProjectDelta(const AnalysisResult& result, const AnalysisOptions& options,
+                           bool include_context, std::ostream& out, std::string& snapshot_text) const;
+    
+    // Single buffered write path shared by every exported artifact
+    bool writeArtifact(const std::string& file_path,
+                       const std::function<void(std::ostream&)>& render) const;
+    
+    std::shared_ptr<const Context::ComponentIndex> acquireComponentIndex(const std::vector<std::string>& source_files,
+                                                                        const AnalysisOptions& options) const;
+    std::shared_ptr<const Context::SymbolIndex> acquireSymbolIndex(const std::vector<std::string>& source_files,
+                                                                  const AnalysisOptions& options) const;
+    
+    // Loads the persistent AI response cache for this output location and
+    // attaches it to the analyzer; returns the path it is saved back to
+    std::string acquireResponseCache(const AnalysisOptions& options) const;
+    
     double getCurrentTimeMs() const;
 };
 
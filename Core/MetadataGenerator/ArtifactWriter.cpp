@@ -0,0 +1,151 @@
+#include "ArtifactWriter.h"
+#include "ContentHash.h"
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <streambuf>
+#include <vector>
+
+namespace UnityContextGen {
+namespace Metadata {
+
+static const size_t ARTIFACT_BUFFER_SIZE = 64 * 1024;
+
+namespace {
+
+// Forwards writes to the target buffer while hashing them on the way through
+class HashingStreamBuf : public std::streambuf {
+public:
+    explicit HashingStreamBuf(std::streambuf* target)
+        : m_target(target), m_hash(FNV1A_OFFSET_BASIS), m_size(0) {}
+
+    uint64_t hash() const { return m_hash; }
+    uintmax_t size() const { return m_size; }
+
+protected:
+    int_type overflow(int_type ch) override {
+        if (traits_type::eq_int_type(ch, traits_type::eof())) {
+            return traits_type::not_eof(ch);
+        }
+        char c = traits_type::to_char_type(ch);
+        return xsputn(&c, 1) == 1 ? ch : traits_type::eof();
+    }
+
+    std::streamsize xsputn(const char* data, std::streamsize count) override {
+        std::streamsize written = m_target->sputn(data, count);
+        if (written > 0) {
+            m_hash = hashContent(std::string_view(data, static_cast<size_t>(written)), m_hash);
+            m_size += static_cast<uintmax_t>(written);
+        }
+        return written;
+    }
+
+    int sync() override {
+        return m_target->pubsync();
+    }
+
+private:
+    std::streambuf* m_target;
+    uint64_t m_hash;
+    uintmax_t m_size;
+};
+
+bool hashExistingFile(const std::filesystem::path& path, uint64_t& hash) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::vector<char> chunk(ARTIFACT_BUFFER_SIZE);
+    hash = FNV1A_OFFSET_BASIS;
+    while (file) {
+        file.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        std::streamsize count = file.gcount();
+        if (count > 0) {
+            hash = hashContent(std::string_view(chunk.data(), static_cast<size_t>(count)), hash);
+        }
+    }
+    return file.eof();
+}
+
+// The random per-process token keeps two processes writing the same artifact
+// (e.g. the editor plugin and a CLI run) off each other's temp files; the
+// counter separates writers within this process
+std::filesystem::path makeTempPath(const std::filesystem::path& target) {
+    static const std::string process_token = [] {
+        std::random_device device;
+        std::ostringstream token;
+        token << std::hex << device() << device();
+        return token.str();
+    }();
+    static std::atomic<unsigned> counter{0};
+    std::filesystem::path temp = target;
+    temp += ".tmp" + process_token + "-" + std::to_string(counter.fetch_add(1));
+    return temp;
+}
+
+} // namespace
+
+ArtifactWriteStatus writeArtifactIfChanged(const std::string& file_path,
+                                           const std::function<void(std::ostream&)>& render,
+                                           std::string& error) {
+    namespace fs = std::filesystem;
+
+    fs::path target(file_path);
+    fs::path temp = makeTempPath(target);
+    std::error_code ec;
+
+    try {
+        uint64_t new_hash = 0;
+        uintmax_t new_size = 0;
+        {
+            std::vector<char> buffer(ARTIFACT_BUFFER_SIZE);
+            std::ofstream file;
+            file.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            file.open(temp, std::ios::binary);
+            if (!file.is_open()) {
+                error = "Failed to open file for writing: " + temp.string();
+                return ArtifactWriteStatus::Failed;
+            }
+
+            HashingStreamBuf hashing(file.rdbuf());
+            std::ostream out(&hashing);
+            render(out);
+            out.flush();
+            file.close();
+
+            if (!out.good() || file.fail()) {
+                fs::remove(temp, ec);
+                error = "Error writing to file " + file_path;
+                return ArtifactWriteStatus::Failed;
+            }
+            new_hash = hashing.hash();
+            new_size = hashing.size();
+        }
+
+        // Cheap size check first; only same-sized files are read back and hashed
+        uint64_t existing_hash = 0;
+        if (fs::is_regular_file(target, ec) && fs::file_size(target, ec) == new_size &&
+            hashExistingFile(target, existing_hash) && existing_hash == new_hash) {
+            fs::remove(temp, ec);
+            return ArtifactWriteStatus::Unchanged;
+        }
+
+        fs::rename(temp, target, ec);
+        if (ec) {
+            error = "Failed to replace " + file_path + ": " + ec.message();
+            fs::remove(temp, ec);
+            return ArtifactWriteStatus::Failed;
+        }
+        return ArtifactWriteStatus::Written;
+    } catch (const std::exception& e) {
+        fs::remove(temp, ec);
+        error = "Error writing to file " + file_path + ": " + std::string(e.what());
+        return ArtifactWriteStatus::Failed;
+    }
+}
+
+} // namespace Metadata
+} // namespace UnityContextGen
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <functional>
+#include <ostream>
+#include <string>
+
+namespace UnityContextGen {
+namespace Metadata {
+
+enum class ArtifactWriteStatus {
+    Written,
+    Unchanged,
+    Failed
+};
+
+// Renders an artifact into a temp file beside the target while hashing it,
+// then renames it over the target only if the content differs from what is
+// already on disk. Unchanged outputs keep their timestamps, and readers never
+// observe a partially written file.
+ArtifactWriteStatus writeArtifactIfChanged(const std::string& file_path,
+                                           const std::function<void(std::ostream&)>& render,
+                                           std::string& error);
+
+} // namespace Metadata
+} // namespace UnityContextGen
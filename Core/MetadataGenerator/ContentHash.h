@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace UnityContextGen {
+namespace Metadata {
+
+// FNV-1a 64-bit. Cheap and stable across platforms, which is all exported
+// artifacts need to detect changed or corrupted content; not cryptographic.
+constexpr uint64_t FNV1A_OFFSET_BASIS = 14695981039346656037ULL;
+constexpr uint64_t FNV1A_PRIME = 1099511628211ULL;
+
+inline uint64_t hashContent(std::string_view content, uint64_t seed = FNV1A_OFFSET_BASIS) {
+    uint64_t hash = seed;
+    for (char c : content) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= FNV1A_PRIME;
+    }
+    return hash;
+}
+
+inline std::string hashToHex(uint64_t hash) {
+    static const char HEX_DIGITS[] = "0123456789abcdef";
+    std::string hex(16, '0');
+    for (int i = 15; i >= 0; --i) {
+        hex[i] = HEX_DIGITS[hash & 0xF];
+        hash >>= 4;
+    }
+    return hex;
+}
+
+} // namespace Metadata
+} // namespace UnityContextGen
@@ -0,0 +1,110 @@
+#include "DeltaExporter.h"
+#include "ContentHash.h"
+#include <sstream>
+
+namespace UnityContextGen {
+namespace Metadata {
+
+static const char* const REVISION_KEY = "revision";
+
+DeltaExporter::DeltaExporter() {
+}
+
+void DeltaExporter::writeSnapshotJSON(const ProjectMetadata& metadata, JSONStreamWriter& writer) const {
+    writer.beginObject();
+
+    // The analysis timestamp is left out so an unchanged project yields an empty delta
+    writer.key("project_summary");
+    writer.beginObject();
+    writer.field("architecture_pattern", metadata.project_summary.architecture_pattern);
+    writer.field("key_systems", metadata.project_summary.key_systems);
+    writer.field("data_flow", metadata.project_summary.data_flow);
+    writer.field("game_type", metadata.project_summary.game_type);
+    writer.field("complexity_level", metadata.project_summary.complexity_level);
+    writer.field("total_components", metadata.project_summary.total_components);
+    writer.field("total_dependencies", metadata.project_summary.total_dependencies);
+    writer.endObject();
+
+    writer.key("components");
+    writer.beginObject();
+    for (const auto& comp_pair : metadata.components) {
+        writer.key(comp_pair.second.class_name);
+        m_exporter.writeComponentJSON(comp_pair.second, writer);
+    }
+    writer.endObject();
+
+    writer.key("systems");
+    m_exporter.writeSystemGroupsJSON(metadata, writer);
+    writer.key("dependency_graph");
+    m_exporter.writeDependencyGraphJSON(metadata, writer);
+    writer.key("patterns");
+    m_exporter.writePatternAnalysisJSON(metadata, writer);
+
+    writer.key("quality");
+    writer.beginObject();
+    writer.field("maintainability_score", metadata.quality.maintainability_score);
+    writer.field("testability_score", metadata.quality.testability_score);
+    writer.field("performance_score", metadata.quality.performance_score);
+    writer.field("architecture_score", metadata.quality.architecture_score);
+    writer.field("improvement_suggestions", metadata.quality.improvement_suggestions);
+    writer.endObject();
+
+    writer.endObject();
+}
+
+nlohmann::json DeltaExporter::createSnapshot(const ProjectMetadata& metadata) const {
+    std::ostringstream buffer;
+    {
+        JSONStreamWriter writer(buffer, false);
+        writeSnapshotJSON(metadata, writer);
+    }
+    return nlohmann::json::parse(buffer.str());
+}
+
+void DeltaExporter::sealSnapshot(nlohmann::json& snapshot) {
+    snapshot.erase(REVISION_KEY);
+    snapshot[REVISION_KEY] = hashToHex(hashContent(snapshot.dump()));
+}
+
+nlohmann::json DeltaExporter::createPatch(const nlohmann::json& before, const nlohmann::json& after) {
+    nlohmann::json patch = nlohmann::json::diff(before, after);
+    if (patch.empty() || !before.contains(REVISION_KEY)) {
+        return patch;
+    }
+
+    nlohmann::json guarded = nlohmann::json::array();
+    guarded.push_back({{"op", "test"}, {"path", std::string("/") + REVISION_KEY}, {"value", before[REVISION_KEY]}});
+    for (auto& operation : patch) {
+        guarded.push_back(std::move(operation));
+    }
+    return guarded;
+}
+
+ChangeSummary DeltaExporter::summarizeChanges(const nlohmann::json& before, const nlohmann::json& after,
+                                              const nlohmann::json& patch) {
+    static const nlohmann::json EMPTY_OBJECT = nlohmann::json::object();
+
+    ChangeSummary summary;
+    summary.operation_count = patch.size();
+
+    const auto& old_components = before.contains("components") ? before["components"] : EMPTY_OBJECT;
+    const auto& new_components = after.contains("components") ? after["components"] : EMPTY_OBJECT;
+
+    for (auto it = new_components.begin(); it != new_components.end(); ++it) {
+        auto old_it = old_components.find(it.key());
+        if (old_it == old_components.end()) {
+            summary.added_components.push_back(it.key());
+        } else if (*old_it != it.value()) {
+            summary.modified_components.push_back(it.key());
+        }
+    }
+    for (auto it = old_components.begin(); it != old_components.end(); ++it) {
+        if (!new_components.contains(it.key())) {
+            summary.removed_components.push_back(it.key());
+        }
+    }
+    return summary;
+}
+
+} // namespace Metadata
+} // namespace UnityContextGen
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "ProjectMetadata.h"
+#include "JSONExporter.h"
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+namespace UnityContextGen {
+namespace Metadata {
+
+struct ChangeSummary {
+    std::vector<std::string> added_components;
+    std::vector<std::string> removed_components;
+    std::vector<std::string> modified_components;
+    size_t operation_count = 0;
+
+    bool empty() const { return operation_count == 0; }
+};
+
+// Diffs successive analysis snapshots into RFC 6902 JSON Patch documents.
+// Snapshots key components by class name rather than array position, so a
+// change to one component produces operations under /components/<name> only.
+class DeltaExporter {
+public:
+    DeltaExporter();
+    ~DeltaExporter() = default;
+
+    void writeSnapshotJSON(const ProjectMetadata& metadata, JSONStreamWriter& writer) const;
+    nlohmann::json createSnapshot(const ProjectMetadata& metadata) const;
+
+    // Stamps a content revision on a snapshot, after any extra sections were added
+    static void sealSnapshot(nlohmann::json& snapshot);
+
+    // Patch turning `before` into `after`. Non-empty patches start with a test of
+    // the base revision so they are rejected when applied to the wrong snapshot.
+    static nlohmann::json createPatch(const nlohmann::json& before, const nlohmann::json& after);
+    static ChangeSummary summarizeChanges(const nlohmann::json& before, const nlohmann::json& after,
+                                          const nlohmann::json& patch);
+
+private:
+    JSONExporter m_exporter;
+};
+
+} // namespace Metadata
+} // namespace UnityContextGen
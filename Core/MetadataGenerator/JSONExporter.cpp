@@ -1,22 +1,25 @@
 #include "JSONExporter.h"
+#include "ArtifactWriter.h"
 #include <iostream>
 #include <iomanip>
+#include <sstream>
 
 namespace UnityContextGen {
 namespace Metadata {
 
-JSONExporter::JSONExporter() {
+JSONExporter::JSONExporter() : m_compact_output(false) {
 }
 
 bool JSONExporter::exportProjectMetadata(const ProjectMetadata& metadata, const std::string& output_path) const {
-    ProjectMetadataGenerator generator;
-    nlohmann::json json_data = createClaudeCodeOptimizedJSON(metadata);
-    return writeToFile(json_data, output_path);
+    return streamToFile(output_path, [&](JSONStreamWriter& writer) {
+        writeClaudeCodeOptimizedJSON(metadata, writer);
+    });
 }
 
 bool JSONExporter::exportComponentMetadata(const ComponentMetadata& metadata, const std::string& output_path) const {
-    nlohmann::json json_data = createComponentJSON(metadata);
-    return writeToFile(json_data, output_path);
+    return streamToFile(output_path, [&](JSONStreamWriter& writer) {
+        writeComponentJSON(metadata, writer);
+    });
 }
 
 bool JSONExporter::exportSummary(const ProjectMetadata& metadata, const std::string& output_path) const {
@@ -95,6 +98,67 @@ nlohmann::json JSONExporter::createClaudeCodeOptimizedJSON(const ProjectMetadata
     return optimized;
 }
 
+// Keys are written in the sorted order nlohmann::json uses, so streamed and DOM exports are byte-identical
+void JSONExporter::writeClaudeCodeOptimizedJSON(const ProjectMetadata& metadata, JSONStreamWriter& writer) const {
+    writer.beginObject();
+    
+    writer.key("component_overview");
+    writer.beginArray();
+    for (const auto& comp_pair : metadata.components) {
+        const auto& comp = comp_pair.second;
+        writer.beginObject();
+        writer.field("complexity_score", comp.metrics.complexity_score);
+        writer.field("dependencies", comp.dependencies);
+        writer.field("name", comp.class_name);
+        writer.field("purpose", comp.purpose);
+        writer.field("responsibility_summary", comp.responsibility_blocks.block_order);
+        writer.endObject();
+    }
+    writer.endArray();
+    
+    writer.key("dependency_graph");
+    writeDependencyGraphJSON(metadata, writer);
+    writer.key("design_patterns");
+    writePatternAnalysisJSON(metadata, writer);
+    
+    writer.key("development_context");
+    writer.beginObject();
+    writer.field("code_style", "Unity C# MonoBehaviour patterns");
+    writer.field("conventions", std::vector<std::string>{
+        "Use Unity lifecycle methods appropriately",
+        "Follow component-based architecture",
+        "Minimize dependencies between components",
+        "Use SerializeField for inspector-visible fields"
+    });
+    writer.field("performance_considerations", std::vector<std::string>{
+        "Avoid expensive operations in Update methods",
+        "Use object pooling for frequently created/destroyed objects",
+        "Cache component references in Awake or Start"
+    });
+    writer.endObject();
+    
+    writer.key("llm_guidance");
+    writer.beginObject();
+    writer.field("code_generation_style", "Match existing method naming and structure");
+    writer.field("dependency_management", "Use GetComponent calls sparingly, prefer SerializeField references");
+    writer.field("unity_best_practices", "Respect Unity execution order and lifecycle methods");
+    writer.field("when_adding_features", "Follow existing patterns and maintain component separation");
+    writer.endObject();
+    
+    writer.key("project_context");
+    writer.beginObject();
+    writer.field("architecture", metadata.project_summary.architecture_pattern);
+    writer.field("complexity", metadata.project_summary.complexity_level);
+    writer.field("key_systems", metadata.project_summary.key_systems);
+    writer.field("type", metadata.project_summary.game_type);
+    writer.endObject();
+    
+    writer.key("system_architecture");
+    writeSystemGroupsJSON(metadata, writer);
+    
+    writer.endObject();
+}
+
 nlohmann::json JSONExporter::createComponentAnalysisJSON(const std::vector<ComponentMetadata>& components) const {
     nlohmann::json analysis;
     
@@ -280,6 +344,52 @@ nlohmann::json JSONExporter::createComponentJSON(const ComponentMetadata& metada
     return component;
 }
 
+void JSONExporter::writeComponentJSON(const ComponentMetadata& metadata, JSONStreamWriter& writer) const {
+    writer.beginObject();
+    
+    writer.field("attributes", metadata.attributes);
+    writer.field("class_name", metadata.class_name);
+    writer.field("dependencies", metadata.dependencies);
+    writer.field("dependents", metadata.dependents);
+    writer.field("design_patterns", metadata.design_patterns);
+    writer.field("file_path", metadata.file_path);
+    
+    writer.key("lifecycle");
+    writer.beginObject();
+    writer.field("data_flow", metadata.lifecycle.data_flow);
+    writer.field("execution_order", metadata.lifecycle.execution_order);
+    writer.field("method_purposes", metadata.lifecycle.method_purposes);
+    writer.field("methods", metadata.lifecycle.methods);
+    writer.endObject();
+    
+    writer.key("location");
+    writer.beginObject();
+    writer.field("end_line", metadata.end_line);
+    writer.field("start_line", metadata.start_line);
+    writer.endObject();
+    
+    writer.key("metrics");
+    writer.beginObject();
+    writer.field("complexity_score", metadata.metrics.complexity_score);
+    writer.field("dependency_count", metadata.metrics.dependency_count);
+    writer.field("method_count", metadata.metrics.method_count);
+    writer.field("pattern_confidence", metadata.metrics.pattern_confidence);
+    writer.field("unity_method_count", metadata.metrics.unity_method_count);
+    writer.endObject();
+    
+    writer.field("purpose", metadata.purpose);
+    
+    writer.key("responsibility_blocks");
+    writer.beginObject();
+    writer.field("block_order", metadata.responsibility_blocks.block_order);
+    writer.field("blocks", metadata.responsibility_blocks.blocks);
+    writer.endObject();
+    
+    writer.field("serialized_fields", metadata.serialized_fields);
+    
+    writer.endObject();
+}
+
 nlohmann::json JSONExporter::createSystemGroupsJSON(const ProjectMetadata& metadata) const {
     nlohmann::json systems;
     
@@ -291,6 +401,15 @@ nlohmann::json JSONExporter::createSystemGroupsJSON(const ProjectMetadata& metad
     return systems;
 }
 
+void JSONExporter::writeSystemGroupsJSON(const ProjectMetadata& metadata, JSONStreamWriter& writer) const {
+    writer.beginObject();
+    writer.field("complexity_scores", metadata.systems.system_complexity);
+    writer.field("core_systems", metadata.systems.core_systems);
+    writer.field("groups", metadata.systems.system_groups);
+    writer.field("support_systems", metadata.systems.support_systems);
+    writer.endObject();
+}
+
 nlohmann::json JSONExporter::createDependencyGraphJSON(const ProjectMetadata& metadata) const {
     nlohmann::json dependencies;
     
@@ -303,6 +422,16 @@ nlohmann::json JSONExporter::createDependencyGraphJSON(const ProjectMetadata& me
     return dependencies;
 }
 
+void JSONExporter::writeDependencyGraphJSON(const ProjectMetadata& metadata, JSONStreamWriter& writer) const {
+    writer.beginObject();
+    writer.field("clusters", metadata.dependencies.dependency_clusters);
+    writer.field("has_cycles", metadata.dependencies.has_circular_dependencies);
+    writer.field("high_coupling", metadata.dependencies.high_coupling_components);
+    writer.field("isolated", metadata.dependencies.isolated_components);
+    writer.field("topological_order", metadata.dependencies.topological_order);
+    writer.endObject();
+}
+
 nlohmann::json JSONExporter::createPatternAnalysisJSON(const ProjectMetadata& metadata) const {
     nlohmann::json patterns;
     
@@ -314,22 +443,46 @@ nlohmann::json JSONExporter::createPatternAnalysisJSON(const ProjectMetadata& me
     return patterns;
 }
 
+void JSONExporter::writePatternAnalysisJSON(const ProjectMetadata& metadata, JSONStreamWriter& writer) const {
+    writer.beginObject();
+    writer.field("consistency_score", metadata.patterns.pattern_consistency_score);
+    writer.field("dominant", metadata.patterns.dominant_patterns);
+    writer.field("frequency", metadata.patterns.pattern_frequency);
+    writer.field("recommended", metadata.patterns.recommended_patterns);
+    writer.endObject();
+}
+
+bool JSONExporter::streamToFile(const std::string& file_path,
+                                const std::function<void(JSONStreamWriter&)>& write_document) const {
+    std::string error;
+    auto status = writeArtifactIfChanged(file_path, [&](std::ostream& out) {
+        JSONStreamWriter writer(out, !m_compact_output);
+        write_document(writer);
+        writer.flush();
+    }, error);
+    
+    if (status == ArtifactWriteStatus::Failed) {
+        std::cerr << "Error writing JSON to file: " << error << std::endl;
+        return false;
+    }
+    return true;
+}
+
 bool JSONExporter::writeToFile(const nlohmann::json& json_data, const std::string& file_path) const {
-    try {
-        std::ofstream file(file_path);
-        if (!file.is_open()) {
-            std::cerr << "Failed to open file for writing: " << file_path << std::endl;
-            return false;
+    std::string error;
+    auto status = writeArtifactIfChanged(file_path, [&](std::ostream& out) {
+        if (m_compact_output) {
+            out << json_data.dump() << '\n';
+        } else {
+            out << std::setw(2) << json_data << '\n';
         }
-        
-        file << std::setw(2) << json_data << std::endl;
-        file.close();
-        
-        return true;
-    } catch (const std::exception& e) {
-        std::cerr << "Error writing JSON to file: " << e.what() << std::endl;
+    }, error);
+    
+    if (status == ArtifactWriteStatus::Failed) {
+        std::cerr << "Error writing JSON to file: " << error << std::endl;
         return false;
     }
+    return true;
 }
 
 std::string JSONExporter::prettifyJSON(const nlohmann::json& json_data) const {
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "ProjectMetadata.h"
+#include "JSONStreamWriter.h"
 #include <nlohmann/json.hpp>
+#include <functional>
 #include <string>
 #include <fstream>
 
@@ -13,6 +15,9 @@ public:
     JSONExporter();
     ~JSONExporter() = default;
 
+    void setCompactOutput(bool compact) { m_compact_output = compact; }
+    bool isCompactOutput() const { return m_compact_output; }
+
     bool exportProjectMetadata(const ProjectMetadata& metadata, const std::string& output_path) const;
     bool exportComponentMetadata(const ComponentMetadata& metadata, const std::string& output_path) const;
     bool exportSummary(const ProjectMetadata& metadata, const std::string& output_path) const;
@@ -24,10 +29,21 @@ public:
     std::string formatForLLMPrompt(const ProjectMetadata& metadata) const;
     std::string formatComponentForLLMPrompt(const ComponentMetadata& component) const;
     
+    // Streaming export without building a DOM; output is byte-identical to the create*JSON documents
+    void writeClaudeCodeOptimizedJSON(const ProjectMetadata& metadata, JSONStreamWriter& writer) const;
+    void writeComponentJSON(const ComponentMetadata& metadata, JSONStreamWriter& writer) const;
+    void writeSystemGroupsJSON(const ProjectMetadata& metadata, JSONStreamWriter& writer) const;
+    void writeDependencyGraphJSON(const ProjectMetadata& metadata, JSONStreamWriter& writer) const;
+    void writePatternAnalysisJSON(const ProjectMetadata& metadata, JSONStreamWriter& writer) const;
+    bool streamToFile(const std::string& file_path,
+                      const std::function<void(JSONStreamWriter&)>& write_document) const;
+    
     bool writeToFile(const nlohmann::json& json_data, const std::string& file_path) const;
     std::string prettifyJSON(const nlohmann::json& json_data) const;
 
 private:
+    bool m_compact_output;
+    
     nlohmann::json createComponentJSON(const ComponentMetadata& metadata) const;
     nlohmann::json createSystemGroupsJSON(const ProjectMetadata& metadata) const;
     nlohmann::json createDependencyGraphJSON(const ProjectMetadata& metadata) const;
@@ -0,0 +1,248 @@
+#include "JSONStreamWriter.h"
+#include <charconv>
+#include <cmath>
+#include <nlohmann/json.hpp>
+
+namespace UnityContextGen {
+namespace Metadata {
+
+static const size_t STREAM_BUFFER_SIZE = 64 * 1024;
+
+JSONStreamWriter::JSONStreamWriter(std::ostream& output, bool pretty, int indent)
+    : m_output(output), m_pretty(pretty), m_indent(indent), m_after_key(false) {
+    m_buffer.reserve(STREAM_BUFFER_SIZE);
+}
+
+JSONStreamWriter::~JSONStreamWriter() {
+    flush();
+}
+
+void JSONStreamWriter::beginObject() {
+    beginContainer(true, '{');
+}
+
+void JSONStreamWriter::endObject() {
+    endContainer('}');
+}
+
+void JSONStreamWriter::beginArray() {
+    beginContainer(false, '[');
+}
+
+void JSONStreamWriter::endArray() {
+    endContainer(']');
+}
+
+void JSONStreamWriter::key(const std::string& name) {
+    beginValue();
+    writeEscaped(name);
+    writeRaw(':');
+    if (m_pretty) {
+        writeRaw(' ');
+    }
+    m_after_key = true;
+}
+
+void JSONStreamWriter::value(const std::string& text) {
+    beginValue();
+    writeEscaped(text);
+}
+
+void JSONStreamWriter::value(const char* text) {
+    if (!text) {
+        null();
+        return;
+    }
+    value(std::string(text));
+}
+
+void JSONStreamWriter::value(bool flag) {
+    beginValue();
+    if (flag) {
+        writeRaw("true", 4);
+    } else {
+        writeRaw("false", 5);
+    }
+}
+
+void JSONStreamWriter::value(int number) {
+    value(static_cast<int64_t>(number));
+}
+
+void JSONStreamWriter::value(int64_t number) {
+    beginValue();
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), number);
+    writeRaw(digits, result.ptr - digits);
+}
+
+void JSONStreamWriter::value(size_t number) {
+    beginValue();
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), number);
+    writeRaw(digits, result.ptr - digits);
+}
+
+void JSONStreamWriter::value(float number) {
+    beginValue();
+    writeNumber(number);
+}
+
+void JSONStreamWriter::value(double number) {
+    beginValue();
+    writeNumber(number);
+}
+
+void JSONStreamWriter::null() {
+    beginValue();
+    writeRaw("null", 4);
+}
+
+void JSONStreamWriter::value(const std::vector<std::string>& items) {
+    beginArray();
+    for (const auto& item : items) {
+        value(item);
+    }
+    endArray();
+}
+
+void JSONStreamWriter::value(const std::map<std::string, std::string>& items) {
+    beginObject();
+    for (const auto& item : items) {
+        field(item.first, item.second);
+    }
+    endObject();
+}
+
+void JSONStreamWriter::value(const std::map<std::string, int>& items) {
+    beginObject();
+    for (const auto& item : items) {
+        field(item.first, item.second);
+    }
+    endObject();
+}
+
+void JSONStreamWriter::value(const std::map<std::string, std::vector<std::string>>& items) {
+    beginObject();
+    for (const auto& item : items) {
+        field(item.first, item.second);
+    }
+    endObject();
+}
+
+void JSONStreamWriter::flush() {
+    if (!m_buffer.empty()) {
+        m_output.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+        m_buffer.clear();
+    }
+    m_output.flush();
+}
+
+bool JSONStreamWriter::good() const {
+    return m_output.good();
+}
+
+void JSONStreamWriter::beginValue() {
+    if (m_after_key) {
+        m_after_key = false;
+        return;
+    }
+
+    if (m_scopes.empty()) {
+        return;
+    }
+
+    Scope& scope = m_scopes.back();
+    if (scope.has_items) {
+        writeRaw(',');
+    }
+    scope.has_items = true;
+
+    if (m_pretty) {
+        writeRaw('\n');
+        writeIndent(m_scopes.size());
+    }
+}
+
+void JSONStreamWriter::beginContainer(bool is_object, char open) {
+    beginValue();
+    writeRaw(open);
+    m_scopes.push_back({is_object, false});
+}
+
+void JSONStreamWriter::endContainer(char close) {
+    if (m_scopes.empty()) {
+        return;
+    }
+
+    bool had_items = m_scopes.back().has_items;
+    m_scopes.pop_back();
+
+    if (m_pretty && had_items) {
+        writeRaw('\n');
+        writeIndent(m_scopes.size());
+    }
+    writeRaw(close);
+
+    if (m_scopes.empty() && m_pretty) {
+        writeRaw('\n');
+    }
+}
+
+void JSONStreamWriter::writeIndent(size_t depth) {
+    m_buffer.append(depth * m_indent, ' ');
+}
+
+void JSONStreamWriter::writeEscaped(const std::string& text) {
+    static const char HEX_DIGITS[] = "0123456789abcdef";
+
+    writeRaw('"');
+    for (char c : text) {
+        unsigned char uc = static_cast<unsigned char>(c);
+        switch (c) {
+            case '"': writeRaw("\\\"", 2); break;
+            case '\\': writeRaw("\\\\", 2); break;
+            case '\b': writeRaw("\\b", 2); break;
+            case '\f': writeRaw("\\f", 2); break;
+            case '\n': writeRaw("\\n", 2); break;
+            case '\r': writeRaw("\\r", 2); break;
+            case '\t': writeRaw("\\t", 2); break;
+            default:
+                if (uc < 0x20) {
+                    char escaped[6] = {'\\', 'u', '0', '0', HEX_DIGITS[uc >> 4], HEX_DIGITS[uc & 0xF]};
+                    writeRaw(escaped, sizeof(escaped));
+                } else {
+                    writeRaw(c);
+                }
+                break;
+        }
+    }
+    writeRaw('"');
+}
+
+void JSONStreamWriter::writeRaw(const char* data, size_t length) {
+    if (m_buffer.size() + length > STREAM_BUFFER_SIZE) {
+        m_output.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+        m_buffer.clear();
+    }
+    m_buffer.append(data, length);
+}
+
+void JSONStreamWriter::writeRaw(char c) {
+    writeRaw(&c, 1);
+}
+
+// Formatted by nlohmann::json's public dump (floats widened to double) so
+// streamed documents are byte-identical to dumped DOMs
+void JSONStreamWriter::writeNumber(double number) {
+    if (!std::isfinite(number)) {
+        writeRaw("null", 4);
+        return;
+    }
+
+    std::string digits = nlohmann::json(number).dump();
+    writeRaw(digits.data(), digits.size());
+}
+
+} // namespace Metadata
+} // namespace UnityContextGen
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace UnityContextGen {
+namespace Metadata {
+
+// Event-style JSON writer that serializes straight into an output stream
+// through a fixed-size buffer, so exports never materialize a JSON DOM.
+class JSONStreamWriter {
+public:
+    explicit JSONStreamWriter(std::ostream& output, bool pretty = true, int indent = 2);
+    ~JSONStreamWriter();
+
+    JSONStreamWriter(const JSONStreamWriter&) = delete;
+    JSONStreamWriter& operator=(const JSONStreamWriter&) = delete;
+
+    // Structure
+    void beginObject();
+    void endObject();
+    void beginArray();
+    void endArray();
+    void key(const std::string& name);
+
+    // Scalars
+    void value(const std::string& text);
+    void value(const char* text);
+    void value(bool flag);
+    void value(int number);
+    void value(int64_t number);
+    void value(size_t number);
+    void value(float number);
+    void value(double number);
+    void null();
+
+    // Containers of scalars
+    void value(const std::vector<std::string>& items);
+    void value(const std::map<std::string, std::string>& items);
+    void value(const std::map<std::string, int>& items);
+    void value(const std::map<std::string, std::vector<std::string>>& items);
+
+    template<typename T>
+    void field(const std::string& name, const T& field_value) {
+        key(name);
+        value(field_value);
+    }
+
+    void flush();
+    bool good() const;
+
+private:
+    struct Scope {
+        bool is_object;
+        bool has_items;
+    };
+
+    std::ostream& m_output;
+    std::string m_buffer;
+    std::vector<Scope> m_scopes;
+    bool m_pretty;
+    int m_indent;
+    bool m_after_key;
+
+    void beginValue();
+    void beginContainer(bool is_object, char open);
+    void endContainer(char close);
+    void writeIndent(size_t depth);
+    void writeEscaped(const std::string& text);
+    void writeRaw(const char* data, size_t length);
+    void writeRaw(char c);
+    void writeNumber(double number);
+};
+
+} // namespace Metadata
+} // namespace UnityContextGen
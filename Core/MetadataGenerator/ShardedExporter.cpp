@@ -0,0 +1,299 @@
+#include "ShardedExporter.h"
+#include "ArtifactWriter.h"
+#include "ContentHash.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+
+namespace UnityContextGen {
+namespace Metadata {
+
+const char* const ShardedExporter::MANIFEST_FILE_NAME = "shard_manifest.json";
+const char* const ShardedExporter::SHARD_DIRECTORY_NAME = "shards";
+
+static const int MANIFEST_FORMAT_VERSION = 1;
+static const char* const UNGROUPED_SYSTEM = "Ungrouped";
+
+const ShardEntry* ShardManifest::findComponent(const std::string& component) const {
+    for (const auto& entry : entries) {
+        if (entry.component == component) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+ShardedExporter::ShardedExporter() : m_granularity(ShardGranularity::SystemGroup) {
+}
+
+bool ShardedExporter::exportShards(const ProjectMetadata& metadata, const std::string& output_directory,
+                                   ShardManifest* manifest_out) const {
+    ShardManifest manifest;
+    if (!writeShards(metadata, output_directory, manifest)) {
+        return false;
+    }
+
+    std::string manifest_path = (std::filesystem::path(output_directory) / MANIFEST_FILE_NAME).string();
+    bool written = m_exporter.streamToFile(manifest_path, [&](JSONStreamWriter& writer) {
+        writeManifestJSON(metadata, manifest, writer);
+    });
+
+    if (written && manifest_out) {
+        *manifest_out = std::move(manifest);
+    }
+    return written;
+}
+
+bool ShardedExporter::writeShards(const ProjectMetadata& metadata, const std::string& output_directory,
+                                  ShardManifest& manifest) const {
+    namespace fs = std::filesystem;
+
+    try {
+        fs::create_directories(fs::path(output_directory) / SHARD_DIRECTORY_NAME);
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to create shard directory: " << e.what() << std::endl;
+        return false;
+    }
+
+    // A component listed under several systems is stored once, under the first
+    std::map<std::string, std::string> system_of;
+    for (const auto& group : metadata.systems.system_groups) {
+        for (const auto& component : group.second) {
+            system_of.emplace(component, group.first);
+        }
+    }
+
+    manifest = ShardManifest();
+    manifest.granularity = m_granularity;
+    manifest.analysis_timestamp = metadata.analysis_timestamp;
+
+    // Shard file -> contents, in first-seen order so offsets are deterministic
+    std::vector<std::pair<std::string, std::string>> shards;
+    std::map<std::string, size_t> shard_index;
+    std::map<std::string, std::string> system_shard_names;
+    
+    // Compared lower-cased so two shards never share a file on case-insensitive file systems
+    std::set<std::string> used_names;
+    auto uniqueShardName = [&used_names](const std::string& base) {
+        std::string name = base;
+        for (int suffix = 2; ; ++suffix) {
+            std::string lower = name;
+            std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+            if (used_names.insert(lower).second) {
+                return name;
+            }
+            name = base + "_" + std::to_string(suffix);
+        }
+    };
+
+    for (const auto& comp_pair : metadata.components) {
+        const auto& component = comp_pair.second;
+
+        ShardEntry entry;
+        entry.component = component.class_name;
+        auto system_it = system_of.find(component.class_name);
+        entry.system = system_it != system_of.end() ? system_it->second : UNGROUPED_SYSTEM;
+
+        if (m_granularity == ShardGranularity::Component) {
+            std::string name = uniqueShardName(sanitizeFileName(component.class_name));
+            entry.shard_file = std::string(SHARD_DIRECTORY_NAME) + "/" + name + ".json";
+        } else {
+            auto name_it = system_shard_names.find(entry.system);
+            if (name_it == system_shard_names.end()) {
+                name_it = system_shard_names.emplace(entry.system, uniqueShardName(sanitizeFileName(entry.system))).first;
+            }
+            entry.shard_file = std::string(SHARD_DIRECTORY_NAME) + "/" + name_it->second + ".jsonl";
+        }
+
+        auto index_it = shard_index.find(entry.shard_file);
+        if (index_it == shard_index.end()) {
+            index_it = shard_index.emplace(entry.shard_file, shards.size()).first;
+            shards.emplace_back(entry.shard_file, std::string());
+        }
+        std::string& contents = shards[index_it->second].second;
+
+        std::string record = renderRecord(component);
+        entry.offset = contents.size();
+        entry.length = record.size();
+        entry.hash = hashToHex(hashContent(record));
+
+        contents += record;
+        contents += '\n';
+        manifest.entries.push_back(std::move(entry));
+    }
+
+    // Shards whose components did not change keep their files untouched
+    for (const auto& shard : shards) {
+        std::string shard_path = (fs::path(output_directory) / shard.first).string();
+        std::string error;
+        auto status = writeArtifactIfChanged(shard_path, [&shard](std::ostream& out) {
+            out.write(shard.second.data(), static_cast<std::streamsize>(shard.second.size()));
+        }, error);
+        if (status == ArtifactWriteStatus::Failed) {
+            std::cerr << "Error writing shard: " << error << std::endl;
+            return false;
+        }
+    }
+    
+    // Shards from earlier exports that the new manifest no longer lists
+    std::error_code ec;
+    for (const auto& file : fs::directory_iterator(fs::path(output_directory) / SHARD_DIRECTORY_NAME, ec)) {
+        std::string extension = file.path().extension().string();
+        std::string relative_path = std::string(SHARD_DIRECTORY_NAME) + "/" + file.path().filename().string();
+        if (file.is_regular_file() && (extension == ".json" || extension == ".jsonl") &&
+            shard_index.find(relative_path) == shard_index.end()) {
+            std::error_code remove_ec;
+            if (!fs::remove(file.path(), remove_ec)) {
+                std::cerr << "Failed to remove stale shard " << relative_path << ": " << remove_ec.message() << std::endl;
+            }
+        }
+    }
+    if (ec) {
+        std::cerr << "Failed to list shard directory: " << ec.message() << std::endl;
+    }
+    return true;
+}
+
+bool ShardedExporter::loadManifest(const std::string& manifest_path, ShardManifest& manifest) {
+    try {
+        std::ifstream file(manifest_path);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open shard manifest: " << manifest_path << std::endl;
+            return false;
+        }
+
+        nlohmann::json j = nlohmann::json::parse(file);
+        if (j.value("format_version", 0) != MANIFEST_FORMAT_VERSION) {
+            std::cerr << "Unsupported shard manifest version: " << manifest_path << std::endl;
+            return false;
+        }
+
+        manifest = ShardManifest();
+        parseGranularity(j.value("granularity", "system"), manifest.granularity);
+        manifest.analysis_timestamp = j.value("analysis_timestamp", "");
+
+        for (const auto& item : j.value("shards", nlohmann::json::array())) {
+            ShardEntry entry;
+            entry.component = item.value("component", "");
+            entry.system = item.value("system", "");
+            entry.shard_file = item.value("file", "");
+            entry.offset = item.value("offset", static_cast<size_t>(0));
+            entry.length = item.value("length", static_cast<size_t>(0));
+            entry.hash = item.value("hash", "");
+            manifest.entries.push_back(std::move(entry));
+        }
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Error reading shard manifest: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool ShardedExporter::loadRecord(const std::string& manifest_directory, const ShardEntry& entry,
+                                 std::string& record) {
+    std::filesystem::path shard_path = std::filesystem::path(manifest_directory) / entry.shard_file;
+    std::ifstream file(shard_path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open shard: " << shard_path.string() << std::endl;
+        return false;
+    }
+
+    record.assign(entry.length, '\0');
+    file.seekg(static_cast<std::streamoff>(entry.offset));
+    file.read(&record[0], static_cast<std::streamsize>(entry.length));
+    if (static_cast<size_t>(file.gcount()) != entry.length) {
+        std::cerr << "Shard record truncated for component: " << entry.component << std::endl;
+        return false;
+    }
+
+    if (hashToHex(hashContent(record)) != entry.hash) {
+        std::cerr << "Shard record hash mismatch for component: " << entry.component << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool ShardedExporter::parseGranularity(const std::string& name, ShardGranularity& granularity) {
+    if (name == "component") {
+        granularity = ShardGranularity::Component;
+    } else if (name == "system") {
+        granularity = ShardGranularity::SystemGroup;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+std::string ShardedExporter::granularityToString(ShardGranularity granularity) {
+    return granularity == ShardGranularity::Component ? "component" : "system";
+}
+
+std::string ShardedExporter::renderRecord(const ComponentMetadata& component) const {
+    std::ostringstream buffer;
+    {
+        JSONStreamWriter writer(buffer, false);
+        m_exporter.writeComponentJSON(component, writer);
+    }
+    return buffer.str();
+}
+
+void ShardedExporter::writeManifestJSON(const ProjectMetadata& metadata, const ShardManifest& manifest,
+                                        JSONStreamWriter& writer) const {
+    writer.beginObject();
+    writer.field("format_version", MANIFEST_FORMAT_VERSION);
+    writer.field("granularity", granularityToString(manifest.granularity));
+    writer.field("hash_algorithm", "fnv1a64");
+    writer.field("analysis_timestamp", manifest.analysis_timestamp);
+
+    writer.key("project_context");
+    writer.beginObject();
+    writer.field("type", metadata.project_summary.game_type);
+    writer.field("architecture", metadata.project_summary.architecture_pattern);
+    writer.field("complexity", metadata.project_summary.complexity_level);
+    writer.field("key_systems", metadata.project_summary.key_systems);
+    writer.field("total_components", metadata.project_summary.total_components);
+    writer.field("total_dependencies", metadata.project_summary.total_dependencies);
+    writer.endObject();
+
+    writer.key("system_architecture");
+    m_exporter.writeSystemGroupsJSON(metadata, writer);
+    writer.key("dependency_graph");
+    m_exporter.writeDependencyGraphJSON(metadata, writer);
+    writer.key("design_patterns");
+    m_exporter.writePatternAnalysisJSON(metadata, writer);
+
+    writer.key("shards");
+    writer.beginArray();
+    for (const auto& entry : manifest.entries) {
+        writer.beginObject();
+        writer.field("component", entry.component);
+        writer.field("system", entry.system);
+        writer.field("file", entry.shard_file);
+        writer.field("offset", entry.offset);
+        writer.field("length", entry.length);
+        writer.field("hash", entry.hash);
+        writer.endObject();
+    }
+    writer.endArray();
+
+    writer.endObject();
+}
+
+std::string ShardedExporter::sanitizeFileName(const std::string& name) {
+    std::string sanitized;
+    sanitized.reserve(name.size());
+    for (char c : name) {
+        unsigned char uc = static_cast<unsigned char>(c);
+        sanitized += (std::isalnum(uc) || c == '_' || c == '-') ? c : '_';
+    }
+    return sanitized.empty() ? "_" : sanitized;
+}
+
+} // namespace Metadata
+} // namespace UnityContextGen
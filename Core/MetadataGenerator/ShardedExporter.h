@@ -0,0 +1,73 @@
+#pragma once
+
+#include "ProjectMetadata.h"
+#include "JSONExporter.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace UnityContextGen {
+namespace Metadata {
+
+enum class ShardGranularity {
+    Component,   // One file per component
+    SystemGroup  // One JSON-lines file per system group, one component per line
+};
+
+struct ShardEntry {
+    std::string component;
+    std::string system;
+    std::string shard_file;     // Relative to the manifest directory
+    size_t offset = 0;
+    size_t length = 0;
+    std::string hash;           // FNV-1a 64 of the record bytes, hex
+};
+
+struct ShardManifest {
+    ShardGranularity granularity = ShardGranularity::SystemGroup;
+    std::string analysis_timestamp;
+    std::vector<ShardEntry> entries;
+
+    const ShardEntry* findComponent(const std::string& component) const;
+};
+
+// Splits project metadata into compact per-component records plus a manifest
+// of byte ranges and hashes, so consumers can read only the components they need.
+class ShardedExporter {
+public:
+    static const char* const MANIFEST_FILE_NAME;
+    static const char* const SHARD_DIRECTORY_NAME;
+
+    ShardedExporter();
+    ~ShardedExporter() = default;
+
+    void setGranularity(ShardGranularity granularity) { m_granularity = granularity; }
+    ShardGranularity getGranularity() const { return m_granularity; }
+    void setCompactManifest(bool compact) { m_exporter.setCompactOutput(compact); }
+
+    // Writes <output_directory>/shards/* and <output_directory>/shard_manifest.json
+    bool exportShards(const ProjectMetadata& metadata, const std::string& output_directory,
+                      ShardManifest* manifest_out = nullptr) const;
+    bool writeShards(const ProjectMetadata& metadata, const std::string& output_directory,
+                     ShardManifest& manifest) const;
+    void writeManifestJSON(const ProjectMetadata& metadata, const ShardManifest& manifest,
+                           JSONStreamWriter& writer) const;
+
+    static bool loadManifest(const std::string& manifest_path, ShardManifest& manifest);
+    static bool loadRecord(const std::string& manifest_directory, const ShardEntry& entry,
+                           std::string& record);
+
+    static bool parseGranularity(const std::string& name, ShardGranularity& granularity);
+    static std::string granularityToString(ShardGranularity granularity);
+
+private:
+    ShardGranularity m_granularity;
+    JSONExporter m_exporter;
+
+    std::string renderRecord(const ComponentMetadata& component) const;
+
+    static std::string sanitizeFileName(const std::string& name);
+};
+
+} // namespace Metadata
+} // namespace UnityContextGen
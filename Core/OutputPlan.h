@@ -0,0 +1,160 @@
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <string>
+
+namespace UnityContextGen {
+
+enum class OutputFormat {
+    JSON,
+    Markdown,
+    LLMPrompt,
+    All
+};
+
+// Files written by CoreEngine::exportResults
+enum class OutputArtifact : uint8_t {
+    ProjectMetadata,
+    ProjectContext,
+    LLMOptimized,
+    Summary,
+    DetailedReport,
+    LLMPrompt,
+    AITriage
+};
+
+// Project-level analysis passes run after MonoBehaviour extraction
+enum class AnalysisStage : uint8_t {
+    Dependencies,
+    Lifecycle,
+    Patterns,
+    ScriptableObjects,
+    APIUsage,
+    AIAnalysis,
+    Metadata,
+    Context
+};
+
+using OutputArtifactSet = uint32_t;
+using AnalysisStageSet = uint32_t;
+
+constexpr OutputArtifactSet artifactBit(OutputArtifact artifact) {
+    return OutputArtifactSet{1} << static_cast<uint8_t>(artifact);
+}
+
+constexpr AnalysisStageSet stageBit(AnalysisStage stage) {
+    return AnalysisStageSet{1} << static_cast<uint8_t>(stage);
+}
+
+constexpr bool hasArtifact(OutputArtifactSet artifacts, OutputArtifact artifact) {
+    return (artifacts & artifactBit(artifact)) != 0;
+}
+
+constexpr bool hasStage(AnalysisStageSet stages, AnalysisStage stage) {
+    return (stages & stageBit(stage)) != 0;
+}
+
+constexpr AnalysisStageSet ALL_ANALYSIS_STAGES = (stageBit(AnalysisStage::Context) << 1) - 1;
+
+constexpr OutputArtifactSet artifactsForFormat(OutputFormat format) {
+    switch (format) {
+        case OutputFormat::JSON:
+            return artifactBit(OutputArtifact::ProjectMetadata) |
+                   artifactBit(OutputArtifact::ProjectContext) |
+                   artifactBit(OutputArtifact::LLMOptimized);
+        case OutputFormat::Markdown:
+            return artifactBit(OutputArtifact::Summary) |
+                   artifactBit(OutputArtifact::DetailedReport);
+        case OutputFormat::LLMPrompt:
+            return artifactBit(OutputArtifact::LLMPrompt) |
+                   artifactBit(OutputArtifact::LLMOptimized);
+        case OutputFormat::All:
+        default:
+            return (artifactBit(OutputArtifact::AITriage) << 1) - 1;
+    }
+}
+
+// Stages an artifact reads directly
+constexpr AnalysisStageSet stagesForArtifact(OutputArtifact artifact) {
+    switch (artifact) {
+        case OutputArtifact::ProjectMetadata:
+            return stageBit(AnalysisStage::Metadata);
+        case OutputArtifact::Summary:
+            return stageBit(AnalysisStage::Metadata) | stageBit(AnalysisStage::Context);
+        case OutputArtifact::DetailedReport:
+            return stageBit(AnalysisStage::Metadata) | stageBit(AnalysisStage::Context) |
+                   stageBit(AnalysisStage::Patterns) | stageBit(AnalysisStage::Dependencies);
+        case OutputArtifact::AITriage:
+            return stageBit(AnalysisStage::AIAnalysis);
+        case OutputArtifact::ProjectContext:
+        case OutputArtifact::LLMOptimized:
+        case OutputArtifact::LLMPrompt:
+        default:
+            return stageBit(AnalysisStage::Context);
+    }
+}
+
+// Stages a stage consumes the results of
+constexpr AnalysisStageSet stagePrerequisites(AnalysisStage stage) {
+    switch (stage) {
+        case AnalysisStage::Patterns:
+            return stageBit(AnalysisStage::Dependencies);
+        case AnalysisStage::AIAnalysis:
+            return stageBit(AnalysisStage::APIUsage) | stageBit(AnalysisStage::Context);
+        case AnalysisStage::Metadata:
+            return stageBit(AnalysisStage::Dependencies) | stageBit(AnalysisStage::Lifecycle) |
+                   stageBit(AnalysisStage::Patterns);
+        case AnalysisStage::Context:
+            return stageBit(AnalysisStage::Metadata);
+        default:
+            return 0;
+    }
+}
+
+constexpr AnalysisStageSet stagesForArtifacts(OutputArtifactSet artifacts) {
+    AnalysisStageSet stages = 0;
+    for (uint8_t i = 0; i <= static_cast<uint8_t>(OutputArtifact::AITriage); ++i) {
+        if (hasArtifact(artifacts, static_cast<OutputArtifact>(i))) {
+            stages |= stagesForArtifact(static_cast<OutputArtifact>(i));
+        }
+    }
+
+    // Close over prerequisites until nothing new is added
+    AnalysisStageSet previous = 0;
+    while (stages != previous) {
+        previous = stages;
+        for (uint8_t i = 0; i <= static_cast<uint8_t>(AnalysisStage::Context); ++i) {
+            if (hasStage(stages, static_cast<AnalysisStage>(i))) {
+                stages |= stagePrerequisites(static_cast<AnalysisStage>(i));
+            }
+        }
+    }
+    return stages;
+}
+
+inline bool parseOutputFormat(const std::string& name, OutputFormat& format) {
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+
+    if (lower == "json") {
+        format = OutputFormat::JSON;
+    } else if (lower == "markdown" || lower == "md") {
+        format = OutputFormat::Markdown;
+    } else if (lower == "llm" || lower == "prompt") {
+        format = OutputFormat::LLMPrompt;
+    } else if (lower == "all") {
+        format = OutputFormat::All;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static_assert(stagesForArtifacts(artifactBit(OutputArtifact::ProjectMetadata)) ==
+              (stageBit(AnalysisStage::Dependencies) | stageBit(AnalysisStage::Lifecycle) |
+               stageBit(AnalysisStage::Patterns) | stageBit(AnalysisStage::Metadata)),
+              "Metadata export must pull in its analysis prerequisites");
+
+} // namespace UnityContextGen
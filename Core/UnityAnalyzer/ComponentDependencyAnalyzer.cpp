@@ -9,19 +9,19 @@ ComponentDependencyAnalyzer::ComponentDependencyAnalyzer() {
 }
 
 void ComponentDependencyAnalyzer::addMonoBehaviour(const MonoBehaviourInfo& mb_info) {
-    m_components[mb_info.class_name] = mb_info;
+    m_component_complexity[mb_info.class_name] = computeComplexityScore(mb_info);
     extractDependenciesFromComponent(mb_info);
 }
 
 void ComponentDependencyAnalyzer::analyzeProject(const std::vector<MonoBehaviourInfo>& monobehaviours) {
     m_dependencies.clear();
-    m_components.clear();
+    m_component_complexity.clear();
     
     for (const auto& mb_info : monobehaviours) {
         addMonoBehaviour(mb_info);
     }
     
-    analyzeCrossComponentReferences();
+    analyzeCrossComponentReferences(monobehaviours);
 }
 
 void ComponentDependencyAnalyzer::extractDependenciesFromComponent(const MonoBehaviourInfo& mb_info) {
@@ -54,16 +54,14 @@ void ComponentDependencyAnalyzer::extractDependenciesFromComponent(const MonoBeh
     }
 }
 
-void ComponentDependencyAnalyzer::analyzeCrossComponentReferences() {
-    for (auto& comp_pair : m_components) {
-        const auto& mb_info = comp_pair.second;
-        
+void ComponentDependencyAnalyzer::analyzeCrossComponentReferences(const std::vector<MonoBehaviourInfo>& monobehaviours) {
+    for (const auto& mb_info : monobehaviours) {
         for (const auto& field : mb_info.serialized_fields) {
             size_t colon_pos = field.find(" : ");
             if (colon_pos != std::string::npos) {
                 std::string field_type = field.substr(colon_pos + 3);
                 
-                if (m_components.count(field_type) > 0) {
+                if (m_component_complexity.count(field_type) > 0) {
                     ComponentDependency dep;
                     dep.source_component = mb_info.class_name;
                     dep.target_component = field_type;
@@ -139,7 +137,7 @@ bool ComponentDependencyAnalyzer::hasCyclicDependencies() const {
     std::set<std::string> visited;
     std::set<std::string> visiting;
     
-    for (const auto& comp_pair : m_components) {
+    for (const auto& comp_pair : m_component_complexity) {
         const std::string& component = comp_pair.first;
         if (visited.find(component) == visited.end()) {
             if (hasCyclicDependenciesRecursive(component, visiting, visited, graph)) {
@@ -188,7 +186,7 @@ std::vector<std::string> ComponentDependencyAnalyzer::getTopologicalOrder() cons
     std::vector<std::string> result;
     std::set<std::string> visited;
     
-    for (const auto& comp_pair : m_components) {
+    for (const auto& comp_pair : m_component_complexity) {
         const std::string& component = comp_pair.first;
         if (visited.find(component) == visited.end()) {
             topologicalSortRecursive(component, visited, result, graph);
@@ -218,22 +216,17 @@ void ComponentDependencyAnalyzer::topologicalSortRecursive(const std::string& co
 }
 
 std::map<std::string, int> ComponentDependencyAnalyzer::calculateComponentComplexity() const {
-    std::map<std::string, int> complexity;
-    
-    for (const auto& comp_pair : m_components) {
-        const std::string& comp_name = comp_pair.first;
-        const MonoBehaviourInfo& mb_info = comp_pair.second;
-        
-        int score = 0;
-        score += mb_info.unity_methods.size() * 2;
-        score += mb_info.custom_methods.size();
-        score += mb_info.component_dependencies.size() * 3;
-        score += mb_info.serialized_fields.size();
-        
-        complexity[comp_name] = score;
-    }
+    return m_component_complexity;
+}
+
+int ComponentDependencyAnalyzer::computeComplexityScore(const MonoBehaviourInfo& mb_info) const {
+    int score = 0;
+    score += mb_info.unity_methods.size() * 2;
+    score += mb_info.custom_methods.size();
+    score += mb_info.component_dependencies.size() * 3;
+    score += mb_info.serialized_fields.size();
     
-    return complexity;
+    return score;
 }
 
 } // namespace Unity
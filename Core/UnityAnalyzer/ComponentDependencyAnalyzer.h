@@ -45,10 +45,12 @@ public:
 
 private:
     std::vector<ComponentDependency> m_dependencies;
-    std::map<std::string, MonoBehaviourInfo> m_components;
+    // Only the per-component complexity is kept; MonoBehaviourInfo is never copied
+    std::map<std::string, int> m_component_complexity;
     
     void extractDependenciesFromComponent(const MonoBehaviourInfo& mb_info);
-    void analyzeCrossComponentReferences();
+    void analyzeCrossComponentReferences(const std::vector<MonoBehaviourInfo>& monobehaviours);
+    int computeComplexityScore(const MonoBehaviourInfo& mb_info) const;
     
     bool hasCyclicDependenciesRecursive(const std::string& component, 
                                        std::set<std::string>& visiting,
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <string_view>
+
+namespace UnityContextGen {
+namespace Unity {
+
+// Bitmap of structural traits detected once per component while parsing.
+using ComponentFeatureSet = uint64_t;
+
+enum class ComponentFeature : uint8_t {
+    StaticInstanceField,
+    InstanceAccessor,
+    DontDestroyOnLoad,
+    PoolCollection,
+    PoolMethods,
+    SetActiveCalls,
+    InstantiateCalls,
+    EventFields,
+    EventRaiseMethods,
+    SubscribeMethods,
+    StateNamed,
+    StateTransitions,
+    ServiceNamed,
+    FactoryNamed,
+    CommandNamed,
+    ExecuteMethods,
+    ControllerNamed,
+    ViewNamed,
+    ModelNamed,
+    EntityNamed,
+    ComponentNamed,
+    SystemNamed,
+    ManyComponentDependencies,
+    Coroutines,
+    FindObjectCalls
+};
+
+constexpr ComponentFeatureSet featureBit(ComponentFeature feature) {
+    return ComponentFeatureSet{1} << static_cast<uint8_t>(feature);
+}
+
+constexpr ComponentFeatureSet featureSet(std::initializer_list<ComponentFeature> features) {
+    ComponentFeatureSet set = 0;
+    for (ComponentFeature feature : features) {
+        set |= featureBit(feature);
+    }
+    return set;
+}
+
+constexpr bool hasFeature(ComponentFeatureSet set, ComponentFeature feature) {
+    return (set & featureBit(feature)) != 0;
+}
+
+struct ComponentFeatureName {
+    std::string_view name;
+    ComponentFeature feature;
+};
+
+// Names used by pattern rule files
+inline constexpr ComponentFeatureName COMPONENT_FEATURE_NAMES[] = {
+    {"static_instance_field", ComponentFeature::StaticInstanceField},
+    {"instance_accessor", ComponentFeature::InstanceAccessor},
+    {"dont_destroy_on_load", ComponentFeature::DontDestroyOnLoad},
+    {"pool_collection", ComponentFeature::PoolCollection},
+    {"pool_methods", ComponentFeature::PoolMethods},
+    {"set_active_calls", ComponentFeature::SetActiveCalls},
+    {"instantiate_calls", ComponentFeature::InstantiateCalls},
+    {"event_fields", ComponentFeature::EventFields},
+    {"event_raise_methods", ComponentFeature::EventRaiseMethods},
+    {"subscribe_methods", ComponentFeature::SubscribeMethods},
+    {"state_named", ComponentFeature::StateNamed},
+    {"state_transitions", ComponentFeature::StateTransitions},
+    {"service_named", ComponentFeature::ServiceNamed},
+    {"factory_named", ComponentFeature::FactoryNamed},
+    {"command_named", ComponentFeature::CommandNamed},
+    {"execute_methods", ComponentFeature::ExecuteMethods},
+    {"controller_named", ComponentFeature::ControllerNamed},
+    {"view_named", ComponentFeature::ViewNamed},
+    {"model_named", ComponentFeature::ModelNamed},
+    {"entity_named", ComponentFeature::EntityNamed},
+    {"component_named", ComponentFeature::ComponentNamed},
+    {"system_named", ComponentFeature::SystemNamed},
+    {"many_component_dependencies", ComponentFeature::ManyComponentDependencies},
+    {"coroutines", ComponentFeature::Coroutines},
+    {"find_object_calls", ComponentFeature::FindObjectCalls}
+};
+
+static_assert(std::size(COMPONENT_FEATURE_NAMES) <= 64, "Component features must fit in a 64-bit set");
+
+} // namespace Unity
+} // namespace UnityContextGen
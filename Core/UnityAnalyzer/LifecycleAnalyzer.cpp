@@ -4,76 +4,6 @@
 namespace UnityContextGen {
 namespace Unity {
 
-const std::map<std::string, LifecyclePhase> LifecycleAnalyzer::METHOD_PHASES = {
-    {"Awake", LifecyclePhase::Initialization},
-    {"Start", LifecyclePhase::Initialization},
-    {"OnEnable", LifecyclePhase::Activation},
-    {"Update", LifecyclePhase::FrameUpdate},
-    {"FixedUpdate", LifecyclePhase::PhysicsUpdate},
-    {"LateUpdate", LifecyclePhase::LateFrameUpdate},
-    {"OnTriggerEnter", LifecyclePhase::PhysicsEvent},
-    {"OnTriggerExit", LifecyclePhase::PhysicsEvent},
-    {"OnTriggerStay", LifecyclePhase::PhysicsEvent},
-    {"OnCollisionEnter", LifecyclePhase::PhysicsEvent},
-    {"OnCollisionExit", LifecyclePhase::PhysicsEvent},
-    {"OnCollisionStay", LifecyclePhase::PhysicsEvent},
-    {"OnTriggerEnter2D", LifecyclePhase::PhysicsEvent},
-    {"OnTriggerExit2D", LifecyclePhase::PhysicsEvent},
-    {"OnTriggerStay2D", LifecyclePhase::PhysicsEvent},
-    {"OnCollisionEnter2D", LifecyclePhase::PhysicsEvent},
-    {"OnCollisionExit2D", LifecyclePhase::PhysicsEvent},
-    {"OnCollisionStay2D", LifecyclePhase::PhysicsEvent},
-    {"OnMouseDown", LifecyclePhase::InputEvent},
-    {"OnMouseUp", LifecyclePhase::InputEvent},
-    {"OnMouseEnter", LifecyclePhase::InputEvent},
-    {"OnMouseExit", LifecyclePhase::InputEvent},
-    {"OnMouseOver", LifecyclePhase::InputEvent},
-    {"OnMouseDrag", LifecyclePhase::InputEvent},
-    {"OnMouseUpAsButton", LifecyclePhase::InputEvent},
-    {"OnPreRender", LifecyclePhase::RenderingEvent},
-    {"OnPostRender", LifecyclePhase::RenderingEvent},
-    {"OnRenderObject", LifecyclePhase::RenderingEvent},
-    {"OnWillRenderObject", LifecyclePhase::RenderingEvent},
-    {"OnBecameVisible", LifecyclePhase::RenderingEvent},
-    {"OnBecameInvisible", LifecyclePhase::RenderingEvent},
-    {"OnDrawGizmos", LifecyclePhase::RenderingEvent},
-    {"OnDrawGizmosSelected", LifecyclePhase::RenderingEvent},
-    {"OnDisable", LifecyclePhase::Deactivation},
-    {"OnDestroy", LifecyclePhase::Cleanup}
-};
-
-const std::map<std::string, int> LifecycleAnalyzer::METHOD_EXECUTION_ORDER = {
-    {"Awake", 1},
-    {"OnEnable", 2},
-    {"Start", 3},
-    {"Update", 100},
-    {"FixedUpdate", 101},
-    {"LateUpdate", 102},
-    {"OnTriggerEnter", 200},
-    {"OnTriggerStay", 201},
-    {"OnTriggerExit", 202},
-    {"OnCollisionEnter", 203},
-    {"OnCollisionStay", 204},
-    {"OnCollisionExit", 205},
-    {"OnMouseDown", 300},
-    {"OnMouseUp", 301},
-    {"OnMouseEnter", 302},
-    {"OnMouseExit", 303},
-    {"OnMouseOver", 304},
-    {"OnMouseDrag", 305},
-    {"OnMouseUpAsButton", 306},
-    {"OnPreRender", 400},
-    {"OnWillRenderObject", 401},
-    {"OnRenderObject", 402},
-    {"OnPostRender", 403},
-    {"OnBecameVisible", 404},
-    {"OnBecameInvisible", 405},
-    {"OnDrawGizmos", 406},
-    {"OnDrawGizmosSelected", 407},
-    {"OnDisable", 500},
-    {"OnDestroy", 501}
-};
-
 LifecycleAnalyzer::LifecycleAnalyzer() {
 }
 
@@ -119,17 +49,17 @@ void LifecycleAnalyzer::analyzeProject(const std::vector<MonoBehaviourInfo>& mon
 }
 
 LifecyclePhase LifecycleAnalyzer::getMethodPhase(const std::string& method_name) const {
-    auto it = METHOD_PHASES.find(method_name);
-    if (it != METHOD_PHASES.end()) {
-        return it->second;
+    const UnityCallbackInfo* callback = findUnityCallback(method_name);
+    if (callback) {
+        return callback->phase;
     }
     return LifecyclePhase::Custom;
 }
 
 int LifecycleAnalyzer::getMethodExecutionOrder(const std::string& method_name) const {
-    auto it = METHOD_EXECUTION_ORDER.find(method_name);
-    if (it != METHOD_EXECUTION_ORDER.end()) {
-        return it->second;
+    const UnityCallbackInfo* callback = findUnityCallback(method_name);
+    if (callback) {
+        return callback->execution_order;
     }
     return 1000;
 }
@@ -293,9 +223,15 @@ std::string LifecycleAnalyzer::generatePhaseDescription(LifecyclePhase phase) co
         case LifecyclePhase::FrameUpdate: return "Frame Update";
         case LifecyclePhase::PhysicsUpdate: return "Physics Update";
         case LifecyclePhase::LateFrameUpdate: return "Late Frame Update";
+        case LifecyclePhase::AnimationUpdate: return "Animation Update";
         case LifecyclePhase::PhysicsEvent: return "Physics Events";
         case LifecyclePhase::InputEvent: return "Input Events";
         case LifecyclePhase::RenderingEvent: return "Rendering Events";
+        case LifecyclePhase::AudioEvent: return "Audio Events";
+        case LifecyclePhase::ParticleEvent: return "Particle Events";
+        case LifecyclePhase::HierarchyEvent: return "Hierarchy Events";
+        case LifecyclePhase::ApplicationEvent: return "Application Events";
+        case LifecyclePhase::EditorEvent: return "Editor Events";
         case LifecyclePhase::Deactivation: return "Deactivation";
         case LifecyclePhase::Cleanup: return "Cleanup";
         case LifecyclePhase::Custom: return "Custom";
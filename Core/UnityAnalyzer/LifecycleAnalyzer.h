@@ -8,20 +8,6 @@
 namespace UnityContextGen {
 namespace Unity {
 
-enum class LifecyclePhase {
-    Initialization,
-    Activation,
-    FrameUpdate,
-    PhysicsUpdate,
-    LateFrameUpdate,
-    PhysicsEvent,
-    InputEvent,
-    RenderingEvent,
-    Deactivation,
-    Cleanup,
-    Custom
-};
-
 struct LifecycleMethodInfo {
     std::string method_name;
     std::string class_name;
@@ -59,9 +45,6 @@ public:
 private:
     std::map<std::string, LifecycleFlow> m_component_lifecycles;
     
-    static const std::map<std::string, LifecyclePhase> METHOD_PHASES;
-    static const std::map<std::string, int> METHOD_EXECUTION_ORDER;
-    
     LifecyclePhase getMethodPhase(const std::string& method_name) const;
     int getMethodExecutionOrder(const std::string& method_name) const;
     
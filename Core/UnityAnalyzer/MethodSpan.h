@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace UnityContextGen {
+namespace Unity {
+
+// 1-based, inclusive line span of a method declaration
+struct MethodSpan {
+    std::string name;
+    size_t start_line;
+    size_t end_line;
+};
+
+} // namespace Unity
+} // namespace UnityContextGen
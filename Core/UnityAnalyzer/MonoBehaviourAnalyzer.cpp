@@ -1,55 +1,80 @@
 #include "MonoBehaviourAnalyzer.h"
 #include <algorithm>
+#include <cctype>
 #include <regex>
 #include <iostream>
 
 namespace UnityContextGen {
 namespace Unity {
 
-const std::set<std::string> MonoBehaviourAnalyzer::UNITY_LIFECYCLE_METHODS = {
-    "Awake", "Start", "Update", "FixedUpdate", "LateUpdate", 
-    "OnEnable", "OnDisable", "OnDestroy"
+struct FeatureKeyword {
+    const char* keyword;
+    ComponentFeature feature;
 };
 
-const std::set<std::string> MonoBehaviourAnalyzer::UNITY_EVENT_METHODS = {
-    "OnTriggerEnter", "OnTriggerExit", "OnTriggerStay",
-    "OnCollisionEnter", "OnCollisionExit", "OnCollisionStay",
-    "OnTriggerEnter2D", "OnTriggerExit2D", "OnTriggerStay2D",
-    "OnCollisionEnter2D", "OnCollisionExit2D", "OnCollisionStay2D"
+static const FeatureKeyword CLASS_NAME_FEATURES[] = {
+    {"State", ComponentFeature::StateNamed},
+    {"Service", ComponentFeature::ServiceNamed},
+    {"Manager", ComponentFeature::ServiceNamed},
+    {"Factory", ComponentFeature::FactoryNamed},
+    {"Creator", ComponentFeature::FactoryNamed},
+    {"Builder", ComponentFeature::FactoryNamed},
+    {"Command", ComponentFeature::CommandNamed},
+    {"Action", ComponentFeature::CommandNamed},
+    {"Controller", ComponentFeature::ControllerNamed},
+    {"View", ComponentFeature::ViewNamed},
+    {"Model", ComponentFeature::ModelNamed},
+    {"Entity", ComponentFeature::EntityNamed},
+    {"Component", ComponentFeature::ComponentNamed},
+    {"System", ComponentFeature::SystemNamed}
 };
 
-const std::set<std::string> MonoBehaviourAnalyzer::UNITY_PHYSICS_METHODS = {
-    "FixedUpdate", "OnCollisionEnter", "OnCollisionExit", "OnCollisionStay",
-    "OnTriggerEnter", "OnTriggerExit", "OnTriggerStay",
-    "OnCollisionEnter2D", "OnCollisionExit2D", "OnCollisionStay2D",
-    "OnTriggerEnter2D", "OnTriggerExit2D", "OnTriggerStay2D"
+static const FeatureKeyword METHOD_NAME_FEATURES[] = {
+    {"Get", ComponentFeature::PoolMethods},
+    {"Return", ComponentFeature::PoolMethods},
+    {"Pool", ComponentFeature::PoolMethods},
+    {"Spawn", ComponentFeature::PoolMethods},
+    {"Release", ComponentFeature::PoolMethods},
+    {"Event", ComponentFeature::EventRaiseMethods},
+    {"Notify", ComponentFeature::EventRaiseMethods},
+    {"Raise", ComponentFeature::EventRaiseMethods},
+    {"Broadcast", ComponentFeature::EventRaiseMethods},
+    {"Subscribe", ComponentFeature::SubscribeMethods},
+    {"Listen", ComponentFeature::SubscribeMethods},
+    {"Register", ComponentFeature::SubscribeMethods},
+    {"ChangeState", ComponentFeature::StateTransitions},
+    {"SetState", ComponentFeature::StateTransitions},
+    {"TransitionTo", ComponentFeature::StateTransitions},
+    {"EnterState", ComponentFeature::StateTransitions},
+    {"ExitState", ComponentFeature::StateTransitions},
+    {"Execute", ComponentFeature::ExecuteMethods},
+    {"Undo", ComponentFeature::ExecuteMethods},
+    {"Redo", ComponentFeature::ExecuteMethods}
 };
 
-const std::set<std::string> MonoBehaviourAnalyzer::UNITY_RENDERING_METHODS = {
-    "OnPreRender", "OnPostRender", "OnRenderObject", "OnWillRenderObject",
-    "OnBecameVisible", "OnBecameInvisible", "OnDrawGizmos", "OnDrawGizmosSelected"
+// Matched against the declared type's simple name, without namespace or generic arguments
+static const FeatureKeyword FIELD_TYPE_FEATURES[] = {
+    {"ObjectPool", ComponentFeature::PoolCollection},
+    {"IObjectPool", ComponentFeature::PoolCollection},
+    {"Queue", ComponentFeature::PoolCollection},
+    {"Stack", ComponentFeature::PoolCollection},
+    {"UnityEvent", ComponentFeature::EventFields},
+    {"Action", ComponentFeature::EventFields},
+    {"EventHandler", ComponentFeature::EventFields}
 };
 
-const std::set<std::string> MonoBehaviourAnalyzer::UNITY_INPUT_METHODS = {
-    "OnMouseDown", "OnMouseUp", "OnMouseEnter", "OnMouseExit", "OnMouseOver",
-    "OnMouseDrag", "OnMouseUpAsButton"
-};
-
-const std::map<std::string, std::string> MonoBehaviourAnalyzer::METHOD_EXECUTION_PHASES = {
-    {"Awake", "Initialization"},
-    {"Start", "Initialization"},
-    {"OnEnable", "Activation"},
-    {"Update", "Frame Update"},
-    {"FixedUpdate", "Physics Update"},
-    {"LateUpdate", "Late Frame Update"},
-    {"OnDisable", "Deactivation"},
-    {"OnDestroy", "Cleanup"},
-    {"OnTriggerEnter", "Physics Event"},
-    {"OnTriggerExit", "Physics Event"},
-    {"OnTriggerStay", "Physics Event"},
-    {"OnCollisionEnter", "Physics Event"},
-    {"OnCollisionExit", "Physics Event"},
-    {"OnCollisionStay", "Physics Event"}
+static const FeatureKeyword SOURCE_FEATURES[] = {
+    {"DontDestroyOnLoad(", ComponentFeature::DontDestroyOnLoad},
+    {"SetActive(", ComponentFeature::SetActiveCalls},
+    {"Instantiate(", ComponentFeature::InstantiateCalls},
+    {" event ", ComponentFeature::EventFields},
+    {".AddListener(", ComponentFeature::SubscribeMethods},
+    {"StartCoroutine(", ComponentFeature::Coroutines},
+    {"IEnumerator ", ComponentFeature::Coroutines},
+    {"FindObjectOfType", ComponentFeature::FindObjectCalls},
+    {"FindObjectsOfType", ComponentFeature::FindObjectCalls},
+    {"FindFirstObjectByType", ComponentFeature::FindObjectCalls},
+    {"FindAnyObjectByType", ComponentFeature::FindObjectCalls}
 };
 
 MonoBehaviourAnalyzer::MonoBehaviourAnalyzer() {
@@ -103,17 +128,13 @@ bool MonoBehaviourAnalyzer::isMonoBehaviour(const TreeSitter::ClassInfo& class_i
 }
 
 bool MonoBehaviourAnalyzer::isUnityMethod(const std::string& method_name) const {
-    return UNITY_LIFECYCLE_METHODS.count(method_name) > 0 ||
-           UNITY_EVENT_METHODS.count(method_name) > 0 ||
-           UNITY_PHYSICS_METHODS.count(method_name) > 0 ||
-           UNITY_RENDERING_METHODS.count(method_name) > 0 ||
-           UNITY_INPUT_METHODS.count(method_name) > 0;
+    return findUnityCallback(method_name) != nullptr;
 }
 
 std::string MonoBehaviourAnalyzer::getMethodExecutionPhase(const std::string& method_name) const {
-    auto it = METHOD_EXECUTION_PHASES.find(method_name);
-    if (it != METHOD_EXECUTION_PHASES.end()) {
-        return it->second;
+    const UnityCallbackInfo* callback = findUnityCallback(method_name);
+    if (callback) {
+        return std::string(getLifecyclePhaseName(callback->phase));
     }
     return "Custom";
 }
@@ -130,6 +151,10 @@ void MonoBehaviourAnalyzer::analyzeMonoBehaviour(const TreeSitter::ClassInfo& cl
     mb_info.end_line = class_info.end_line;
     
     for (const auto& method : methods) {
+        if (method.start_line >= class_info.start_line && method.end_line <= class_info.end_line) {
+            mb_info.method_spans.push_back({method.name, method.start_line, method.end_line});
+        }
+        
         if (isUnityMethod(method.name)) {
             mb_info.unity_methods.push_back(method.name);
             mb_info.method_purposes[method.name] = inferMethodPurpose(method.name, method);
@@ -157,6 +182,10 @@ void MonoBehaviourAnalyzer::analyzeMonoBehaviour(const TreeSitter::ClassInfo& cl
                                          required_components.begin(),
                                          required_components.end());
     
+    std::string class_source = extractLineRange(source_code, class_info.start_line, class_info.end_line);
+    mb_info.features = extractComponentFeatures(class_info, methods, fields, class_source,
+                                                mb_info.component_dependencies.size());
+    
     m_monobehaviours.push_back(mb_info);
 }
 
@@ -260,6 +289,119 @@ std::vector<std::string> MonoBehaviourAnalyzer::extractSerializedFields(const st
     return serialized_fields;
 }
 
+// "System.Collections.Generic.Queue<GameObject>[]" -> "Queue"
+static std::string simpleTypeName(const std::string& type) {
+    std::string name = type.substr(0, type.find_first_of("<[?"));
+    size_t last_dot = name.rfind('.');
+    if (last_dot != std::string::npos) {
+        name = name.substr(last_dot + 1);
+    }
+    name.erase(std::remove_if(name.begin(), name.end(), [](unsigned char c) { return std::isspace(c); }), name.end());
+    return name;
+}
+
+ComponentFeatureSet MonoBehaviourAnalyzer::extractComponentFeatures(const TreeSitter::ClassInfo& class_info,
+                                                                  const std::vector<TreeSitter::MethodInfo>& methods,
+                                                                  const std::vector<TreeSitter::FieldInfo>& fields,
+                                                                  const std::string& class_source,
+                                                                  size_t dependency_count) const {
+    ComponentFeatureSet features = 0;
+    
+    for (const auto& entry : CLASS_NAME_FEATURES) {
+        if (class_info.name.find(entry.keyword) != std::string::npos) {
+            features |= featureBit(entry.feature);
+        }
+    }
+    
+    for (const auto& method : methods) {
+        if (isUnityMethod(method.name)) {
+            continue;
+        }
+        if (method.name == "Instance" || method.name == "GetInstance") {
+            features |= featureBit(ComponentFeature::InstanceAccessor);
+        }
+        for (const auto& entry : METHOD_NAME_FEATURES) {
+            if (method.name.find(entry.keyword) != std::string::npos) {
+                features |= featureBit(entry.feature);
+            }
+        }
+    }
+    
+    for (const auto& property : class_info.properties) {
+        if (property == "Instance") {
+            features |= featureBit(ComponentFeature::InstanceAccessor);
+        }
+    }
+    
+    for (const auto& field : fields) {
+        if (field.is_static &&
+            (field.type == class_info.name || field.name.find("instance") != std::string::npos ||
+             field.name.find("Instance") != std::string::npos)) {
+            features |= featureBit(ComponentFeature::StaticInstanceField);
+        }
+        std::string type_name = simpleTypeName(field.type);
+        for (const auto& entry : FIELD_TYPE_FEATURES) {
+            if (type_name == entry.keyword) {
+                features |= featureBit(entry.feature);
+            }
+        }
+        // Project pool types such as BulletPool
+        if (type_name.size() > 4 && type_name.compare(type_name.size() - 4, 4, "Pool") == 0) {
+            features |= featureBit(ComponentFeature::PoolCollection);
+        }
+    }
+    
+    for (const auto& entry : SOURCE_FEATURES) {
+        if (class_source.find(entry.keyword) != std::string::npos) {
+            features |= featureBit(entry.feature);
+        }
+    }
+    
+    // Field types and properties are not reported by every grammar version, so fall back to the declaration text
+    if (class_source.find("static " + class_info.name + " ") != std::string::npos) {
+        features |= featureBit(ComponentFeature::StaticInstanceField);
+    }
+    if (class_source.find("static " + class_info.name + " Instance") != std::string::npos) {
+        features |= featureBit(ComponentFeature::InstanceAccessor);
+    }
+    
+    if (dependency_count >= 3) {
+        features |= featureBit(ComponentFeature::ManyComponentDependencies);
+    }
+    
+    return features;
+}
+
+std::string MonoBehaviourAnalyzer::extractLineRange(const std::string& source_code, size_t start_line, size_t end_line) const {
+    if (start_line == 0 || end_line < start_line) {
+        return source_code;
+    }
+    
+    size_t line = 1;
+    size_t begin = 0;
+    while (line < start_line && begin < source_code.size()) {
+        size_t newline = source_code.find('\n', begin);
+        if (newline == std::string::npos) {
+            return source_code;
+        }
+        begin = newline + 1;
+        ++line;
+    }
+    
+    size_t end = begin;
+    while (line <= end_line && end < source_code.size()) {
+        size_t newline = source_code.find('\n', end);
+        if (newline == std::string::npos) {
+            end = source_code.size();
+            break;
+        }
+        end = newline + 1;
+        ++line;
+    }
+    
+    return source_code.substr(begin, end - begin);
+}
+
 bool MonoBehaviourAnalyzer::hasUnityAttribute(const std::vector<std::string>& attributes, const std::string& attr_name) const {
     for (const auto& attr : attributes) {
         if (attr.find(attr_name) != std::string::npos) {
@@ -269,10 +411,16 @@ bool MonoBehaviourAnalyzer::hasUnityAttribute(const std::vector<std::string>& at
     return false;
 }
 
-std::vector<MonoBehaviourInfo> MonoBehaviourAnalyzer::getMonoBehaviours() const {
+const std::vector<MonoBehaviourInfo>& MonoBehaviourAnalyzer::getMonoBehaviours() const {
     return m_monobehaviours;
 }
 
+std::vector<MonoBehaviourInfo> MonoBehaviourAnalyzer::takeMonoBehaviours() {
+    std::vector<MonoBehaviourInfo> monobehaviours = std::move(m_monobehaviours);
+    m_monobehaviours.clear();
+    return monobehaviours;
+}
+
 std::vector<UnityMethodInfo> MonoBehaviourAnalyzer::getUnityMethods() const {
     return m_unity_methods;
 }
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "../TreeSitterEngine/CSharpParser.h"
+#include "UnityCallbackCatalog.h"
+#include "ComponentFeatures.h"
+#include "MethodSpan.h"
 #include <string>
 #include <vector>
 #include <map>
@@ -18,8 +21,10 @@ struct MonoBehaviourInfo {
     std::vector<std::string> component_dependencies;
     std::vector<std::string> attributes;
     std::map<std::string, std::string> method_purposes;
+    std::vector<MethodSpan> method_spans; // Every method declared inside the class
     size_t start_line;
     size_t end_line;
+    ComponentFeatureSet features = 0;
 };
 
 struct UnityMethodInfo {
@@ -40,7 +45,8 @@ public:
     bool analyzeFile(const std::string& file_path);
     bool analyzeCode(const std::string& source_code, const std::string& file_path = "");
     
-    std::vector<MonoBehaviourInfo> getMonoBehaviours() const;
+    const std::vector<MonoBehaviourInfo>& getMonoBehaviours() const;
+    std::vector<MonoBehaviourInfo> takeMonoBehaviours();
     std::vector<UnityMethodInfo> getUnityMethods() const;
     
     bool isMonoBehaviour(const TreeSitter::ClassInfo& class_info) const;
@@ -49,20 +55,17 @@ public:
     std::string getMethodExecutionPhase(const std::string& method_name) const;
     std::vector<std::string> extractComponentDependencies(const std::string& source_code) const;
     std::vector<std::string> extractSerializedFields(const std::vector<TreeSitter::FieldInfo>& fields) const;
+    ComponentFeatureSet extractComponentFeatures(const TreeSitter::ClassInfo& class_info,
+                                                 const std::vector<TreeSitter::MethodInfo>& methods,
+                                                 const std::vector<TreeSitter::FieldInfo>& fields,
+                                                 const std::string& class_source,
+                                                 size_t dependency_count) const;
 
 private:
     TreeSitter::CSharpParser m_parser;
     std::vector<MonoBehaviourInfo> m_monobehaviours;
     std::vector<UnityMethodInfo> m_unity_methods;
     
-    static const std::set<std::string> UNITY_LIFECYCLE_METHODS;
-    static const std::set<std::string> UNITY_EVENT_METHODS;
-    static const std::set<std::string> UNITY_PHYSICS_METHODS;
-    static const std::set<std::string> UNITY_RENDERING_METHODS;
-    static const std::set<std::string> UNITY_INPUT_METHODS;
-    
-    static const std::map<std::string, std::string> METHOD_EXECUTION_PHASES;
-    
     void analyzeMonoBehaviour(const TreeSitter::ClassInfo& class_info, 
                              const std::vector<TreeSitter::MethodInfo>& methods,
                              const std::vector<TreeSitter::FieldInfo>& fields,
@@ -75,6 +78,7 @@ private:
     std::vector<std::string> extractRequireComponentAttributes(const std::vector<std::string>& attributes) const;
     
     bool hasUnityAttribute(const std::vector<std::string>& attributes, const std::string& attr_name) const;
+    std::string extractLineRange(const std::string& source_code, size_t start_line, size_t end_line) const;
 };
 
 } // namespace Unity
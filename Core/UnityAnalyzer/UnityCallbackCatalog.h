@@ -0,0 +1,234 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+
+namespace UnityContextGen {
+namespace Unity {
+
+enum class LifecyclePhase {
+    Initialization,
+    Activation,
+    FrameUpdate,
+    PhysicsUpdate,
+    LateFrameUpdate,
+    AnimationUpdate,
+    PhysicsEvent,
+    InputEvent,
+    RenderingEvent,
+    AudioEvent,
+    ParticleEvent,
+    HierarchyEvent,
+    ApplicationEvent,
+    EditorEvent,
+    Deactivation,
+    Cleanup,
+    Custom
+};
+
+enum class UnityCallbackCategory {
+    Lifecycle,
+    Physics,
+    Input,
+    Rendering,
+    Animation,
+    Audio,
+    Particle,
+    Hierarchy,
+    Application,
+    Editor
+};
+
+struct UnityCallbackInfo {
+    std::string_view name;
+    LifecyclePhase phase;
+    int execution_order;
+    UnityCallbackCategory category;
+};
+
+// Every message Unity sends to a MonoBehaviour (legacy networking messages excluded).
+// Execution order is relative: lower values run earlier within a frame.
+inline constexpr UnityCallbackInfo UNITY_CALLBACKS[] = {
+    // Editor
+    {"Reset", LifecyclePhase::EditorEvent, 0, UnityCallbackCategory::Editor},
+    {"OnValidate", LifecyclePhase::EditorEvent, 0, UnityCallbackCategory::Editor},
+
+    // Lifecycle
+    {"Awake", LifecyclePhase::Initialization, 1, UnityCallbackCategory::Lifecycle},
+    {"OnEnable", LifecyclePhase::Activation, 2, UnityCallbackCategory::Lifecycle},
+    {"Start", LifecyclePhase::Initialization, 3, UnityCallbackCategory::Lifecycle},
+    {"Update", LifecyclePhase::FrameUpdate, 100, UnityCallbackCategory::Lifecycle},
+    {"FixedUpdate", LifecyclePhase::PhysicsUpdate, 101, UnityCallbackCategory::Lifecycle},
+    {"LateUpdate", LifecyclePhase::LateFrameUpdate, 102, UnityCallbackCategory::Lifecycle},
+    {"OnDisable", LifecyclePhase::Deactivation, 500, UnityCallbackCategory::Lifecycle},
+    {"OnDestroy", LifecyclePhase::Cleanup, 501, UnityCallbackCategory::Lifecycle},
+
+    // Animation
+    {"OnAnimatorMove", LifecyclePhase::AnimationUpdate, 103, UnityCallbackCategory::Animation},
+    {"OnAnimatorIK", LifecyclePhase::AnimationUpdate, 104, UnityCallbackCategory::Animation},
+    {"OnDidApplyAnimationProperties", LifecyclePhase::AnimationUpdate, 105, UnityCallbackCategory::Animation},
+
+    // Physics
+    {"OnTriggerEnter", LifecyclePhase::PhysicsEvent, 200, UnityCallbackCategory::Physics},
+    {"OnTriggerStay", LifecyclePhase::PhysicsEvent, 201, UnityCallbackCategory::Physics},
+    {"OnTriggerExit", LifecyclePhase::PhysicsEvent, 202, UnityCallbackCategory::Physics},
+    {"OnCollisionEnter", LifecyclePhase::PhysicsEvent, 203, UnityCallbackCategory::Physics},
+    {"OnCollisionStay", LifecyclePhase::PhysicsEvent, 204, UnityCallbackCategory::Physics},
+    {"OnCollisionExit", LifecyclePhase::PhysicsEvent, 205, UnityCallbackCategory::Physics},
+    {"OnControllerColliderHit", LifecyclePhase::PhysicsEvent, 206, UnityCallbackCategory::Physics},
+    {"OnJointBreak", LifecyclePhase::PhysicsEvent, 207, UnityCallbackCategory::Physics},
+    {"OnTriggerEnter2D", LifecyclePhase::PhysicsEvent, 210, UnityCallbackCategory::Physics},
+    {"OnTriggerStay2D", LifecyclePhase::PhysicsEvent, 211, UnityCallbackCategory::Physics},
+    {"OnTriggerExit2D", LifecyclePhase::PhysicsEvent, 212, UnityCallbackCategory::Physics},
+    {"OnCollisionEnter2D", LifecyclePhase::PhysicsEvent, 213, UnityCallbackCategory::Physics},
+    {"OnCollisionStay2D", LifecyclePhase::PhysicsEvent, 214, UnityCallbackCategory::Physics},
+    {"OnCollisionExit2D", LifecyclePhase::PhysicsEvent, 215, UnityCallbackCategory::Physics},
+    {"OnJointBreak2D", LifecyclePhase::PhysicsEvent, 216, UnityCallbackCategory::Physics},
+
+    // Particles
+    {"OnParticleCollision", LifecyclePhase::PhysicsEvent, 217, UnityCallbackCategory::Particle},
+    {"OnParticleTrigger", LifecyclePhase::PhysicsEvent, 218, UnityCallbackCategory::Particle},
+    {"OnParticleSystemStopped", LifecyclePhase::ParticleEvent, 219, UnityCallbackCategory::Particle},
+    {"OnParticleUpdateJobScheduled", LifecyclePhase::ParticleEvent, 220, UnityCallbackCategory::Particle},
+
+    // Input
+    {"OnMouseDown", LifecyclePhase::InputEvent, 300, UnityCallbackCategory::Input},
+    {"OnMouseUp", LifecyclePhase::InputEvent, 301, UnityCallbackCategory::Input},
+    {"OnMouseEnter", LifecyclePhase::InputEvent, 302, UnityCallbackCategory::Input},
+    {"OnMouseExit", LifecyclePhase::InputEvent, 303, UnityCallbackCategory::Input},
+    {"OnMouseOver", LifecyclePhase::InputEvent, 304, UnityCallbackCategory::Input},
+    {"OnMouseDrag", LifecyclePhase::InputEvent, 305, UnityCallbackCategory::Input},
+    {"OnMouseUpAsButton", LifecyclePhase::InputEvent, 306, UnityCallbackCategory::Input},
+
+    // Rendering
+    {"OnPreRender", LifecyclePhase::RenderingEvent, 400, UnityCallbackCategory::Rendering},
+    {"OnWillRenderObject", LifecyclePhase::RenderingEvent, 401, UnityCallbackCategory::Rendering},
+    {"OnRenderObject", LifecyclePhase::RenderingEvent, 402, UnityCallbackCategory::Rendering},
+    {"OnPostRender", LifecyclePhase::RenderingEvent, 403, UnityCallbackCategory::Rendering},
+    {"OnBecameVisible", LifecyclePhase::RenderingEvent, 404, UnityCallbackCategory::Rendering},
+    {"OnBecameInvisible", LifecyclePhase::RenderingEvent, 405, UnityCallbackCategory::Rendering},
+    {"OnDrawGizmos", LifecyclePhase::RenderingEvent, 406, UnityCallbackCategory::Rendering},
+    {"OnDrawGizmosSelected", LifecyclePhase::RenderingEvent, 407, UnityCallbackCategory::Rendering},
+    {"OnPreCull", LifecyclePhase::RenderingEvent, 408, UnityCallbackCategory::Rendering},
+    {"OnRenderImage", LifecyclePhase::RenderingEvent, 409, UnityCallbackCategory::Rendering},
+    {"OnGUI", LifecyclePhase::RenderingEvent, 410, UnityCallbackCategory::Rendering},
+
+    // Hierarchy and UI
+    {"OnTransformChildrenChanged", LifecyclePhase::HierarchyEvent, 420, UnityCallbackCategory::Hierarchy},
+    {"OnBeforeTransformParentChanged", LifecyclePhase::HierarchyEvent, 421, UnityCallbackCategory::Hierarchy},
+    {"OnTransformParentChanged", LifecyclePhase::HierarchyEvent, 422, UnityCallbackCategory::Hierarchy},
+    {"OnRectTransformDimensionsChange", LifecyclePhase::HierarchyEvent, 423, UnityCallbackCategory::Hierarchy},
+    {"OnCanvasGroupChanged", LifecyclePhase::HierarchyEvent, 424, UnityCallbackCategory::Hierarchy},
+    {"OnCanvasHierarchyChanged", LifecyclePhase::HierarchyEvent, 425, UnityCallbackCategory::Hierarchy},
+
+    // Audio
+    {"OnAudioFilterRead", LifecyclePhase::AudioEvent, 440, UnityCallbackCategory::Audio},
+
+    // Application
+    {"OnApplicationFocus", LifecyclePhase::ApplicationEvent, 450, UnityCallbackCategory::Application},
+    {"OnApplicationPause", LifecyclePhase::ApplicationEvent, 451, UnityCallbackCategory::Application},
+    {"OnApplicationQuit", LifecyclePhase::ApplicationEvent, 452, UnityCallbackCategory::Application}
+};
+
+inline constexpr size_t UNITY_CALLBACK_COUNT = std::size(UNITY_CALLBACKS);
+
+namespace detail {
+
+// Open-addressed slot table indexed by a seeded FNV-1a hash. The seed is searched
+// at compile time until every catalog name lands in its own slot, so a lookup is
+// one hash plus one string compare.
+inline constexpr size_t CALLBACK_SLOT_COUNT = 2048;
+inline constexpr uint8_t EMPTY_CALLBACK_SLOT = 0xFF;
+
+static_assert(UNITY_CALLBACK_COUNT < EMPTY_CALLBACK_SLOT, "Callback catalog too large for 8-bit slots");
+static_assert((CALLBACK_SLOT_COUNT & (CALLBACK_SLOT_COUNT - 1)) == 0, "Slot count must be a power of two");
+
+constexpr uint32_t hashCallbackName(std::string_view name, uint32_t seed) {
+    uint32_t hash = 2166136261u ^ (seed * 0x9E3779B9u);
+    for (char c : name) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 16777619u;
+    }
+    hash ^= hash >> 15;
+    return hash;
+}
+
+struct CallbackHashTable {
+    uint32_t seed;
+    std::array<uint8_t, CALLBACK_SLOT_COUNT> slots;
+};
+
+constexpr CallbackHashTable buildCallbackHashTable() {
+    for (uint32_t seed = 1; seed < 4096; ++seed) {
+        CallbackHashTable table{seed, {}};
+        for (size_t slot = 0; slot < CALLBACK_SLOT_COUNT; ++slot) {
+            table.slots[slot] = EMPTY_CALLBACK_SLOT;
+        }
+
+        bool collision = false;
+        for (size_t i = 0; i < UNITY_CALLBACK_COUNT && !collision; ++i) {
+            size_t slot = hashCallbackName(UNITY_CALLBACKS[i].name, seed) & (CALLBACK_SLOT_COUNT - 1);
+            if (table.slots[slot] != EMPTY_CALLBACK_SLOT) {
+                collision = true;
+            } else {
+                table.slots[slot] = static_cast<uint8_t>(i);
+            }
+        }
+
+        if (!collision) {
+            return table;
+        }
+    }
+    return CallbackHashTable{0, {}};
+}
+
+inline constexpr CallbackHashTable CALLBACK_HASH_TABLE = buildCallbackHashTable();
+
+static_assert(CALLBACK_HASH_TABLE.seed != 0, "No collision-free seed found for the callback catalog");
+
+} // namespace detail
+
+constexpr const UnityCallbackInfo* findUnityCallback(std::string_view name) {
+    size_t slot = detail::hashCallbackName(name, detail::CALLBACK_HASH_TABLE.seed) &
+                  (detail::CALLBACK_SLOT_COUNT - 1);
+    uint8_t index = detail::CALLBACK_HASH_TABLE.slots[slot];
+    if (index == detail::EMPTY_CALLBACK_SLOT || UNITY_CALLBACKS[index].name != name) {
+        return nullptr;
+    }
+    return &UNITY_CALLBACKS[index];
+}
+
+constexpr std::string_view getLifecyclePhaseName(LifecyclePhase phase) {
+    switch (phase) {
+        case LifecyclePhase::Initialization: return "Initialization";
+        case LifecyclePhase::Activation: return "Activation";
+        case LifecyclePhase::FrameUpdate: return "Frame Update";
+        case LifecyclePhase::PhysicsUpdate: return "Physics Update";
+        case LifecyclePhase::LateFrameUpdate: return "Late Frame Update";
+        case LifecyclePhase::AnimationUpdate: return "Animation Update";
+        case LifecyclePhase::PhysicsEvent: return "Physics Event";
+        case LifecyclePhase::InputEvent: return "Input Event";
+        case LifecyclePhase::RenderingEvent: return "Rendering Event";
+        case LifecyclePhase::AudioEvent: return "Audio Event";
+        case LifecyclePhase::ParticleEvent: return "Particle Event";
+        case LifecyclePhase::HierarchyEvent: return "Hierarchy Event";
+        case LifecyclePhase::ApplicationEvent: return "Application Event";
+        case LifecyclePhase::EditorEvent: return "Editor Event";
+        case LifecyclePhase::Deactivation: return "Deactivation";
+        case LifecyclePhase::Cleanup: return "Cleanup";
+        case LifecyclePhase::Custom: return "Custom";
+    }
+    return "Custom";
+}
+
+static_assert(findUnityCallback("Awake") != nullptr, "Catalog lookup failed for Awake");
+static_assert(findUnityCallback("Awake")->execution_order == 1, "Catalog lookup returned the wrong entry");
+static_assert(findUnityCallback("OnParticleSystemStopped")->phase == LifecyclePhase::ParticleEvent,
+              "Particle system callbacks are events, not per-frame updates");
+static_assert(findUnityCallback("CustomMethod") == nullptr, "Catalog lookup matched a non-Unity method");
+
+} // namespace Unity
+} // namespace UnityContextGen
@@ -1,355 +1,303 @@
 #include "UnityPatternDetector.h"
+#include <nlohmann/json.hpp>
 #include <algorithm>
-#include <regex>
+#include <fstream>
+#include <iostream>
 
 namespace UnityContextGen {
 namespace Unity {
 
-UnityPatternDetector::UnityPatternDetector() {
+static PatternRule makeRule(UnityPattern pattern_type, const char* name, const char* description,
+                           const char* purpose, PatternRuleScope scope) {
+    PatternRule rule;
+    rule.pattern_type = pattern_type;
+    rule.pattern_name = name;
+    rule.description = description;
+    rule.purpose = purpose;
+    rule.scope = scope;
+    return rule;
 }
 
-void UnityPatternDetector::analyzeProject(const std::vector<MonoBehaviourInfo>& monobehaviours,
-                                         const ComponentGraph& dependency_graph) {
-    m_monobehaviours = monobehaviours;
-    m_dependency_graph = dependency_graph;
-    m_detected_patterns.clear();
+static std::vector<PatternRule> buildDefaultPatternRules() {
+    std::vector<PatternRule> rules;
+    
+    PatternRule singleton = makeRule(UnityPattern::SingletonMonoBehaviour, "Singleton MonoBehaviour",
+                                     "MonoBehaviour implementing singleton pattern for global access",
+                                     "Ensure single instance and provide global access point",
+                                     PatternRuleScope::Component);
+    singleton.require_any = featureSet({ComponentFeature::StaticInstanceField, ComponentFeature::InstanceAccessor});
+    singleton.evidence = {{ComponentFeature::StaticInstanceField, "Static instance field"},
+                          {ComponentFeature::InstanceAccessor, "Instance access method"},
+                          {ComponentFeature::DontDestroyOnLoad, "DontDestroyOnLoad usage"}};
+    rules.push_back(singleton);
+    
+    PatternRule pooling = makeRule(UnityPattern::ObjectPooling, "Object Pooling",
+                                   "Reuses objects to avoid frequent allocation/deallocation",
+                                   "Optimize performance by reusing game objects",
+                                   PatternRuleScope::Component);
+    pooling.require_all = featureSet({ComponentFeature::PoolCollection, ComponentFeature::PoolMethods});
+    pooling.evidence = {{ComponentFeature::PoolCollection, "Pool collection field"},
+                        {ComponentFeature::PoolMethods, "Get/Return methods"},
+                        {ComponentFeature::SetActiveCalls, "SetActive usage"},
+                        {ComponentFeature::InstantiateCalls, "Instantiate calls"}};
+    rules.push_back(pooling);
+    
+    PatternRule state = makeRule(UnityPattern::StatePattern, "State Pattern",
+                                 "Implements state-based behavior with state transitions",
+                                 "Manage complex object behavior through states",
+                                 PatternRuleScope::Project);
+    state.require_all = featureSet({ComponentFeature::StateNamed});
+    state.min_components = 2;
+    state.evidence = {{ComponentFeature::StateNamed, "Multiple state classes"},
+                      {ComponentFeature::StateTransitions, "State transition methods"}};
+    rules.push_back(state);
+    
+    // Needs both sides of the relationship somewhere in the project: something
+    // raising notifications and something subscribing to them
+    PatternRule observer = makeRule(UnityPattern::ObserverPattern, "Observer Pattern",
+                                    "Implements event-driven communication between objects",
+                                    "Decouple objects through event notifications",
+                                    PatternRuleScope::Project);
+    observer.require_any = featureSet({ComponentFeature::EventFields, ComponentFeature::EventRaiseMethods,
+                                       ComponentFeature::SubscribeMethods});
+    observer.project_require_all = featureSet({ComponentFeature::EventRaiseMethods, ComponentFeature::SubscribeMethods});
+    observer.evidence = {{ComponentFeature::EventFields, "Event declarations"},
+                         {ComponentFeature::SubscribeMethods, "Subscribe/Unsubscribe methods"},
+                         {ComponentFeature::EventRaiseMethods, "Notification methods"}};
+    rules.push_back(observer);
+    
+    PatternRule composition = makeRule(UnityPattern::ComponentComposition, "Component Composition",
+                                       "Combines multiple components to create complex behavior",
+                                       "Build complex functionality through component composition",
+                                       PatternRuleScope::Component);
+    composition.require_all = featureSet({ComponentFeature::ManyComponentDependencies});
+    composition.evidence = {{ComponentFeature::ManyComponentDependencies, "Multiple component dependencies"}};
+    rules.push_back(composition);
     
-    detectSingletonPattern();
-    detectObjectPoolingPattern();
-    detectStatePattern();
-    detectObserverPattern();
-    detectComponentCompositionPattern();
-    detectServiceLocatorPattern();
-    detectFactoryPattern();
-    detectCommandPattern();
-    detectMVCPattern();
-    detectECSPattern();
+    PatternRule service_locator = makeRule(UnityPattern::ServiceLocator, "Service Locator",
+                                           "Provides centralized access to services",
+                                           "Manage and provide access to game services",
+                                           PatternRuleScope::Project);
+    service_locator.require_all = featureSet({ComponentFeature::ServiceNamed});
+    service_locator.min_components = 2;
+    service_locator.evidence = {{ComponentFeature::ServiceNamed, "Service/Manager classes"},
+                                {ComponentFeature::InstanceAccessor, "Global service access"},
+                                {ComponentFeature::FindObjectCalls, "Service lookup calls"}};
+    rules.push_back(service_locator);
+    
+    PatternRule factory = makeRule(UnityPattern::FactoryPattern, "Factory Pattern",
+                                   "Creates objects without specifying exact classes",
+                                   "Encapsulate object creation logic",
+                                   PatternRuleScope::Project);
+    factory.require_all = featureSet({ComponentFeature::FactoryNamed});
+    factory.evidence = {{ComponentFeature::FactoryNamed, "Factory/Creator classes"},
+                        {ComponentFeature::InstantiateCalls, "Instantiate calls"}};
+    rules.push_back(factory);
+    
+    PatternRule command = makeRule(UnityPattern::CommandPattern, "Command Pattern",
+                                   "Encapsulates requests as objects",
+                                   "Support undo/redo operations and request queuing",
+                                   PatternRuleScope::Project);
+    command.require_all = featureSet({ComponentFeature::CommandNamed});
+    command.evidence = {{ComponentFeature::CommandNamed, "Command/Action classes"},
+                        {ComponentFeature::ExecuteMethods, "Execute methods"}};
+    rules.push_back(command);
+    
+    PatternRule mvc = makeRule(UnityPattern::MVC_Pattern, "MVC Pattern",
+                               "Separates application logic into Model, View, and Controller",
+                               "Improve code organization and maintainability",
+                               PatternRuleScope::Project);
+    mvc.require_any = featureSet({ComponentFeature::ControllerNamed, ComponentFeature::ViewNamed,
+                                  ComponentFeature::ModelNamed});
+    mvc.min_components = 3;
+    mvc.evidence = {{ComponentFeature::ControllerNamed, "Controller classes"},
+                    {ComponentFeature::ViewNamed, "View classes"},
+                    {ComponentFeature::ModelNamed, "Model classes"}};
+    rules.push_back(mvc);
+    
+    PatternRule ecs = makeRule(UnityPattern::ECS_Pattern, "Entity Component System",
+                               "Implements data-oriented design with entities, components, and systems",
+                               "Optimize performance and improve code modularity",
+                               PatternRuleScope::Project);
+    ecs.require_any = featureSet({ComponentFeature::EntityNamed, ComponentFeature::ComponentNamed,
+                                  ComponentFeature::SystemNamed});
+    ecs.min_components = 3;
+    ecs.evidence = {{ComponentFeature::EntityNamed, "Entity classes"},
+                    {ComponentFeature::ComponentNamed, "Component data"},
+                    {ComponentFeature::SystemNamed, "System logic"}};
+    rules.push_back(ecs);
+    
+    return rules;
 }
 
-void UnityPatternDetector::detectSingletonPattern() {
-    for (const auto& mb_info : m_monobehaviours) {
-        if (hasSingletonCharacteristics(mb_info)) {
-            PatternInstance pattern;
-            pattern.pattern_type = UnityPattern::SingletonMonoBehaviour;
-            pattern.pattern_name = "Singleton MonoBehaviour";
-            pattern.involved_components.push_back(mb_info.class_name);
-            pattern.description = "MonoBehaviour implementing singleton pattern for global access";
-            pattern.purpose = "Ensure single instance and provide global access point";
-            
-            pattern.evidence.push_back("Static instance field");
-            pattern.evidence.push_back("Instance access method");
-            pattern.evidence.push_back("DontDestroyOnLoad usage");
-            
-            pattern.confidence_score = calculateConfidenceScore(pattern.evidence);
-            m_detected_patterns.push_back(pattern);
-        }
-    }
-}
+const std::vector<PatternRule> UnityPatternDetector::DEFAULT_PATTERN_RULES = buildDefaultPatternRules();
 
-void UnityPatternDetector::detectObjectPoolingPattern() {
-    for (const auto& mb_info : m_monobehaviours) {
-        if (hasPoolingCharacteristics(mb_info)) {
-            PatternInstance pattern;
-            pattern.pattern_type = UnityPattern::ObjectPooling;
-            pattern.pattern_name = "Object Pooling";
-            pattern.involved_components.push_back(mb_info.class_name);
-            pattern.description = "Reuses objects to avoid frequent allocation/deallocation";
-            pattern.purpose = "Optimize performance by reusing game objects";
-            
-            pattern.evidence.push_back("Pool collection field");
-            pattern.evidence.push_back("Get/Return methods");
-            pattern.evidence.push_back("SetActive usage");
-            
-            pattern.confidence_score = calculateConfidenceScore(pattern.evidence);
-            m_detected_patterns.push_back(pattern);
+static bool findFeatureByName(const std::string& feature_name, ComponentFeature& feature) {
+    for (const auto& entry : COMPONENT_FEATURE_NAMES) {
+        if (entry.name == feature_name) {
+            feature = entry.feature;
+            return true;
         }
     }
+    std::cerr << "Unknown component feature in pattern rule: " << feature_name << std::endl;
+    return false;
 }
 
-void UnityPatternDetector::detectStatePattern() {
-    if (hasStatePatternCharacteristics(m_monobehaviours)) {
-        std::vector<std::string> state_components = findComponentsByPattern(".*State.*");
-        
-        if (!state_components.empty()) {
-            PatternInstance pattern;
-            pattern.pattern_type = UnityPattern::StatePattern;
-            pattern.pattern_name = "State Pattern";
-            pattern.involved_components = state_components;
-            pattern.description = "Implements state-based behavior with state transitions";
-            pattern.purpose = "Manage complex object behavior through states";
-            
-            pattern.evidence.push_back("Multiple state classes");
-            pattern.evidence.push_back("State transition methods");
-            pattern.evidence.push_back("Current state field");
-            
-            pattern.confidence_score = calculateConfidenceScore(pattern.evidence);
-            m_detected_patterns.push_back(pattern);
+static bool parseFeatureList(const nlohmann::json& names, ComponentFeatureSet& features) {
+    features = 0;
+    for (const auto& name : names) {
+        ComponentFeature feature;
+        if (!name.is_string() || !findFeatureByName(name.get<std::string>(), feature)) {
+            return false;
         }
+        features |= featureBit(feature);
     }
+    return true;
 }
 
-void UnityPatternDetector::detectObserverPattern() {
-    if (hasObserverCharacteristics(m_monobehaviours)) {
-        std::vector<std::string> observer_components;
-        
-        for (const auto& mb_info : m_monobehaviours) {
-            bool has_events = false;
-            bool has_listeners = false;
-            
-            for (const auto& method : mb_info.unity_methods) {
-                if (method.find("Event") != std::string::npos || 
-                    method.find("Notify") != std::string::npos) {
-                    has_events = true;
-                }
-                if (method.find("Subscribe") != std::string::npos || 
-                    method.find("Listen") != std::string::npos) {
-                    has_listeners = true;
-                }
-            }
-            
-            if (has_events || has_listeners) {
-                observer_components.push_back(mb_info.class_name);
-            }
-        }
-        
-        if (!observer_components.empty()) {
-            PatternInstance pattern;
-            pattern.pattern_type = UnityPattern::ObserverPattern;
-            pattern.pattern_name = "Observer Pattern";
-            pattern.involved_components = observer_components;
-            pattern.description = "Implements event-driven communication between objects";
-            pattern.purpose = "Decouple objects through event notifications";
-            
-            pattern.evidence.push_back("Event declarations");
-            pattern.evidence.push_back("Subscribe/Unsubscribe methods");
-            pattern.evidence.push_back("Notification methods");
-            
-            pattern.confidence_score = calculateConfidenceScore(pattern.evidence);
-            m_detected_patterns.push_back(pattern);
-        }
-    }
-}
-
-void UnityPatternDetector::detectComponentCompositionPattern() {
-    for (const auto& mb_info : m_monobehaviours) {
-        if (mb_info.component_dependencies.size() >= 3) {
-            PatternInstance pattern;
-            pattern.pattern_type = UnityPattern::ComponentComposition;
-            pattern.pattern_name = "Component Composition";
-            pattern.involved_components.push_back(mb_info.class_name);
-            pattern.description = "Combines multiple components to create complex behavior";
-            pattern.purpose = "Build complex functionality through component composition";
-            
-            pattern.evidence.push_back("Multiple component dependencies");
-            pattern.evidence.push_back("GetComponent calls");
-            pattern.evidence.push_back("RequireComponent attributes");
-            
-            pattern.confidence_score = calculateConfidenceScore(pattern.evidence);
-            m_detected_patterns.push_back(pattern);
-        }
-    }
-}
-
-void UnityPatternDetector::detectServiceLocatorPattern() {
-    std::vector<std::string> service_components = findComponentsByPattern(".*Service.*|.*Manager.*");
-    
-    if (service_components.size() >= 2) {
-        PatternInstance pattern;
-        pattern.pattern_type = UnityPattern::ServiceLocator;
-        pattern.pattern_name = "Service Locator";
-        pattern.involved_components = service_components;
-        pattern.description = "Provides centralized access to services";
-        pattern.purpose = "Manage and provide access to game services";
-        
-        pattern.evidence.push_back("Service/Manager classes");
-        pattern.evidence.push_back("Service registration");
-        pattern.evidence.push_back("Service lookup methods");
-        
-        pattern.confidence_score = calculateConfidenceScore(pattern.evidence);
-        m_detected_patterns.push_back(pattern);
-    }
+UnityPatternDetector::UnityPatternDetector()
+    : m_monobehaviours(nullptr), m_rules(DEFAULT_PATTERN_RULES) {
 }
 
-void UnityPatternDetector::detectFactoryPattern() {
-    std::vector<std::string> factory_components = findComponentsByPattern(".*Factory.*|.*Creator.*|.*Builder.*");
-    
-    if (!factory_components.empty()) {
-        PatternInstance pattern;
-        pattern.pattern_type = UnityPattern::FactoryPattern;
-        pattern.pattern_name = "Factory Pattern";
-        pattern.involved_components = factory_components;
-        pattern.description = "Creates objects without specifying exact classes";
-        pattern.purpose = "Encapsulate object creation logic";
-        
-        pattern.evidence.push_back("Factory/Creator classes");
-        pattern.evidence.push_back("Create methods");
-        pattern.evidence.push_back("Instantiate calls");
-        
-        pattern.confidence_score = calculateConfidenceScore(pattern.evidence);
-        m_detected_patterns.push_back(pattern);
-    }
-}
-
-void UnityPatternDetector::detectCommandPattern() {
-    std::vector<std::string> command_components = findComponentsByPattern(".*Command.*|.*Action.*");
+void UnityPatternDetector::analyzeProject(const std::vector<MonoBehaviourInfo>& monobehaviours,
+                                         const ComponentGraph& /*dependency_graph*/) {
+    m_monobehaviours = &monobehaviours;
+    m_detected_patterns.clear();
     
-    if (!command_components.empty()) {
-        PatternInstance pattern;
-        pattern.pattern_type = UnityPattern::CommandPattern;
-        pattern.pattern_name = "Command Pattern";
-        pattern.involved_components = command_components;
-        pattern.description = "Encapsulates requests as objects";
-        pattern.purpose = "Support undo/redo operations and request queuing";
-        
-        pattern.evidence.push_back("Command/Action classes");
-        pattern.evidence.push_back("Execute methods");
-        pattern.evidence.push_back("Undo/Redo support");
-        
-        pattern.confidence_score = calculateConfidenceScore(pattern.evidence);
-        m_detected_patterns.push_back(pattern);
+    // Contiguous bitmaps keep every rule scan a tight loop over 64-bit words
+    std::vector<ComponentFeatureSet> features;
+    features.reserve(monobehaviours.size());
+    for (const auto& mb_info : monobehaviours) {
+        features.push_back(mb_info.features);
     }
-}
-
-void UnityPatternDetector::detectMVCPattern() {
-    std::vector<std::string> mvc_components;
     
-    for (const auto& component : findComponentsByPattern(".*Controller.*")) {
-        mvc_components.push_back(component);
-    }
-    for (const auto& component : findComponentsByPattern(".*View.*")) {
-        mvc_components.push_back(component);
-    }
-    for (const auto& component : findComponentsByPattern(".*Model.*")) {
-        mvc_components.push_back(component);
+    for (const auto& rule : m_rules) {
+        applyRule(rule, features);
     }
     
-    if (mvc_components.size() >= 3) {
-        PatternInstance pattern;
-        pattern.pattern_type = UnityPattern::MVC_Pattern;
-        pattern.pattern_name = "MVC Pattern";
-        pattern.involved_components = mvc_components;
-        pattern.description = "Separates application logic into Model, View, and Controller";
-        pattern.purpose = "Improve code organization and maintainability";
-        
-        pattern.evidence.push_back("Controller classes");
-        pattern.evidence.push_back("View classes");
-        pattern.evidence.push_back("Model classes");
-        
-        pattern.confidence_score = calculateConfidenceScore(pattern.evidence);
-        m_detected_patterns.push_back(pattern);
-    }
+    m_monobehaviours = nullptr;
 }
 
-void UnityPatternDetector::detectECSPattern() {
-    std::vector<std::string> ecs_components;
+void UnityPatternDetector::applyRule(const PatternRule& rule, const std::vector<ComponentFeatureSet>& features) {
+    const size_t count = features.size();
+    std::vector<uint8_t> matches(count);
     
-    for (const auto& component : findComponentsByPattern(".*Entity.*|.*Component.*|.*System.*")) {
-        ecs_components.push_back(component);
+    for (size_t i = 0; i < count; ++i) {
+        ComponentFeatureSet f = features[i];
+        matches[i] = static_cast<uint8_t>(((f & rule.require_all) == rule.require_all) &
+                                          ((rule.require_any == 0) | ((f & rule.require_any) != 0)) &
+                                          ((f & rule.exclude) == 0));
     }
     
-    if (ecs_components.size() >= 3) {
-        PatternInstance pattern;
-        pattern.pattern_type = UnityPattern::ECS_Pattern;
-        pattern.pattern_name = "Entity Component System";
-        pattern.involved_components = ecs_components;
-        pattern.description = "Implements data-oriented design with entities, components, and systems";
-        pattern.purpose = "Optimize performance and improve code modularity";
-        
-        pattern.evidence.push_back("Entity classes");
-        pattern.evidence.push_back("Component data");
-        pattern.evidence.push_back("System logic");
-        
-        pattern.confidence_score = calculateConfidenceScore(pattern.evidence);
-        m_detected_patterns.push_back(pattern);
+    if (rule.scope == PatternRuleScope::Component) {
+        for (size_t i = 0; i < count; ++i) {
+            if (matches[i] && (features[i] & rule.project_require_all) == rule.project_require_all) {
+                PatternInstance pattern = createPatternInstance(rule, features[i]);
+                pattern.involved_components.push_back((*m_monobehaviours)[i].class_name);
+                m_detected_patterns.push_back(pattern);
+            }
+        }
+        return;
     }
-}
-
-bool UnityPatternDetector::hasSingletonCharacteristics(const MonoBehaviourInfo& mb_info) const {
-    bool has_static_instance = false;
-    bool has_instance_access = false;
     
-    for (const auto& field : mb_info.serialized_fields) {
-        if (field.find("static") != std::string::npos && 
-            field.find("instance") != std::string::npos) {
-            has_static_instance = true;
+    std::vector<std::string> involved_components;
+    ComponentFeatureSet combined_features = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (matches[i]) {
+            involved_components.push_back((*m_monobehaviours)[i].class_name);
+            combined_features |= features[i];
         }
     }
     
-    for (const auto& method : mb_info.custom_methods) {
-        if (method == "Instance" || method == "GetInstance") {
-            has_instance_access = true;
-        }
+    if (involved_components.empty() ||
+        involved_components.size() < rule.min_components ||
+        (combined_features & rule.project_require_all) != rule.project_require_all) {
+        return;
     }
     
-    return has_static_instance || has_instance_access;
+    PatternInstance pattern = createPatternInstance(rule, combined_features);
+    pattern.involved_components = std::move(involved_components);
+    m_detected_patterns.push_back(pattern);
 }
 
-bool UnityPatternDetector::hasPoolingCharacteristics(const MonoBehaviourInfo& mb_info) const {
-    bool has_pool_collection = false;
-    bool has_pool_methods = false;
-    
-    for (const auto& field : mb_info.serialized_fields) {
-        if (field.find("Pool") != std::string::npos || 
-            field.find("Queue") != std::string::npos ||
-            field.find("List") != std::string::npos) {
-            has_pool_collection = true;
-        }
-    }
+PatternInstance UnityPatternDetector::createPatternInstance(const PatternRule& rule,
+                                                            ComponentFeatureSet evidence_features) const {
+    PatternInstance pattern;
+    pattern.pattern_type = rule.pattern_type;
+    pattern.pattern_name = rule.pattern_name;
+    pattern.description = rule.description;
+    pattern.purpose = rule.purpose;
     
-    for (const auto& method : mb_info.custom_methods) {
-        if (method.find("Get") != std::string::npos || 
-            method.find("Return") != std::string::npos ||
-            method.find("Pool") != std::string::npos) {
-            has_pool_methods = true;
+    for (const auto& evidence : rule.evidence) {
+        if (hasFeature(evidence_features, evidence.first)) {
+            pattern.evidence.push_back(evidence.second);
         }
     }
     
-    return has_pool_collection && has_pool_methods;
+    pattern.confidence_score = calculateConfidenceScore(pattern.evidence);
+    return pattern;
 }
 
-bool UnityPatternDetector::hasStatePatternCharacteristics(const std::vector<MonoBehaviourInfo>& components) const {
-    int state_classes = 0;
-    
-    for (const auto& mb_info : components) {
-        if (mb_info.class_name.find("State") != std::string::npos) {
-            state_classes++;
-        }
-    }
-    
-    return state_classes >= 2;
+void UnityPatternDetector::addPatternRule(const PatternRule& rule) {
+    m_rules.push_back(rule);
 }
 
-bool UnityPatternDetector::hasObserverCharacteristics(const std::vector<MonoBehaviourInfo>& components) const {
-    bool has_events = false;
-    bool has_listeners = false;
-    
-    for (const auto& mb_info : components) {
-        for (const auto& method : mb_info.custom_methods) {
-            if (method.find("Event") != std::string::npos || 
-                method.find("Notify") != std::string::npos) {
-                has_events = true;
+bool UnityPatternDetector::loadPatternRules(const std::string& file_path) {
+    try {
+        std::ifstream rules_file(file_path);
+        if (!rules_file.is_open()) {
+            std::cerr << "Failed to open pattern rules file: " << file_path << std::endl;
+            return false;
+        }
+        
+        nlohmann::json rules_json;
+        rules_file >> rules_json;
+        
+        const nlohmann::json& entries = rules_json.is_array() ? rules_json : rules_json.value("patterns", nlohmann::json::array());
+        
+        std::vector<PatternRule> rules;
+        for (const auto& entry : entries) {
+            PatternRule rule;
+            rule.pattern_type = UnityPattern::Custom;
+            rule.pattern_name = entry.value("name", "");
+            rule.description = entry.value("description", "");
+            rule.purpose = entry.value("purpose", "");
+            rule.scope = entry.value("scope", "component") == "project" ? PatternRuleScope::Project
+                                                                           : PatternRuleScope::Component;
+            rule.min_components = entry.value("min_components", 1);
+            
+            if (rule.pattern_name.empty() ||
+                !parseFeatureList(entry.value("require_all", nlohmann::json::array()), rule.require_all) ||
+                !parseFeatureList(entry.value("require_any", nlohmann::json::array()), rule.require_any) ||
+                !parseFeatureList(entry.value("exclude", nlohmann::json::array()), rule.exclude) ||
+                !parseFeatureList(entry.value("project_require_all", nlohmann::json::array()), rule.project_require_all)) {
+                std::cerr << "Invalid pattern rule in: " << file_path << std::endl;
+                return false;
             }
-            if (method.find("Subscribe") != std::string::npos || 
-                method.find("Listen") != std::string::npos) {
-                has_listeners = true;
+            
+            if (entry.contains("evidence")) {
+                for (const auto& evidence : entry["evidence"].items()) {
+                    ComponentFeature feature;
+                    if (!findFeatureByName(evidence.key(), feature)) {
+                        return false;
+                    }
+                    rule.evidence.push_back({feature, evidence.value().get<std::string>()});
+                }
             }
+            
+            rules.push_back(rule);
         }
+        
+        m_rules.insert(m_rules.end(), rules.begin(), rules.end());
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to load pattern rules: " << e.what() << std::endl;
+        return false;
     }
-    
-    return has_events && has_listeners;
 }
 
-std::vector<std::string> UnityPatternDetector::findComponentsByPattern(const std::string& pattern_regex) const {
-    std::vector<std::string> matching_components;
-    std::regex pattern(pattern_regex);
-    
-    for (const auto& mb_info : m_monobehaviours) {
-        if (std::regex_match(mb_info.class_name, pattern)) {
-            matching_components.push_back(mb_info.class_name);
-        }
-    }
-    
-    return matching_components;
+const std::vector<PatternRule>& UnityPatternDetector::getPatternRules() const {
+    return m_rules;
 }
 
 float UnityPatternDetector::calculateConfidenceScore(const std::vector<std::string>& evidence) const {
@@ -358,10 +306,16 @@ float UnityPatternDetector::calculateConfidenceScore(const std::vector<std::stri
     return std::min(0.95f, base_score + evidence_bonus);
 }
 
-std::vector<PatternInstance> UnityPatternDetector::getDetectedPatterns() const {
+const std::vector<PatternInstance>& UnityPatternDetector::getDetectedPatterns() const {
     return m_detected_patterns;
 }
 
+std::vector<PatternInstance> UnityPatternDetector::takeDetectedPatterns() {
+    std::vector<PatternInstance> patterns = std::move(m_detected_patterns);
+    m_detected_patterns.clear();
+    return patterns;
+}
+
 std::vector<PatternInstance> UnityPatternDetector::getPatternsByType(UnityPattern pattern_type) const {
     std::vector<PatternInstance> patterns;
     
@@ -419,6 +373,7 @@ std::string UnityPatternDetector::getPatternName(UnityPattern pattern) const {
         case UnityPattern::CommandPattern: return "Command Pattern";
         case UnityPattern::MVC_Pattern: return "MVC Pattern";
         case UnityPattern::ECS_Pattern: return "Entity Component System";
+        case UnityPattern::Custom: return "Custom Pattern";
         default: return "Unknown Pattern";
     }
 }
@@ -20,6 +20,7 @@ enum class UnityPattern {
     CommandPattern,
     MVC_Pattern,
     ECS_Pattern,
+    Custom,
     Unknown
 };
 
@@ -33,42 +34,57 @@ struct PatternInstance {
     std::vector<std::string> evidence;
 };
 
+enum class PatternRuleScope {
+    Component,  // One instance per matching component
+    Project     // One instance covering all matching components
+};
+
+// A pattern expressed over component feature bitmaps. A component matches when it has
+// every feature in require_all, at least one in require_any (if set) and none in exclude.
+struct PatternRule {
+    UnityPattern pattern_type = UnityPattern::Custom;
+    std::string pattern_name;
+    std::string description;
+    std::string purpose;
+    PatternRuleScope scope = PatternRuleScope::Component;
+    ComponentFeatureSet require_all = 0;
+    ComponentFeatureSet require_any = 0;
+    ComponentFeatureSet exclude = 0;
+    ComponentFeatureSet project_require_all = 0;  // Must appear across the matched components
+    size_t min_components = 1;
+    std::vector<std::pair<ComponentFeature, std::string>> evidence;
+};
+
 class UnityPatternDetector {
 public:
     UnityPatternDetector();
     ~UnityPatternDetector() = default;
 
+    // Inputs are borrowed for the duration of the call only
     void analyzeProject(const std::vector<MonoBehaviourInfo>& monobehaviours,
                        const ComponentGraph& dependency_graph);
     
-    std::vector<PatternInstance> getDetectedPatterns() const;
+    const std::vector<PatternInstance>& getDetectedPatterns() const;
+    std::vector<PatternInstance> takeDetectedPatterns();
     std::vector<PatternInstance> getPatternsByType(UnityPattern pattern_type) const;
     
     std::string generatePatternSummary() const;
     std::map<UnityPattern, int> getPatternFrequency() const;
+    
+    // Rule management
+    void addPatternRule(const PatternRule& rule);
+    bool loadPatternRules(const std::string& file_path);
+    const std::vector<PatternRule>& getPatternRules() const;
 
 private:
-    std::vector<MonoBehaviourInfo> m_monobehaviours;
-    ComponentGraph m_dependency_graph;
+    const std::vector<MonoBehaviourInfo>* m_monobehaviours;
     std::vector<PatternInstance> m_detected_patterns;
+    std::vector<PatternRule> m_rules;
     
-    void detectSingletonPattern();
-    void detectObjectPoolingPattern();
-    void detectStatePattern();
-    void detectObserverPattern();
-    void detectComponentCompositionPattern();
-    void detectServiceLocatorPattern();
-    void detectFactoryPattern();
-    void detectCommandPattern();
-    void detectMVCPattern();
-    void detectECSPattern();
-    
-    bool hasSingletonCharacteristics(const MonoBehaviourInfo& mb_info) const;
-    bool hasPoolingCharacteristics(const MonoBehaviourInfo& mb_info) const;
-    bool hasStatePatternCharacteristics(const std::vector<MonoBehaviourInfo>& components) const;
-    bool hasObserverCharacteristics(const std::vector<MonoBehaviourInfo>& components) const;
+    static const std::vector<PatternRule> DEFAULT_PATTERN_RULES;
     
-    std::vector<std::string> findComponentsByPattern(const std::string& pattern_regex) const;
+    void applyRule(const PatternRule& rule, const std::vector<ComponentFeatureSet>& features);
+    PatternInstance createPatternInstance(const PatternRule& rule, ComponentFeatureSet evidence_features) const;
     float calculateConfidenceScore(const std::vector<std::string>& evidence) const;
     
     std::string getPatternName(UnityPattern pattern) const;
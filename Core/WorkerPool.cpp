@@ -0,0 +1,45 @@
+#include "WorkerPool.h"
+
+namespace UnityContextGen {
+
+WorkerPool::WorkerPool(size_t thread_count) : m_stopping(false) {
+    m_workers.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; ++i) {
+        m_workers.emplace_back(&WorkerPool::workerLoop, this);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_condition.notify_all();
+
+    for (auto& worker : m_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+void WorkerPool::workerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+
+            // Drain queued work before exiting so no future is left unsatisfied
+            if (m_tasks.empty()) {
+                return;
+            }
+
+            task = std::move(m_tasks.front());
+            m_tasks.pop();
+        }
+        task();
+    }
+}
+
+} // namespace UnityContextGen
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace UnityContextGen {
+
+// Fixed-size thread pool shared by the engine's parallel stages. With zero
+// threads, tasks run inline on the submitting thread. Tasks must not block
+// on other tasks submitted to the same pool.
+class WorkerPool {
+public:
+    explicit WorkerPool(size_t thread_count);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    template<typename Task>
+    auto submit(Task task) -> std::future<decltype(task())> {
+        using Result = decltype(task());
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::move(task));
+        std::future<Result> future = packaged->get_future();
+
+        if (m_workers.empty()) {
+            (*packaged)();
+            return future;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tasks.push([packaged]() { (*packaged)(); });
+        }
+        m_condition.notify_one();
+        return future;
+    }
+
+    size_t getThreadCount() const { return m_workers.size(); }
+
+private:
+    std::vector<std::thread> m_workers;
+    std::queue<std::function<void()>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_stopping;
+
+    void workerLoop();
+};
+
+} // namespace UnityContextGen
@@ -97,6 +97,43 @@ class UnityContextMCPServer:
                             },
                             "required": ["analysis_result_path"]
                         }
+                    ),
+                    Tool(
+                        name="get_component_context",
+                        description="샤드 매니페스트에서 지정한 컴포넌트의 메타데이터만 읽어옵니다",
+                        inputSchema={
+                            "type": "object",
+                            "properties": {
+                                "manifest_path": {
+                                    "type": "string",
+                                    "description": "shard_manifest.json 파일 경로 (--shard 옵션으로 생성)"
+                                },
+                                "components": {
+                                    "type": "array",
+                                    "items": {"type": "string"},
+                                    "description": "읽어올 컴포넌트 이름 목록 (비어 있으면 목록만 반환)"
+                                }
+                            },
+                            "required": ["manifest_path"]
+                        }
+                    ),
+                    Tool(
+                        name="search_project_symbols",
+                        description="클래스/메서드/필드/Unity API 심볼 인덱스로 관련 컴포넌트를 순위별로 검색합니다 (예: \"Rigidbody in FixedUpdate\")",
+                        inputSchema={
+                            "type": "object",
+                            "properties": {
+                                "directory_path": {
+                                    "type": "string",
+                                    "description": "검색할 Unity 프로젝트 디렉토리 경로"
+                                },
+                                "query": {
+                                    "type": "string",
+                                    "description": "검색어 (심볼 이름, API, 생명주기 메서드 등)"
+                                }
+                            },
+                            "required": ["directory_path", "query"]
+                        }
                     )
                 ]
             )
@@ -113,6 +150,10 @@ class UnityContextMCPServer:
                 return await self._get_unity_api_patterns()
             elif request.name == "generate_llm_context":
                 return await self._generate_llm_context(request.arguments)
+            elif request.name == "get_component_context":
+                return await self._get_component_context(request.arguments)
+            elif request.name == "search_project_symbols":
+                return await self._search_project_symbols(request.arguments)
             else:
                 raise ValueError(f"Unknown tool: {request.name}")
 
@@ -349,6 +390,119 @@ class UnityContextMCPServer:
                 )]
             )
 
+    async def _get_component_context(self, args: Dict[str, Any]) -> CallToolResult:
+        """샤드 매니페스트의 오프셋과 해시로 필요한 컴포넌트만 읽어옵니다."""
+        manifest_path = Path(args["manifest_path"])
+        requested = args.get("components") or []
+        
+        try:
+            with open(manifest_path, 'r', encoding='utf-8') as f:
+                manifest = json.load(f)
+            
+            entries = {entry["component"]: entry for entry in manifest.get("shards", [])}
+            
+            # 컴포넌트를 지정하지 않으면 프로젝트 개요와 목록만 반환
+            if not requested:
+                overview = {
+                    "project_context": manifest.get("project_context", {}),
+                    "components": [
+                        {"component": name, "system": entry.get("system", "")}
+                        for name, entry in entries.items()
+                    ]
+                }
+                return CallToolResult(
+                    content=[TextContent(
+                        type="text",
+                        text=json.dumps(overview, indent=2, ensure_ascii=False)
+                    )]
+                )
+            
+            components = {}
+            missing = []
+            for name in requested:
+                entry = entries.get(name)
+                if entry is None:
+                    missing.append(name)
+                    continue
+                components[name] = self._read_shard_record(manifest_path.parent, entry)
+            
+            text = json.dumps(components, indent=2, ensure_ascii=False)
+            if missing:
+                text += f"\n\n⚠️ 매니페스트에 없는 컴포넌트: {', '.join(missing)}"
+            
+            return CallToolResult(
+                content=[TextContent(
+                    type="text",
+                    text=text
+                )]
+            )
+        except Exception as e:
+            return CallToolResult(
+                content=[TextContent(
+                    type="text",
+                    text=f"❌ 샤드 로드 중 오류: {str(e)}"
+                )]
+            )
+
+    async def _search_project_symbols(self, args: Dict[str, Any]) -> CallToolResult:
+        """저장된 심볼 인덱스로 검색합니다. 소스가 바뀌지 않았다면 다시 파싱하지 않습니다."""
+        directory_path = args["directory_path"]
+        query = args["query"]
+        
+        if not Path(directory_path).exists():
+            return CallToolResult(
+                content=[TextContent(
+                    type="text",
+                    text=f"❌ 디렉토리를 찾을 수 없습니다: {directory_path}"
+                )]
+            )
+        
+        try:
+            cmd = [UNITY_CONTEXT_GENERATOR, "--directory", directory_path, "--search", query]
+            result = subprocess.run(cmd, capture_output=True, text=True, timeout=120)
+            
+            if result.returncode == 0:
+                text = f"# 심볼 검색: {query}\n\n{result.stdout}"
+            else:
+                text = f"❌ 심볼 검색 실패:\n{result.stderr}"
+            
+            return CallToolResult(
+                content=[TextContent(
+                    type="text",
+                    text=text
+                )]
+            )
+        except subprocess.TimeoutExpired:
+            return CallToolResult(
+                content=[TextContent(
+                    type="text",
+                    text="❌ 검색 시간 초과 (2분)"
+                )]
+            )
+        except Exception as e:
+            return CallToolResult(
+                content=[TextContent(
+                    type="text",
+                    text=f"❌ 검색 중 오류 발생: {str(e)}"
+                )]
+            )
+
+    def _read_shard_record(self, manifest_dir: Path, entry: Dict) -> Dict:
+        """매니페스트 항목의 바이트 범위를 읽고 FNV-1a 해시를 검증합니다."""
+        with open(manifest_dir / entry["file"], 'rb') as f:
+            f.seek(entry["offset"])
+            record = f.read(entry["length"])
+        
+        digest = 0xcbf29ce484222325
+        for byte in record:
+            digest ^= byte
+            digest = (digest * 0x100000001b3) & 0xFFFFFFFFFFFFFFFF
+        
+        if f"{digest:016x}" != entry["hash"]:
+            raise ValueError(f"샤드 해시 불일치: {entry['component']}")
+        
+        return json.loads(record.decode('utf-8'))
+
     def _extract_api_analysis(self, stdout: str) -> str:
         """stdout에서 Unity API 분석 결과를 추출합니다."""
         lines = stdout.split('\n')
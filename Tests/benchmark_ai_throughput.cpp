@@ -0,0 +1,179 @@
+#include "../Core/AI/ClaudeAnalyzer.h"
+#include "../Core/Configuration/AnalysisConfig.h"
+#include "mock_llm_server.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// AI-stage throughput against the local stand-in Messages endpoint, so client
+// changes (concurrency, retries, connection reuse, streaming) can be measured
+// without an API key or network access.
+namespace {
+
+using namespace UnityContextGen;
+using Clock = std::chrono::steady_clock;
+
+const int CONCURRENCY_LEVELS[] = {1, 2, 4, 8, 16};
+
+std::string generateComponentSource(int index) {
+    std::string name = "Component" + std::to_string(index);
+
+    std::string source = "using UnityEngine;\n\n";
+    source += "public class " + name + " : MonoBehaviour\n{\n";
+    source += "    [SerializeField] private float speed = 5f;\n";
+    source += "    private Rigidbody body;\n\n";
+    source += "    void Awake() { body = GetComponent<Rigidbody>(); }\n";
+    source += "    void Update()\n    {\n";
+    source += "        var target = GameObject.Find(\"Target\");\n";
+    source += "        transform.LookAt(target.transform);\n";
+    source += "        transform.position += transform.forward * speed * Time.deltaTime;\n";
+    source += "    }\n";
+    source += "    void FixedUpdate() { body.AddForce(Vector3.up * speed); }\n";
+    source += "}\n";
+    return source;
+}
+
+std::vector<AI::AIAnalysisRequest> generateRequests(int request_count) {
+    std::vector<AI::AIAnalysisRequest> requests;
+    for (int i = 0; i < request_count; ++i) {
+        AI::AIAnalysisRequest request;
+        request.component_name = "Component" + std::to_string(i);
+        request.file_path = "Assets/Scripts/" + request.component_name + ".cs";
+        request.code_content = generateComponentSource(i);
+        request.project_context = "Benchmark project";
+        request.analysis_type = "code_review";
+        requests.push_back(std::move(request));
+    }
+    return requests;
+}
+
+Config::AIAnalysisConfig benchmarkConfig(const MockLLMServer& server, int concurrency) {
+    Config::AIAnalysisConfig config;
+    config.api_key = "benchmark-key";
+    config.api_base_url = server.baseURL();
+    config.enable_ai_analysis = true;
+    config.max_concurrent_requests = concurrency;
+    config.requests_per_minute = 0;
+    config.retry_base_delay_ms = 50;
+    config.retry_max_delay_ms = 1000;
+    return config;
+}
+
+struct BatchMeasurement {
+    double wall_ms;
+    int succeeded;
+    size_t attempts; // Requests the server saw, retries included
+    int64_t connections_opened;
+};
+
+BatchMeasurement runBatch(MockLLMServer& server, const Config::AIAnalysisConfig& config,
+                          const std::vector<AI::AIAnalysisRequest>& requests) {
+    BatchMeasurement measurement{0.0, 0, 0, 0};
+    AI::ClaudeAnalyzer analyzer;
+    if (!analyzer.initialize(config)) {
+        return measurement;
+    }
+
+    size_t attempts_before = server.requests().size();
+    int64_t opened_before = AI::HTTPClient::connectionStats().new_connections;
+    auto start = Clock::now();
+    auto results = analyzer.analyzeBatch(requests);
+    measurement.wall_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    for (const auto& result : results) {
+        measurement.succeeded += result.success ? 1 : 0;
+    }
+    measurement.attempts = server.requests().size() - attempts_before;
+    measurement.connections_opened = AI::HTTPClient::connectionStats().new_connections - opened_before;
+    return measurement;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int request_count = argc > 1 ? std::atoi(argv[1]) : 32;
+    int latency_ms = argc > 2 ? std::atoi(argv[2]) : 200;
+    if (request_count <= 0 || latency_ms < 0) {
+        std::cerr << "Usage: unity_context_ai_benchmark [request_count] [latency_ms]\n";
+        return 1;
+    }
+
+    MockLLMServer server;
+    if (!server.start()) {
+        std::cerr << "Could not start the local Messages endpoint\n";
+        return 1;
+    }
+    std::vector<AI::AIAnalysisRequest> requests = generateRequests(request_count);
+
+    std::cout << "AI stage throughput benchmark (" << request_count << " reviews, "
+              << latency_ms << " ms server latency)\n";
+    std::cout << "====================================\n\n";
+    std::cout << std::fixed << std::setprecision(1);
+
+    // Concurrency scaling: a healthy endpoint, more reviews in flight
+    MockLLMBehavior healthy;
+    healthy.latency_ms = latency_ms;
+    server.setHandler(MockLLMServer::standIn(healthy));
+    std::cout << "Concurrency scaling\n";
+    double serial_ms = 0.0;
+    for (int concurrency : CONCURRENCY_LEVELS) {
+        BatchMeasurement measurement = runBatch(server, benchmarkConfig(server, concurrency), requests);
+        if (concurrency == 1) {
+            serial_ms = measurement.wall_ms;
+        }
+        double throughput = measurement.wall_ms > 0 ? 1000.0 * measurement.succeeded / measurement.wall_ms : 0.0;
+        std::cout << "  " << std::setw(2) << concurrency << " in flight: " << measurement.wall_ms << " ms, "
+                  << throughput << " reviews/s, " << (measurement.wall_ms > 0 ? serial_ms / measurement.wall_ms : 0.0)
+                  << "x, " << measurement.succeeded << "/" << request_count << " ok, "
+                  << measurement.connections_opened << " connections opened\n";
+    }
+
+    // Retry behaviour: the same batch while the endpoint sheds load
+    BatchMeasurement healthy_run = runBatch(server, benchmarkConfig(server, 8), requests);
+    MockLLMBehavior overloaded = healthy;
+    overloaded.rate_limit_rate = 0.2;
+    overloaded.server_error_rate = 0.1;
+    overloaded.retry_after_seconds = 0.1;
+    server.setHandler(MockLLMServer::standIn(overloaded));
+    BatchMeasurement overloaded_run = runBatch(server, benchmarkConfig(server, 8), requests);
+    std::cout << "\nRetries (8 in flight, 20% 429 with retry-after 0.1 s, 10% 500)\n";
+    std::cout << "  healthy:    " << healthy_run.wall_ms << " ms, " << healthy_run.attempts << " attempts, "
+              << healthy_run.succeeded << "/" << request_count << " ok\n";
+    std::cout << "  overloaded: " << overloaded_run.wall_ms << " ms, " << overloaded_run.attempts << " attempts ("
+              << static_cast<double>(overloaded_run.attempts) / request_count << " per review), "
+              << overloaded_run.succeeded << "/" << request_count << " ok\n";
+
+    // Streaming: how soon a single-file review shows its first insight
+    MockLLMBehavior streaming = healthy;
+    streaming.stream_chunk_delay_ms = std::max(1, latency_ms / 2);
+    server.setHandler(MockLLMServer::standIn(streaming));
+    Config::AIAnalysisConfig stream_config = benchmarkConfig(server, 1);
+    stream_config.enable_streaming = true;
+    AI::ClaudeAnalyzer analyzer;
+    Clock::time_point start;
+    double first_insight_ms = -1.0;
+    analyzer.setProgressCallback([&](const std::string& message, float) {
+        if (first_insight_ms < 0 && message.rfind("[", 0) == 0) {
+            first_insight_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        }
+    });
+    if (analyzer.initialize(stream_config)) {
+        start = Clock::now();
+        bool reviewed = analyzer.analyzeCode(requests.front()).success;
+        double total_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        std::cout << "\nStreaming single-file review\n";
+        std::cout << "  first insight: " << first_insight_ms << " ms, complete: " << total_ms << " ms"
+                  << (reviewed ? "" : " (failed)") << "\n";
+    }
+
+    AI::HTTPClient::ConnectionStats connections = AI::HTTPClient::connectionStats();
+    std::cout << "\nConnections: " << connections.new_connections << " opened, "
+              << connections.reused_connections << " reused over " << connections.transfers << " transfers\n";
+
+    server.stop();
+    return 0;
+}
@@ -0,0 +1,173 @@
+#include "../Core/CoreEngine.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+// Allocation accounting: every block carries a header with its size so that
+// unsized deletes can be tracked too.
+namespace {
+
+// The measured stages run on the calling thread, but CoreEngine starts its
+// worker pool threads while counting is live, so updates must be atomic
+std::atomic<size_t> g_allocated_bytes(0);
+std::atomic<size_t> g_live_bytes(0);
+std::atomic<size_t> g_peak_live_bytes(0);
+
+constexpr size_t HEADER_SIZE = alignof(std::max_align_t);
+
+void* countedAlloc(size_t size) {
+    void* block = std::malloc(size + HEADER_SIZE);
+    if (!block) {
+        throw std::bad_alloc();
+    }
+    *static_cast<size_t*>(block) = size;
+    g_allocated_bytes += size;
+    size_t live = g_live_bytes += size;
+    size_t peak = g_peak_live_bytes.load();
+    while (live > peak && !g_peak_live_bytes.compare_exchange_weak(peak, live)) {
+    }
+    return static_cast<char*>(block) + HEADER_SIZE;
+}
+
+void countedFree(void* ptr) {
+    if (!ptr) return;
+    void* block = static_cast<char*>(ptr) - HEADER_SIZE;
+    g_live_bytes -= *static_cast<size_t*>(block);
+    std::free(block);
+}
+
+} // namespace
+
+void* operator new(size_t size) { return countedAlloc(size); }
+void* operator new[](size_t size) { return countedAlloc(size); }
+void operator delete(void* ptr) noexcept { countedFree(ptr); }
+void operator delete[](void* ptr) noexcept { countedFree(ptr); }
+void operator delete(void* ptr, size_t) noexcept { countedFree(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { countedFree(ptr); }
+
+namespace {
+
+using namespace UnityContextGen;
+
+struct StageMeasurement {
+    size_t allocated_bytes;
+    size_t peak_bytes;
+    size_t retained_bytes; // Still live in the returned AnalysisResult
+};
+
+std::string generateComponentSource(int index, int component_count) {
+    std::string name = "Component" + std::to_string(index);
+    std::string next = "Component" + std::to_string((index + 1) % component_count);
+
+    std::string source = "using UnityEngine;\n\n";
+    source += "[RequireComponent(typeof(Rigidbody))]\n";
+    source += "public class " + name + " : MonoBehaviour\n{\n";
+    source += "    [SerializeField] private " + next + " linked;\n";
+    source += "    [SerializeField] private float speed = 5f;\n";
+    source += "    [SerializeField] private int health = 100;\n";
+    source += "    private Rigidbody body;\n\n";
+    source += "    void Awake() { body = GetComponent<Rigidbody>(); }\n";
+    source += "    void Start() { linked = GetComponent<" + next + ">(); }\n";
+    source += "    void Update() { Move(); }\n";
+    source += "    void FixedUpdate() { body.AddForce(Vector3.up * speed); }\n";
+    source += "    void OnDestroy() { linked = null; }\n";
+    source += "    public void Move() { transform.position += Vector3.forward * speed; }\n";
+    source += "    public int GetHealth() { return health; }\n";
+    source += "}\n";
+    return source;
+}
+
+// One full CoreEngine::analyzeProject run with the given stages enabled
+StageMeasurement measureRun(const CoreEngine& engine, const std::vector<std::string>& source_files,
+                            const AnalysisOptions& options) {
+    size_t allocated_start = g_allocated_bytes;
+    size_t live_start = g_live_bytes;
+    g_peak_live_bytes = g_live_bytes.load();
+
+    AnalysisResult result = engine.analyzeProject(source_files, options);
+    StageMeasurement measurement{g_allocated_bytes - allocated_start, g_peak_live_bytes - live_start,
+                                 g_live_bytes - live_start};
+    if (!result.success) {
+        std::cerr << "Analysis failed: " << result.error_message << "\n";
+    }
+    return measurement;
+}
+
+void printMeasurement(const std::string& label, const StageMeasurement& before, const StageMeasurement& after) {
+    std::cout << label << "\n";
+    std::cout << "  run:   " << after.allocated_bytes << " bytes allocated, " << after.peak_bytes
+              << " bytes peak, " << after.retained_bytes << " bytes retained\n";
+    std::cout << "  stage: " << static_cast<long long>(after.allocated_bytes - before.allocated_bytes)
+              << " bytes allocated, " << static_cast<long long>(after.peak_bytes) - static_cast<long long>(before.peak_bytes)
+              << " bytes added to peak\n";
+}
+
+} // namespace
+
+// Runs CoreEngine::analyzeProject over a generated project with one more stage
+// enabled each time, so every stage is measured through the engine's own
+// hand-offs. Compare against another revision by running both binaries.
+int main(int argc, char* argv[]) {
+    int component_count = argc > 1 ? std::atoi(argv[1]) : 500;
+    if (component_count <= 0) {
+        std::cerr << "Usage: unity_context_memory_benchmark [component_count]\n";
+        return 1;
+    }
+
+    std::filesystem::path project_dir = std::filesystem::temp_directory_path() / "unity_context_memory_benchmark";
+    std::filesystem::remove_all(project_dir);
+    std::filesystem::create_directories(project_dir);
+    std::vector<std::string> source_files;
+    for (int i = 0; i < component_count; ++i) {
+        std::filesystem::path file_path = project_dir / ("Component" + std::to_string(i) + ".cs");
+        std::ofstream(file_path) << generateComponentSource(i, component_count);
+        source_files.push_back(file_path.string());
+    }
+
+    std::cout << "Pipeline stage memory benchmark (" << component_count << " components)\n";
+    std::cout << "====================================\n\n";
+
+    CoreEngine engine;
+    AnalysisOptions options;
+    options.analyze_dependencies = false;
+    options.analyze_lifecycle = false;
+    options.detect_patterns = false;
+    options.generate_metadata = false;
+    options.generate_context = false;
+    options.export_json = false;
+    options.analyze_scriptable_objects = false;
+    options.analyze_asset_references = false;
+
+    // Warm-up run so one-time parser and configuration allocations are not charged to a stage
+    measureRun(engine, source_files, options);
+
+    StageMeasurement none{0, 0, 0};
+    StageMeasurement collect = measureRun(engine, source_files, options);
+    printMeasurement("Collect MonoBehaviours", none, collect);
+
+    options.analyze_dependencies = true;
+    StageMeasurement dependencies = measureRun(engine, source_files, options);
+    printMeasurement("+ Dependency analysis", collect, dependencies);
+
+    options.analyze_lifecycle = true;
+    StageMeasurement lifecycle = measureRun(engine, source_files, options);
+    printMeasurement("+ Lifecycle analysis", dependencies, lifecycle);
+
+    options.detect_patterns = true;
+    StageMeasurement patterns = measureRun(engine, source_files, options);
+    printMeasurement("+ Pattern detection", lifecycle, patterns);
+
+    options.generate_metadata = true;
+    options.generate_context = true;
+    StageMeasurement metadata = measureRun(engine, source_files, options);
+    printMeasurement("+ Metadata and context", patterns, metadata);
+
+    std::filesystem::remove_all(project_dir);
+    return 0;
+}
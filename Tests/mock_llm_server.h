@@ -0,0 +1,529 @@
+#pragma once
+
+// Minimal loopback HTTP/1.1 server standing in for the Claude Messages API in
+// tests. Every request is recorded; replies come from a handler that returns
+// a canned Messages response by default, or a paced server-sent event stream.
+// Connections are kept alive between plain replies, so tests can see whether
+// the client reuses them. standIn() builds a handler that behaves like the
+// live API under load (latency, 429/500 errors, streaming, Message Batches
+// jobs) for benchmarks and offline runs. POSIX only; start() fails elsewhere.
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+struct MockHTTPRequest {
+    std::string method;
+    std::string path;
+    std::vector<std::pair<std::string, std::string>> headers;
+    std::string body;
+
+    static bool sameName(const std::string& a, const std::string& b) {
+        return a.size() == b.size() &&
+               std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+                   return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+               });
+    }
+
+    std::string header(const std::string& name) const {
+        for (const auto& entry : headers) {
+            if (sameName(entry.first, name)) {
+                return entry.second;
+            }
+        }
+        return "";
+    }
+};
+
+struct MockHTTPResponse {
+    int status_code = 200;
+    std::string content_type = "application/json";
+    std::vector<std::pair<std::string, std::string>> headers;
+    std::string body;
+
+    // When set, sent after body one at a time with a pause between, and the
+    // response is delimited by closing the connection (a streamed reply)
+    std::vector<std::string> chunks;
+    int chunk_delay_ms = 0;
+};
+
+// How the stand-in Messages endpoint behaves; error rates are fractions of requests
+struct MockLLMBehavior {
+    int latency_ms = 0;        // Before the reply's first byte
+    int latency_jitter_ms = 0; // Extra latency drawn uniformly from [0, jitter]
+    double rate_limit_rate = 0.0;
+    double server_error_rate = 0.0;
+    double retry_after_seconds = 0.0; // Sent with 429s when positive
+    int stream_chunk_delay_ms = 0;    // Pause between fragments of a streamed reply
+    int batch_processing_ms = 0;      // How long a batch job reports in_progress
+    unsigned seed = 1;                // Same seed, same error sequence
+};
+
+class MockLLMServer {
+public:
+    using Handler = std::function<MockHTTPResponse(const MockHTTPRequest&, size_t request_index)>;
+
+    MockLLMServer() : m_listen_fd(-1), m_port(0), m_running(false), m_connections(0) {
+        m_handler = [](const MockHTTPRequest&, size_t) { return messagesResponse("Mock analysis"); };
+    }
+
+    ~MockLLMServer() { stop(); }
+
+    MockLLMServer(const MockLLMServer&) = delete;
+    MockLLMServer& operator=(const MockLLMServer&) = delete;
+
+    void setHandler(Handler handler) { m_handler = std::move(handler); }
+
+    // Port 0 picks a free port; baseURL() reports the one bound
+    bool start(int port = 0) {
+#ifdef _WIN32
+        return false;
+#else
+        m_listen_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (m_listen_fd < 0) {
+            return false;
+        }
+
+        int reuse = 1;
+        ::setsockopt(m_listen_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons(static_cast<uint16_t>(port));
+        socklen_t length = sizeof(address);
+        if (::bind(m_listen_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+            ::listen(m_listen_fd, 64) != 0 ||
+            ::getsockname(m_listen_fd, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+            ::close(m_listen_fd);
+            m_listen_fd = -1;
+            return false;
+        }
+
+        m_port = ntohs(address.sin_port);
+        m_running = true;
+        m_thread = std::thread(&MockLLMServer::acceptLoop, this);
+        return true;
+#endif
+    }
+
+    void stop() {
+        if (!m_running.exchange(false)) {
+            return;
+        }
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+        std::lock_guard<std::mutex> lock(m_workers_mutex);
+        for (auto& worker : m_workers) {
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+        m_workers.clear();
+#ifndef _WIN32
+        ::close(m_listen_fd);
+#endif
+        m_listen_fd = -1;
+    }
+
+    std::string baseURL() const { return "http://127.0.0.1:" + std::to_string(m_port); }
+
+    std::vector<MockHTTPRequest> requests() const {
+        std::lock_guard<std::mutex> lock(m_requests_mutex);
+        return m_requests;
+    }
+
+    // TCP connections accepted so far
+    size_t connections() const { return m_connections; }
+
+    // Canned Messages API reply; cache_read tokens let tests exercise usage accounting
+    static MockHTTPResponse messagesResponse(const std::string& text, int input_tokens = 100,
+                                             int cache_creation_tokens = 0, int cache_read_tokens = 0) {
+        MockHTTPResponse response;
+        response.body = "{\"id\":\"msg_mock\",\"type\":\"message\",\"role\":\"assistant\","
+                        "\"content\":[{\"type\":\"text\",\"text\":\"" + escape(text) + "\"}],"
+                        "\"stop_reason\":\"end_turn\",\"usage\":{\"input_tokens\":" + std::to_string(input_tokens) +
+                        ",\"cache_creation_input_tokens\":" + std::to_string(cache_creation_tokens) +
+                        ",\"cache_read_input_tokens\":" + std::to_string(cache_read_tokens) +
+                        ",\"output_tokens\":20}}";
+        return response;
+    }
+
+    // Server-sent event stream in the Messages API format, one text delta per
+    // fragment, each fragment sent as its own chunk
+    static MockHTTPResponse streamingMessagesResponse(const std::vector<std::string>& fragments,
+                                                      int chunk_delay_ms = 0, int input_tokens = 100) {
+        MockHTTPResponse response;
+        response.content_type = "text/event-stream";
+        response.chunk_delay_ms = chunk_delay_ms;
+        response.body = sseEvent("message_start",
+                                 "{\"type\":\"message_start\",\"message\":{\"id\":\"msg_mock\",\"type\":\"message\","
+                                 "\"role\":\"assistant\",\"content\":[],\"usage\":{\"input_tokens\":" +
+                                 std::to_string(input_tokens) + ",\"cache_creation_input_tokens\":0,"
+                                 "\"cache_read_input_tokens\":0,\"output_tokens\":1}}}") +
+                        sseEvent("content_block_start",
+                                 "{\"type\":\"content_block_start\",\"index\":0,"
+                                 "\"content_block\":{\"type\":\"text\",\"text\":\"\"}}");
+        for (const auto& fragment : fragments) {
+            response.chunks.push_back(sseEvent("content_block_delta",
+                "{\"type\":\"content_block_delta\",\"index\":0,"
+                "\"delta\":{\"type\":\"text_delta\",\"text\":\"" + escape(fragment) + "\"}}"));
+        }
+        response.chunks.push_back(sseEvent("content_block_stop", "{\"type\":\"content_block_stop\",\"index\":0}") +
+                                  sseEvent("message_delta", "{\"type\":\"message_delta\","
+                                           "\"delta\":{\"stop_reason\":\"end_turn\"},\"usage\":{\"output_tokens\":20}}") +
+                                  sseEvent("message_stop", "{\"type\":\"message_stop\"}"));
+        return response;
+    }
+
+    // Replies like the live API: a review in the Messages format, streamed
+    // when the request asks for it, with the configured latency and errors.
+    // Message Batches jobs are accepted at /v1/messages/batches, end after
+    // batch_processing_ms and serve one review per request as JSONL results.
+    static Handler standIn(const MockLLMBehavior& behavior) {
+        auto state = std::make_shared<StandInState>();
+        state->random.seed(behavior.seed);
+
+        return [behavior, state](const MockHTTPRequest& request, size_t) {
+            double roll;
+            int latency_ms = behavior.latency_ms;
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                roll = std::uniform_real_distribution<double>(0.0, 1.0)(state->random);
+                if (behavior.latency_jitter_ms > 0) {
+                    latency_ms += std::uniform_int_distribution<int>(0, behavior.latency_jitter_ms)(state->random);
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(latency_ms));
+
+            if (roll < behavior.rate_limit_rate) {
+                MockHTTPResponse response;
+                response.status_code = 429;
+                response.body = "{\"type\":\"error\",\"error\":{\"type\":\"rate_limit_error\","
+                                "\"message\":\"Mock rate limit\"}}";
+                if (behavior.retry_after_seconds > 0) {
+                    response.headers.emplace_back("retry-after", std::to_string(behavior.retry_after_seconds));
+                }
+                return response;
+            }
+            if (roll < behavior.rate_limit_rate + behavior.server_error_rate) {
+                MockHTTPResponse response;
+                response.status_code = 500;
+                response.body = "{\"type\":\"error\",\"error\":{\"type\":\"api_error\","
+                                "\"message\":\"Mock server error\"}}";
+                return response;
+            }
+
+            static const std::vector<std::string> review = {
+                "**Overall Assessment**\nReasonable component structure.\n\n",
+                "**Key Issues**\n- GetComponent is called every frame\n",
+                "\n**Performance Concerns**\n- Cache component references in Awake\n",
+                "\n**Unity Best Practices**\n- Prefer SerializeField over public fields\n"
+            };
+            std::string text;
+            for (const auto& fragment : review) {
+                text += fragment;
+            }
+
+            static const std::string batches_path = "/v1/messages/batches";
+            if (request.path.compare(0, batches_path.size(), batches_path) == 0) {
+                return batchResponse(request, request.path.substr(batches_path.size()), text, behavior, *state);
+            }
+
+            int input_tokens = static_cast<int>(request.body.size() / 4);
+            if (request.body.find("\"stream\":true") != std::string::npos) {
+                return streamingMessagesResponse(review, behavior.stream_chunk_delay_ms, input_tokens);
+            }
+            return messagesResponse(text, input_tokens);
+        };
+    }
+
+private:
+    int m_listen_fd;
+    int m_port;
+    std::atomic<bool> m_running;
+    std::atomic<size_t> m_connections;
+    std::thread m_thread;
+    Handler m_handler;
+
+    mutable std::mutex m_requests_mutex;
+    std::vector<MockHTTPRequest> m_requests;
+
+    std::mutex m_workers_mutex;
+    std::vector<std::thread> m_workers;
+
+    struct StandInBatch {
+        std::chrono::steady_clock::time_point created;
+        std::string results; // JSONL, one line per request
+        size_t request_count;
+    };
+
+    // Shared by concurrent connections of one stand-in handler
+    struct StandInState {
+        std::mutex mutex;
+        std::mt19937 random;
+        std::map<std::string, StandInBatch> batches;
+    };
+
+    // Create (POST ""), status (GET "/{id}") and results (GET "/{id}/results")
+    static MockHTTPResponse batchResponse(const MockHTTPRequest& request, const std::string& route,
+                                          const std::string& review_text, const MockLLMBehavior& behavior,
+                                          StandInState& state) {
+        using json = nlohmann::json;
+        MockHTTPResponse response;
+        std::lock_guard<std::mutex> lock(state.mutex);
+
+        if (request.method == "POST" && route.empty()) {
+            json body = json::parse(request.body, nullptr, false);
+            if (!body.is_object() || !body.contains("requests") || !body["requests"].is_array()) {
+                response.status_code = 400;
+                response.body = "{\"type\":\"error\",\"error\":{\"type\":\"invalid_request_error\","
+                                "\"message\":\"requests must be an array\"}}";
+                return response;
+            }
+            std::string id = "msgbatch_mock_" + std::to_string(state.batches.size() + 1);
+            StandInBatch& batch = state.batches[id];
+            batch.created = std::chrono::steady_clock::now();
+            batch.request_count = body["requests"].size();
+            for (const auto& entry : body["requests"]) {
+                json message = json::parse(messagesResponse(review_text,
+                    static_cast<int>(entry.value("params", json::object()).dump().size() / 4)).body);
+                batch.results += json{{"custom_id", entry.value("custom_id", "")},
+                                      {"result", {{"type", "succeeded"}, {"message", message}}}}.dump() + "\n";
+            }
+            response.body = batchStatus(id, batch, behavior).dump();
+            return response;
+        }
+
+        std::string id = route.empty() ? "" : route.substr(1);
+        bool results = false;
+        static const std::string results_suffix = "/results";
+        if (id.size() > results_suffix.size() &&
+            id.compare(id.size() - results_suffix.size(), results_suffix.size(), results_suffix) == 0) {
+            id.resize(id.size() - results_suffix.size());
+            results = true;
+        }
+        auto it = state.batches.find(id);
+        if (request.method != "GET" || it == state.batches.end()) {
+            response.status_code = 404;
+            response.body = "{\"type\":\"error\",\"error\":{\"type\":\"not_found_error\","
+                            "\"message\":\"No such batch\"}}";
+            return response;
+        }
+        json status = batchStatus(id, it->second, behavior);
+        if (!results) {
+            response.body = status.dump();
+        } else if (status["processing_status"] != "ended") {
+            response.status_code = 400;
+            response.body = "{\"type\":\"error\",\"error\":{\"type\":\"invalid_request_error\","
+                            "\"message\":\"Batch is still processing\"}}";
+        } else {
+            response.content_type = "application/x-jsonl";
+            response.body = it->second.results;
+        }
+        return response;
+    }
+
+    static nlohmann::json batchStatus(const std::string& id, const StandInBatch& batch,
+                                      const MockLLMBehavior& behavior) {
+        bool ended = std::chrono::steady_clock::now() - batch.created >=
+                     std::chrono::milliseconds(behavior.batch_processing_ms);
+        size_t count = batch.request_count;
+        return {
+            {"id", id},
+            {"type", "message_batch"},
+            {"processing_status", ended ? "ended" : "in_progress"},
+            {"request_counts", {{"processing", ended ? 0 : count}, {"succeeded", ended ? count : 0},
+                                {"errored", 0}, {"canceled", 0}, {"expired", 0}}}
+        };
+    }
+
+    static std::string sseEvent(const std::string& name, const std::string& data) {
+        return "event: " + name + "\ndata: " + data + "\n\n";
+    }
+
+    static std::string escape(const std::string& text) {
+        std::string escaped;
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                escaped += '\\';
+                escaped += c;
+            } else if (c == '\n') {
+                escaped += "\\n";
+            } else {
+                escaped += c;
+            }
+        }
+        return escaped;
+    }
+
+#ifndef _WIN32
+    void acceptLoop() {
+        while (m_running) {
+            pollfd listener{m_listen_fd, POLLIN, 0};
+            if (::poll(&listener, 1, 50) <= 0) {
+                continue;
+            }
+            int client = ::accept(m_listen_fd, nullptr, nullptr);
+            if (client < 0) {
+                continue;
+            }
+            ++m_connections;
+            // One thread per connection so concurrent clients are not serialized
+            std::lock_guard<std::mutex> lock(m_workers_mutex);
+            m_workers.emplace_back(&MockLLMServer::serve, this, client);
+        }
+    }
+
+    // Serves requests on one connection until the client closes it, a
+    // streamed reply ends it, or the server stops
+    void serve(int client) {
+        bool keep_alive = true;
+        while (keep_alive && waitForRequest(client)) {
+            MockHTTPRequest request;
+            if (!readRequest(client, request)) {
+                break;
+            }
+            size_t index;
+            {
+                std::lock_guard<std::mutex> lock(m_requests_mutex);
+                index = m_requests.size();
+                m_requests.push_back(request);
+            }
+            MockHTTPResponse response = m_handler(request, index);
+            keep_alive = response.chunks.empty() &&
+                         !MockHTTPRequest::sameName(request.header("Connection"), "close");
+            if (!writeResponse(client, response, keep_alive)) {
+                break;
+            }
+        }
+        ::close(client);
+    }
+
+    // False once the server is stopping or the client hung up
+    bool waitForRequest(int client) const {
+        while (m_running) {
+            pollfd connection{client, POLLIN, 0};
+            int ready = ::poll(&connection, 1, 50);
+            if (ready > 0) {
+                return (connection.revents & POLLIN) != 0;
+            }
+            if (ready < 0) {
+                return false;
+            }
+        }
+        return false;
+    }
+
+    static bool readRequest(int client, MockHTTPRequest& request) {
+        std::string data;
+        char buffer[8192];
+        size_t header_end = std::string::npos;
+        while (header_end == std::string::npos) {
+            ssize_t received = ::recv(client, buffer, sizeof(buffer), 0);
+            if (received <= 0) {
+                return false;
+            }
+            data.append(buffer, static_cast<size_t>(received));
+            header_end = data.find("\r\n\r\n");
+        }
+
+        size_t line_end = data.find("\r\n");
+        std::string request_line = data.substr(0, line_end);
+        size_t first_space = request_line.find(' ');
+        size_t second_space = request_line.find(' ', first_space + 1);
+        request.method = request_line.substr(0, first_space);
+        request.path = request_line.substr(first_space + 1, second_space - first_space - 1);
+
+        size_t content_length = 0;
+        size_t position = line_end + 2;
+        while (position < header_end) {
+            size_t next = data.find("\r\n", position);
+            std::string line = data.substr(position, next - position);
+            size_t colon = line.find(':');
+            if (colon != std::string::npos) {
+                std::string name = line.substr(0, colon);
+                std::string value = line.substr(colon + 1);
+                value.erase(0, value.find_first_not_of(' '));
+                request.headers.emplace_back(name, value);
+                if (MockHTTPRequest::sameName(name, "Content-Length")) {
+                    content_length = static_cast<size_t>(std::stoul(value));
+                }
+            }
+            position = next + 2;
+        }
+
+        // curl holds back large bodies until the server agrees to take them
+        if (MockHTTPRequest::sameName(request.header("Expect"), "100-continue")) {
+            static const char continue_line[] = "HTTP/1.1 100 Continue\r\n\r\n";
+            ::send(client, continue_line, sizeof(continue_line) - 1, MSG_NOSIGNAL);
+        }
+
+        request.body = data.substr(header_end + 4);
+        while (request.body.size() < content_length) {
+            ssize_t received = ::recv(client, buffer, sizeof(buffer), 0);
+            if (received <= 0) {
+                return false;
+            }
+            request.body.append(buffer, static_cast<size_t>(received));
+        }
+        return true;
+    }
+
+    static bool writeResponse(int client, const MockHTTPResponse& response, bool keep_alive) {
+        std::string head = "HTTP/1.1 " + std::to_string(response.status_code) + " Mock\r\n";
+        head += "Content-Type: " + response.content_type + "\r\n";
+        if (response.chunks.empty()) {
+            head += "Content-Length: " + std::to_string(response.body.size()) + "\r\n";
+        }
+        for (const auto& header : response.headers) {
+            head += header.first + ": " + header.second + "\r\n";
+        }
+        head += keep_alive ? "Connection: keep-alive\r\n\r\n" : "Connection: close\r\n\r\n";
+
+        if (!sendAll(client, head + response.body)) {
+            return false;
+        }
+        for (const auto& chunk : response.chunks) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(response.chunk_delay_ms));
+            if (!sendAll(client, chunk)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static bool sendAll(int client, const std::string& payload) {
+        size_t sent = 0;
+        while (sent < payload.size()) {
+            ssize_t written = ::send(client, payload.data() + sent, payload.size() - sent, MSG_NOSIGNAL);
+            if (written <= 0) {
+                return false;
+            }
+            sent += static_cast<size_t>(written);
+        }
+        return true;
+    }
+#endif
+};
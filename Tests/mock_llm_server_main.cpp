@@ -0,0 +1,69 @@
+#include "mock_llm_server.h"
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace {
+std::atomic<bool> g_stop_requested(false);
+}
+
+// Stand-in for the Messages and Message Batches APIs, for running the CLI
+// or plugin without an API key: point ai.api_base_url at the printed URL.
+int main(int argc, char* argv[]) {
+    int port = 8089;
+    MockLLMBehavior behavior;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!value) {
+            std::cerr << "Missing value for " << arg << "\n";
+            return 1;
+        }
+        if (arg == "--port") {
+            port = std::atoi(value);
+        } else if (arg == "--latency-ms") {
+            behavior.latency_ms = std::atoi(value);
+        } else if (arg == "--jitter-ms") {
+            behavior.latency_jitter_ms = std::atoi(value);
+        } else if (arg == "--rate-limit-rate") {
+            behavior.rate_limit_rate = std::atof(value);
+        } else if (arg == "--error-rate") {
+            behavior.server_error_rate = std::atof(value);
+        } else if (arg == "--retry-after") {
+            behavior.retry_after_seconds = std::atof(value);
+        } else if (arg == "--stream-delay-ms") {
+            behavior.stream_chunk_delay_ms = std::atoi(value);
+        } else if (arg == "--batch-ms") {
+            behavior.batch_processing_ms = std::atoi(value);
+        } else {
+            std::cerr << "Usage: unity_context_mock_llm [--port N] [--latency-ms N] [--jitter-ms N]\n"
+                      << "       [--rate-limit-rate F] [--error-rate F] [--retry-after S] [--stream-delay-ms N]\n"
+                      << "       [--batch-ms N]\n";
+            return 1;
+        }
+        ++i;
+    }
+
+    MockLLMServer server;
+    server.setHandler(MockLLMServer::standIn(behavior));
+    if (!server.start(port)) {
+        std::cerr << "Could not listen on port " << port << "\n";
+        return 1;
+    }
+
+    std::signal(SIGINT, [](int) { g_stop_requested = true; });
+    std::signal(SIGTERM, [](int) { g_stop_requested = true; });
+    std::cout << "Mock Messages API listening on " << server.baseURL() << " (Ctrl+C to stop)" << std::endl;
+    while (!g_stop_requested) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    server.stop();
+    std::cout << server.requests().size() << " requests served" << std::endl;
+    return 0;
+}
@@ -0,0 +1,227 @@
+#include "../Core/ContextSummarizer/ArchitectureAnalyzer.h"
+#include "../Core/ContextSummarizer/DataFlowAnalyzer.h"
+#include "../Core/ContextSummarizer/ProjectSummarizer.h"
+#include "test_framework.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+using namespace UnityContextGen::Context;
+
+DataFlowNode makeFlowNode(const std::string& name, DataFlowDirection direction,
+                          std::vector<std::string> connected, float weight = 0.2f) {
+    DataFlowNode node;
+    node.component_name = name;
+    node.data_type = "Game Data";
+    node.direction = direction;
+    node.connected_components = std::move(connected);
+    node.priority_level = 1;
+    node.criticality_weight = weight;
+    return node;
+}
+
+UnityContextGen::Metadata::ComponentMetadata makeComponentMetadata(const std::string& name,
+                                                                  std::vector<std::string> dependencies,
+                                                                  std::vector<std::string> dependents) {
+    UnityContextGen::Metadata::ComponentMetadata component{};
+    component.class_name = name;
+    component.dependencies = std::move(dependencies);
+    component.dependents = std::move(dependents);
+    component.metrics.dependency_count = static_cast<int>(component.dependencies.size());
+    return component;
+}
+
+} // namespace
+
+void test_context_summarizer() {
+    // Test 1: Members of a dependency cycle appear in node order, whatever the edge order
+    {
+        DataFlowAnalyzer analyzer;
+        std::vector<DataFlowNode> forward = {
+            makeFlowNode("InputReader", DataFlowDirection::Input, {"Mover"}),
+            makeFlowNode("Mover", DataFlowDirection::Processing, {"Physics"}),
+            makeFlowNode("Physics", DataFlowDirection::Processing, {"Mover"})
+        };
+        std::vector<DataFlowNode> reversed = forward;
+        reversed[0].connected_components = {"Physics"};
+
+        auto forward_flows = analyzer.identifyPrimaryFlows(forward);
+        auto reversed_flows = analyzer.identifyPrimaryFlows(reversed);
+        std::vector<std::string> expected = {"InputReader", "Mover", "Physics"};
+
+        if (!forward_flows.empty() && !reversed_flows.empty() &&
+            forward_flows.front().path_components == expected &&
+            reversed_flows.front().path_components == expected) {
+            g_test_results.push_back({"DataFlowAnalyzer_DeterministicCycles", true, "Cycle members are listed in node order"});
+        } else {
+            g_test_results.push_back({"DataFlowAnalyzer_DeterministicCycles", false, "Cycle member order depended on traversal"});
+        }
+    }
+
+    // Test 2: The path memo is keyed by the whole graph, not a digest of it
+    {
+        DataFlowAnalyzer analyzer;
+        std::vector<DataFlowNode> to_audio = {
+            makeFlowNode("InputReader", DataFlowDirection::Input, {"AudioMixer"}),
+            makeFlowNode("AudioMixer", DataFlowDirection::Output, {}),
+            makeFlowNode("HealthBar", DataFlowDirection::Output, {})
+        };
+        std::vector<DataFlowNode> to_health = to_audio;
+        to_health[0].connected_components = {"HealthBar"};
+
+        auto first = analyzer.identifyPrimaryFlows(to_audio);
+        auto second = analyzer.identifyPrimaryFlows(to_health);
+        auto again = analyzer.identifyPrimaryFlows(to_health);
+
+        bool first_ok = !first.empty() && first.front().path_components.back() == "AudioMixer";
+        bool second_ok = !second.empty() && second.front().path_components.back() == "HealthBar";
+        bool again_ok = !again.empty() && again.front().path_components == second.front().path_components;
+
+        if (first_ok && second_ok && again_ok) {
+            g_test_results.push_back({"DataFlowAnalyzer_MemoByContent", true, "Changed edges produce fresh paths; identical graphs reuse them"});
+        } else {
+            g_test_results.push_back({"DataFlowAnalyzer_MemoByContent", false, "Memoized paths did not match the graph asked about"});
+        }
+    }
+
+    // Test 3: Budgets cap the result, and a search cut short by the deadline is reported every time
+    {
+        std::vector<DataFlowNode> nodes;
+        for (int i = 0; i < 6; ++i) {
+            std::vector<std::string> connected;
+            if (i < 5) {
+                connected.push_back("Stage" + std::to_string(i + 1));
+            }
+            nodes.push_back(makeFlowNode(i == 0 ? "InputReader" : "Stage" + std::to_string(i),
+                                         i == 0 ? DataFlowDirection::Input : DataFlowDirection::Processing,
+                                         connected));
+        }
+        nodes[0].connected_components.push_back("Stage3");
+
+        DataFlowAnalyzer analyzer;
+        DataFlowBudget budget;
+        budget.max_paths = 1;
+        budget.max_path_length = 4;
+        analyzer.setBudget(budget);
+        auto capped = analyzer.identifyPrimaryFlows(nodes);
+        bool capped_ok = capped.size() == 1 && capped.front().path_components.size() <= 4;
+
+        UnityContextGen::Metadata::ProjectMetadata metadata{};
+        metadata.components["InputHandler"] = makeComponentMetadata("InputHandler", {"Mover"}, {});
+        metadata.components["Mover"] = makeComponentMetadata("Mover", {}, {"InputHandler"});
+
+        budget = DataFlowBudget();
+        budget.time_budget_ms = -1; // Deadline already passed
+        analyzer.setBudget(budget);
+        bool exhausted_first = analyzer.analyzeDataFlow(metadata).path_budget_exhausted;
+        bool exhausted_again = analyzer.analyzeDataFlow(metadata).path_budget_exhausted;
+
+        analyzer.setBudget(DataFlowBudget());
+        auto complete = analyzer.analyzeDataFlow(metadata);
+
+        if (capped_ok && exhausted_first && exhausted_again && !complete.path_budget_exhausted &&
+            !complete.primary_flows.empty()) {
+            g_test_results.push_back({"DataFlowAnalyzer_Budget", true, "Path count, length and deadline limits applied"});
+        } else {
+            g_test_results.push_back({"DataFlowAnalyzer_Budget", false, "Path budget was not applied or reported"});
+        }
+    }
+    
+    // Test 4: Health scores come from the single statistics walk
+    {
+        UnityContextGen::Metadata::ProjectMetadata metadata{};
+        std::vector<std::string> hub_users;
+        for (int i = 0; i < 5; ++i) {
+            std::string name = "Enemy" + std::to_string(i);
+            hub_users.push_back(name);
+            metadata.components[name] = makeComponentMetadata(name, {"GameManager"}, {});
+        }
+        auto manager = makeComponentMetadata("GameManager", {}, hub_users);
+        manager.metrics.method_count = 20;
+        manager.lifecycle.methods = {"Awake", "Update"};
+        metadata.components["GameManager"] = manager;
+        metadata.dependencies.high_coupling_components = {"GameManager"};
+        metadata.dependencies.has_circular_dependencies = true;
+        metadata.patterns.pattern_frequency["Observer Pattern"] = 2;
+        
+        ArchitectureAnalyzer analyzer;
+        ProjectStatistics statistics = analyzer.computeProjectStatistics(metadata);
+        ArchitectureHealth health = analyzer.assessArchitectureHealth(metadata, statistics);
+        ArchitectureHealth from_metadata = analyzer.assessArchitectureHealth(metadata);
+        
+        bool statistics_ok = statistics.high_coupling_count == 1 && statistics.has_circular_dependencies &&
+                             statistics.manager_count == 1 && statistics.update_method_count == 1 &&
+                             statistics.total_pattern_instances == 2 && statistics.has_observer_pattern &&
+                             statistics.countAbove(statistics.method_count_distribution, 15) == 1;
+        // 80 - 30 for the cycle - 5 per highly coupled component
+        bool inversion_ok = health.dependency_inversion_score == 45.0f;
+        // 100 - 5 per component above 15 methods
+        bool responsibility_ok = health.single_responsibility_score == 95.0f;
+        bool overloads_agree = health.overall_health_score == from_metadata.overall_health_score;
+        
+        if (statistics_ok && inversion_ok && responsibility_ok && overloads_agree) {
+            g_test_results.push_back({"ArchitectureAnalyzer_ProjectStatistics", true, "Health scores derived from project statistics"});
+        } else {
+            g_test_results.push_back({"ArchitectureAnalyzer_ProjectStatistics", false, "Project statistics or health scores were wrong"});
+        }
+    }
+
+    // Test 5: The packed prompt depends on the tree, not on when it is packed
+    {
+        namespace fs = std::filesystem;
+        fs::path project_dir = fs::temp_directory_path() / "test_context_recency";
+        fs::remove_all(project_dir);
+        fs::create_directories(project_dir);
+
+        UnityContextGen::Metadata::ProjectMetadata metadata{};
+        std::vector<fs::path> files;
+        auto month_ago = fs::file_time_type::clock::now() - std::chrono::hours(24 * 30);
+        int hours_apart = 0;
+        for (const char* name : {"PlayerController", "EnemyAI", "GameManager", "HealthBar"}) {
+            fs::path file_path = project_dir / (std::string(name) + ".cs");
+            std::ofstream(file_path) << "public class " << name << " : MonoBehaviour {}\n";
+            fs::last_write_time(file_path, month_ago + std::chrono::hours(hours_apart));
+            hours_apart += 12;
+            files.push_back(file_path);
+
+            auto component = makeComponentMetadata(name, {}, {});
+            component.file_path = file_path.string();
+            component.purpose = std::string("Handles ") + name;
+            metadata.components[name] = component;
+        }
+
+        ProjectSummarizer summarizer;
+        auto pack = [&summarizer, &metadata]() {
+            ProjectContext context = summarizer.generateProjectContext(metadata);
+            return std::make_pair(context.component_relevance, summarizer.generateLLMContextPrompt(context, metadata, 300));
+        };
+        auto first = pack();
+        auto again = pack();
+        std::string review_prefix = summarizer.generateReviewContextPrompt(
+            summarizer.generateProjectContext(metadata), metadata, 300);
+
+        // A year passing moves every timestamp equally, which must not reorder anything
+        for (const auto& file_path : files) {
+            fs::last_write_time(file_path, fs::last_write_time(file_path) - std::chrono::hours(24 * 365));
+        }
+        auto year_later = pack();
+
+        // Editing a script shifts recency scores, but the AI review prefix ignores them
+        fs::last_write_time(files.front(), fs::file_time_type::clock::now());
+        bool prefix_stable = summarizer.generateReviewContextPrompt(
+            summarizer.generateProjectContext(metadata), metadata, 300) == review_prefix;
+        fs::remove_all(project_dir);
+
+        bool recency_used = first.first["HealthBar"] > first.first["EnemyAI"];
+        if (first == again && first == year_later && recency_used && prefix_stable) {
+            g_test_results.push_back({"ProjectSummarizer_DeterministicPacking", true, "Same tree, same scores and prompt"});
+        } else {
+            g_test_results.push_back({"ProjectSummarizer_DeterministicPacking", false,
+                "Relevance or packed prompt changed with the clock (recency_used=" + std::to_string(recency_used) +
+                ", prefix_stable=" + std::to_string(prefix_stable) + ")"});
+        }
+    }
+}
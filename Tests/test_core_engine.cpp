@@ -2,6 +2,8 @@
 #include "test_framework.h"
 #include <iostream>
 #include <filesystem>
+#include <fstream>
+#include <sstream>
 
 void test_core_engine() {
     using namespace UnityContextGen;
@@ -215,4 +217,228 @@ void test_core_engine() {
         
         engine.setVerbose(false);
     }
-}
\ No newline at end of file
+    
+    // Test 11: Output-driven stage pruning
+    {
+        AnalysisStageSet prompt_stages = stagesForArtifacts(artifactsForFormat(OutputFormat::LLMPrompt));
+        bool plan_ok = hasStage(prompt_stages, AnalysisStage::Context) &&
+                       hasStage(prompt_stages, AnalysisStage::Metadata) &&
+                       !hasStage(prompt_stages, AnalysisStage::APIUsage) &&
+                       !hasStage(prompt_stages, AnalysisStage::ScriptableObjects);
+        
+        std::string output_dir = "test_output_pruning";
+        std::filesystem::remove_all(output_dir);
+        
+        CoreEngine engine;
+        AnalysisOptions options;
+        options.output_directory = output_dir;
+        options.output_format = OutputFormat::LLMPrompt;
+        
+        auto result = engine.analyzeSingleFile("SampleUnityProject/PlayerController.cs", options);
+        
+        bool prompt_written = std::filesystem::exists(output_dir + "/llm_prompt.md");
+        bool report_skipped = !std::filesystem::exists(output_dir + "/detailed_report.md") &&
+                              !std::filesystem::exists(output_dir + "/project_metadata.json");
+        bool stages_skipped = result.api_usage.empty() && result.scriptable_objects.empty();
+        std::filesystem::remove_all(output_dir);
+        
+        if (plan_ok && result.success && prompt_written && report_skipped && stages_skipped) {
+            g_test_results.push_back({"CoreEngine_OutputStagePruning", true, "LLM prompt output skipped unused stages and renderers"});
+        } else {
+            g_test_results.push_back({"CoreEngine_OutputStagePruning", false, "Output format did not prune stages and artifacts"});
+        }
+    }
+    
+    // Test 12: Parallel export writes every artifact from the analysis result alone
+    {
+        std::string output_dir = "test_output_parallel";
+        std::string source_dir = "test_parallel_sources";
+        std::filesystem::remove_all(output_dir);
+        std::filesystem::remove_all(source_dir);
+        std::filesystem::create_directories(source_dir);
+        std::filesystem::copy("SampleUnityProject", source_dir, std::filesystem::copy_options::recursive);
+        
+        CoreEngine engine;
+        AnalysisOptions options;
+        options.output_directory = output_dir;
+        options.export_json = false;
+        
+        auto result = engine.analyzeDirectory(source_dir, options);
+        size_t parsed_by_analysis = engine.getSourceFilesParsed();
+        std::string expected_summary = engine.generateQuickSummary(result);
+        std::string expected_report = engine.generateDetailedReport(result);
+        std::string expected_prompt = engine.generateLLMPrompt(result, options.context_token_budget);
+        
+        // Stale-source trap: an export that went back to the sources would find nothing
+        std::filesystem::remove_all(source_dir);
+        bool exported = result.success && engine.exportResults(result, options);
+        
+        auto readFile = [&output_dir](const char* file_name) {
+            std::ifstream file(std::filesystem::path(output_dir) / file_name);
+            std::stringstream contents;
+            contents << file.rdbuf();
+            return contents.str();
+        };
+        
+        bool contents_match = readFile("summary.md") == expected_summary &&
+                              readFile("detailed_report.md") == expected_report &&
+                              readFile("llm_prompt.md") == expected_prompt;
+        try {
+            auto metadata_json = nlohmann::json::parse(readFile("project_metadata.json"));
+            auto context_json = nlohmann::json::parse(readFile("project_context.json"));
+            auto llm_json = nlohmann::json::parse(readFile("llm_optimized.json"));
+            contents_match = contents_match &&
+                             metadata_json["component_overview"].size() == result.project_metadata.components.size() &&
+                             context_json["summary"]["project_type"] == result.project_context.summary.project_type &&
+                             llm_json["component_guidance"].size() == result.project_context.llm_context.component_purposes.size();
+        } catch (const std::exception&) {
+            contents_match = false;
+        }
+        bool not_reparsed = parsed_by_analysis > 0 && engine.getSourceFilesParsed() == parsed_by_analysis;
+        std::filesystem::remove_all(output_dir);
+        
+        if (exported && contents_match && not_reparsed) {
+            g_test_results.push_back({"CoreEngine_ParallelExport", true, "All artifacts rendered from the analysis result without reparsing"});
+        } else {
+            g_test_results.push_back({"CoreEngine_ParallelExport", false, "Parallel export missed, changed or reparsed artifacts"});
+        }
+    }
+    
+    // Test 13: Token-budgeted LLM prompt stays within budget and reports what it dropped
+    {
+        CoreEngine engine;
+        AnalysisOptions options;
+        options.export_json = false;
+        
+        auto result = engine.analyzeDirectory("SampleUnityProject", options);
+        
+        Context::PackingReport full_report;
+        std::string full_prompt = engine.generateLLMPrompt(result, 1000000, &full_report);
+        
+        size_t budget = Context::estimateTokens(full_prompt) / 2;
+        Context::PackingReport report;
+        std::string packed_prompt = engine.generateLLMPrompt(result, budget, &report);
+        
+        bool full_kept = full_report.dropped.empty();
+        bool within_budget = report.over_budget || Context::estimateTokens(packed_prompt) <= budget;
+        bool reported = !report.dropped.empty() &&
+                        packed_prompt.find("## Omitted for Context Budget") != std::string::npos;
+        
+        if (result.success && full_kept && within_budget && reported) {
+            g_test_results.push_back({"CoreEngine_TokenBudgetedPrompt", true, "Prompt packed into budget with dropped sections reported"});
+        } else {
+            g_test_results.push_back({"CoreEngine_TokenBudgetedPrompt", false, "Prompt exceeded budget or did not report drops"});
+        }
+    }
+    
+    // Test 14: Focused k-hop context is served from the exported component index
+    {
+        std::string output_dir = "test_output_focus";
+        std::filesystem::remove_all(output_dir);
+        
+        AnalysisOptions options;
+        options.output_directory = output_dir;
+        options.output_format = OutputFormat::JSON;
+        
+        CoreEngine engine;
+        auto result = engine.analyzeDirectory("SampleUnityProject", options);
+        bool index_written = std::filesystem::exists(std::filesystem::path(output_dir) / "component_index.json");
+        
+        // A fresh engine has no in-memory index, so this reads component_index.json
+        CoreEngine query_engine;
+        auto focused = query_engine.generateFocusedContextForDirectory("SampleUnityProject", "GameManager", 1, options);
+        auto by_file = query_engine.generateFocusedContextForDirectory("SampleUnityProject",
+                                                                       "SampleUnityProject/PlayerController.cs", 0, options);
+        
+        bool within_hops = true;
+        for (const auto& neighbour : focused.neighbours) {
+            if (neighbour.distance != 1 || neighbour.component == "GameManager") {
+                within_hops = false;
+            }
+        }
+        bool focused_ok = focused.found && focused.focus == "GameManager" &&
+                          focused.prompt.find("# Focused Context: GameManager") != std::string::npos;
+        bool file_ok = by_file.found && by_file.focus == "PlayerController" && by_file.neighbours.empty();
+        bool not_reanalyzed = query_engine.getSourceFilesParsed() == 0;
+        std::filesystem::remove_all(output_dir);
+        
+        if (result.success && index_written && focused_ok && within_hops && file_ok && not_reanalyzed) {
+            g_test_results.push_back({"CoreEngine_FocusedContext", true, "Focused neighbourhood served from component index"});
+        } else {
+            g_test_results.push_back({"CoreEngine_FocusedContext", false, "Focused context query reanalyzed sources or returned the wrong neighbourhood"});
+        }
+    }
+    
+    // Test 15: Ranked symbol search is served from the persisted symbol index
+    {
+        std::string output_dir = "test_output_search";
+        std::filesystem::remove_all(output_dir);
+        
+        AnalysisOptions options;
+        options.output_directory = output_dir;
+        
+        CoreEngine engine;
+        auto result = engine.analyzeDirectory("SampleUnityProject", options);
+        bool index_written = std::filesystem::exists(std::filesystem::path(output_dir) / "symbol_index.json");
+        
+        CoreEngine query_engine;
+        auto matches = query_engine.searchSymbolsInDirectory("SampleUnityProject", "which components touch Rigidbody in FixedUpdate", 10, options);
+        auto none = query_engine.searchSymbolsInDirectory("SampleUnityProject", "the of in", 10, options);
+        // "Component" is part of Unity API names, so it must stay searchable
+        auto required = query_engine.searchSymbolsInDirectory("SampleUnityProject", "RequireComponent", 10, options);
+        bool component_searchable = false;
+        for (const auto& match : required) {
+            if (match.component == "PlayerController") {
+                component_searchable = true;
+            }
+        }
+        
+        bool ranked = !matches.empty() && matches.front().component == "PlayerController";
+        for (size_t i = 1; i < matches.size(); ++i) {
+            if (matches[i].score > matches[i - 1].score) {
+                ranked = false;
+            }
+        }
+        bool not_reparsed = query_engine.getSourceFilesParsed() == 0;
+        std::filesystem::remove_all(output_dir);
+        
+        if (result.success && index_written && ranked && none.empty() && component_searchable && not_reparsed) {
+            g_test_results.push_back({"CoreEngine_SymbolSearch", true, "Symbol query ranked the Rigidbody/FixedUpdate component first"});
+        } else {
+            g_test_results.push_back({"CoreEngine_SymbolSearch", false, "Symbol search missed or misranked the expected component"});
+        }
+    }
+    
+    // Test 16: The delta baseline only advances once the delta itself is written
+    {
+        std::string output_dir = "test_output_delta";
+        std::filesystem::remove_all(output_dir);
+        
+        AnalysisOptions options;
+        options.output_directory = output_dir;
+        options.output_format = OutputFormat::JSON;
+        options.delta_export = true;
+        options.export_json = false;
+        
+        CoreEngine engine;
+        auto result = engine.analyzeSingleFile("SampleUnityProject/PlayerController.cs", options);
+        
+        // A directory where project_delta.json should go makes the delta write fail
+        std::filesystem::path delta_path = std::filesystem::path(output_dir) / "project_delta.json";
+        std::filesystem::path snapshot_path = std::filesystem::path(output_dir) / "project_snapshot.json";
+        std::filesystem::create_directories(delta_path);
+        bool failed_export = !engine.exportResults(result, options);
+        bool baseline_kept = !std::filesystem::exists(snapshot_path);
+        
+        std::filesystem::remove_all(delta_path);
+        bool exported = engine.exportResults(result, options);
+        bool both_written = std::filesystem::is_regular_file(delta_path) && std::filesystem::is_regular_file(snapshot_path);
+        std::filesystem::remove_all(output_dir);
+        
+        if (result.success && failed_export && baseline_kept && exported && both_written) {
+            g_test_results.push_back({"CoreEngine_DeltaSnapshotOrder", true, "Snapshot committed only after the delta was written"});
+        } else {
+            g_test_results.push_back({"CoreEngine_DeltaSnapshotOrder", false, "Snapshot advanced without a written delta"});
+        }
+    }
+}
@@ -8,6 +8,7 @@ struct TestResult {
     std::string name;
     bool passed;
     std::string message;
+    bool skipped = false; // Could not run here (e.g. no loopback networking); counted as neither
 };
 
 extern std::vector<TestResult> g_test_results;
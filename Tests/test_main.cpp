@@ -8,7 +8,9 @@ std::vector<TestResult> g_test_results;
 void test_treesitter_engine();
 void test_unity_analyzer();
 void test_metadata_generator();
+void test_context_summarizer();
 void test_core_engine();
+void test_ai_analyzer();
 
 int main() {
     std::cout << "Running Unity Context Generator Tests\n";
@@ -18,14 +20,20 @@ int main() {
     test_treesitter_engine();
     test_unity_analyzer();
     test_metadata_generator();
+    test_context_summarizer();
     test_core_engine();
+    test_ai_analyzer();
     
     // Print results
     int passed = 0;
     int failed = 0;
+    int skipped = 0;
     
     for (const auto& result : g_test_results) {
-        if (result.passed) {
+        if (result.skipped) {
+            std::cout << "⏭️ " << result.name << ": Skipped: " << result.message << "\n";
+            skipped++;
+        } else if (result.passed) {
             std::cout << "✅ " << result.name << ": " << result.message << "\n";
             passed++;
         } else {
@@ -38,6 +46,7 @@ int main() {
     std::cout << "Tests completed: " << (passed + failed) << "\n";
     std::cout << "Passed: " << passed << "\n";
     std::cout << "Failed: " << failed << "\n";
+    std::cout << "Skipped: " << skipped << "\n";
     
     return failed == 0 ? 0 : 1;
 }
\ No newline at end of file
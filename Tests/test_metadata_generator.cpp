@@ -1,12 +1,19 @@
 #include "../Core/MetadataGenerator/ProjectMetadata.h"
 #include "../Core/MetadataGenerator/JSONExporter.h"
+#include "../Core/MetadataGenerator/ShardedExporter.h"
+#include "../Core/MetadataGenerator/DeltaExporter.h"
 #include "../Core/UnityAnalyzer/MonoBehaviourAnalyzer.h"
 #include "../Core/UnityAnalyzer/ComponentDependencyAnalyzer.h"
 #include "../Core/UnityAnalyzer/LifecycleAnalyzer.h"
 #include "../Core/UnityAnalyzer/UnityPatternDetector.h"
 #include "test_framework.h"
+#include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <filesystem>
 #include <fstream>
+#include <set>
+#include <sstream>
 
 void test_metadata_generator() {
     using namespace UnityContextGen::Metadata;
@@ -237,5 +244,252 @@ void test_metadata_generator() {
         }
     }
     
+    // Test 6: Streaming export is byte-identical to the DOM builders, pretty and compact
+    {
+        ProjectMetadataGenerator project_generator;
+        project_generator.analyzeProject(all_monobehaviours, dependency_graph, lifecycle_flows, patterns, files);
+        
+        auto project_metadata = project_generator.getProjectMetadata();
+        
+        auto readAndRemove = [](const std::string& path) {
+            std::ifstream check_file(path);
+            std::stringstream contents;
+            contents << check_file.rdbuf();
+            check_file.close();
+            std::remove(path.c_str());
+            return contents.str();
+        };
+        
+        JSONExporter exporter;
+        std::string test_file = "test_stream_output.json";
+        bool streamed = exporter.exportProjectMetadata(project_metadata, test_file);
+        std::string pretty = readAndRemove(test_file);
+        
+        bool components_match = !project_metadata.components.empty();
+        for (const auto& comp_pair : project_metadata.components) {
+            streamed = exporter.exportComponentMetadata(comp_pair.second, test_file) && streamed;
+            auto component_dom = exporter.createComponentAnalysisJSON({comp_pair.second})["components"][0];
+            components_match = components_match && readAndRemove(test_file) == component_dom.dump(2) + "\n";
+        }
+        
+        exporter.setCompactOutput(true);
+        streamed = exporter.exportProjectMetadata(project_metadata, test_file) && streamed;
+        std::string compact = readAndRemove(test_file);
+        
+        nlohmann::json dom = exporter.createClaudeCodeOptimizedJSON(project_metadata);
+        bool pretty_matches = pretty == dom.dump(2) + "\n";
+        bool compact_matches = compact == dom.dump();
+        
+        std::ostringstream escaped;
+        {
+            JSONStreamWriter writer(escaped);
+            writer.beginObject();
+            writer.field("text", std::string("quote\" tab\t\x01"));
+            writer.field("ratio", 0.1f);
+            writer.field("large", 1.5e20);
+            writer.field("small", 0.00025);
+            writer.key("empty");
+            writer.beginArray();
+            writer.endArray();
+            writer.endObject();
+        }
+        nlohmann::json escaped_dom = {
+            {"text", "quote\" tab\t\x01"},
+            {"ratio", 0.1f},
+            {"large", 1.5e20},
+            {"small", 0.00025},
+            {"empty", nlohmann::json::array()}
+        };
+        // Insertion order differs from the DOM's sorted order, so compare parsed values and number text
+        bool escapes = false;
+        try {
+            escapes = nlohmann::json::parse(escaped.str()) == escaped_dom &&
+                      escaped.str().find(escaped_dom["ratio"].dump()) != std::string::npos &&
+                      escaped.str().find(escaped_dom["large"].dump()) != std::string::npos &&
+                      escaped.str().find(escaped_dom["small"].dump()) != std::string::npos;
+        } catch (const std::exception&) {
+        }
+        
+        if (streamed && pretty_matches && compact_matches && components_match && escapes) {
+            g_test_results.push_back({"JSONStreamWriter_Export", true, "Streamed export matches the DOM builders byte for byte"});
+        } else {
+            g_test_results.push_back({"JSONStreamWriter_Export", false, "Streamed export differed from the DOM builders"});
+        }
+    }
+    
+    // Test 7: Sharded export lets a single component be read back by offset and hash
+    {
+        ProjectMetadataGenerator project_generator;
+        project_generator.analyzeProject(all_monobehaviours, dependency_graph, lifecycle_flows, patterns, files);
+        
+        auto project_metadata = project_generator.getProjectMetadata();
+        std::string shard_dir = "test_shard_output";
+        
+        bool all_loaded = !project_metadata.components.empty();
+        bool tamper_detected = false;
+        for (auto granularity : {ShardGranularity::SystemGroup, ShardGranularity::Component}) {
+            ShardedExporter shard_exporter;
+            shard_exporter.setGranularity(granularity);
+            
+            ShardManifest manifest;
+            std::string manifest_path = shard_dir + "/" + ShardedExporter::MANIFEST_FILE_NAME;
+            bool exported = shard_exporter.exportShards(project_metadata, shard_dir) &&
+                            ShardedExporter::loadManifest(manifest_path, manifest);
+            all_loaded = all_loaded && exported &&
+                         manifest.entries.size() == project_metadata.components.size();
+            
+            for (const auto& comp_pair : project_metadata.components) {
+                const ShardEntry* entry = manifest.findComponent(comp_pair.second.class_name);
+                std::string record;
+                bool loaded = entry && ShardedExporter::loadRecord(shard_dir, *entry, record);
+                try {
+                    loaded = loaded && nlohmann::json::parse(record)["class_name"] == comp_pair.second.class_name;
+                } catch (const std::exception&) {
+                    loaded = false;
+                }
+                all_loaded = all_loaded && loaded;
+            }
+            
+            if (exported && !manifest.entries.empty()) {
+                ShardEntry corrupted = manifest.entries.front();
+                corrupted.hash = "0000000000000000";
+                std::string record;
+                tamper_detected = !ShardedExporter::loadRecord(shard_dir, corrupted, record);
+            }
+            
+            std::filesystem::remove_all(shard_dir);
+        }
+        
+        // Names differing only in case get distinct files, and shards a later export drops are pruned
+        bool case_distinct = false;
+        bool pruned = false;
+        {
+            ProjectMetadata clashing = project_metadata;
+            ComponentMetadata lower_case = clashing.components.begin()->second;
+            std::string original_name = lower_case.class_name;
+            std::transform(lower_case.class_name.begin(), lower_case.class_name.end(),
+                           lower_case.class_name.begin(), ::tolower);
+            lower_case.class_name += "x";
+            std::string upper_case_name = lower_case.class_name;
+            std::transform(upper_case_name.begin(), upper_case_name.end(), upper_case_name.begin(), ::toupper);
+            clashing.components[lower_case.class_name] = lower_case;
+            lower_case.class_name = upper_case_name;
+            clashing.components[upper_case_name] = lower_case;
+            
+            ShardedExporter shard_exporter;
+            shard_exporter.setGranularity(ShardGranularity::Component);
+            ShardManifest manifest;
+            if (shard_exporter.exportShards(clashing, shard_dir, &manifest)) {
+                std::set<std::string> lowered_files;
+                for (const auto& entry : manifest.entries) {
+                    std::string lowered = entry.shard_file;
+                    std::transform(lowered.begin(), lowered.end(), lowered.begin(), ::tolower);
+                    lowered_files.insert(lowered);
+                }
+                case_distinct = lowered_files.size() == manifest.entries.size();
+                
+                const ShardEntry* dropped = manifest.findComponent(upper_case_name);
+                std::string dropped_path = dropped ? shard_dir + "/" + dropped->shard_file : std::string();
+                ShardManifest reduced;
+                pruned = dropped && shard_exporter.exportShards(project_metadata, shard_dir, &reduced) &&
+                         !std::filesystem::exists(dropped_path) &&
+                         std::filesystem::exists(shard_dir + "/" + reduced.findComponent(original_name)->shard_file);
+            }
+            std::filesystem::remove_all(shard_dir);
+        }
+        
+        if (all_loaded && tamper_detected && case_distinct && pruned) {
+            g_test_results.push_back({"ShardedExporter_Roundtrip", true, "Shards load individually, verify their hashes and prune stale files"});
+        } else {
+            g_test_results.push_back({"ShardedExporter_Roundtrip", false, "Shard records did not round-trip"});
+        }
+    }
+    
+    // Test 8: Re-exporting identical metadata leaves the existing file untouched
+    {
+        ProjectMetadataGenerator project_generator;
+        project_generator.analyzeProject(all_monobehaviours, dependency_graph, lifecycle_flows, patterns, files);
+        
+        auto project_metadata = project_generator.getProjectMetadata();
+        
+        JSONExporter exporter;
+        std::string test_file = "test_unchanged_output.json";
+        bool first = exporter.exportProjectMetadata(project_metadata, test_file);
+        
+        auto stale_time = std::filesystem::file_time_type::clock::now() - std::chrono::hours(1);
+        std::filesystem::last_write_time(test_file, stale_time);
+        
+        bool second = exporter.exportProjectMetadata(project_metadata, test_file);
+        bool skipped = std::filesystem::last_write_time(test_file) == stale_time;
+        
+        exporter.setCompactOutput(true);
+        bool third = exporter.exportProjectMetadata(project_metadata, test_file);
+        bool replaced = std::filesystem::last_write_time(test_file) != stale_time;
+        
+        bool no_temp_files = true;
+        for (const auto& entry : std::filesystem::directory_iterator(".")) {
+            if (entry.path().filename().string().rfind(test_file + ".tmp", 0) == 0) {
+                no_temp_files = false;
+            }
+        }
+        std::remove(test_file.c_str());
+        
+        if (first && second && third && skipped && replaced && no_temp_files) {
+            g_test_results.push_back({"JSONExporter_SkipUnchanged", true, "Unchanged exports are skipped, changed ones replaced"});
+        } else {
+            g_test_results.push_back({"JSONExporter_SkipUnchanged", false, "Export rewrote unchanged content or left temp files"});
+        }
+    }
+    
+    // Test 9: Delta between snapshots is a JSON Patch that reproduces the new snapshot
+    {
+        ProjectMetadataGenerator project_generator;
+        project_generator.analyzeProject(all_monobehaviours, dependency_graph, lifecycle_flows, patterns, files);
+        
+        auto before_metadata = project_generator.getProjectMetadata();
+        auto after_metadata = before_metadata;
+        
+        bool has_components = !after_metadata.components.empty();
+        std::string removed_name;
+        if (has_components) {
+            removed_name = after_metadata.components.begin()->first;
+            after_metadata.components.erase(after_metadata.components.begin());
+        }
+        ComponentMetadata added;
+        added.class_name = "DeltaAddedComponent";
+        added.purpose = "Added between snapshots";
+        after_metadata.components[added.class_name] = added;
+        after_metadata.patterns.pattern_frequency["Observer"] += 1;
+        
+        DeltaExporter delta_exporter;
+        auto before = delta_exporter.createSnapshot(before_metadata);
+        auto after = delta_exporter.createSnapshot(after_metadata);
+        DeltaExporter::sealSnapshot(before);
+        DeltaExporter::sealSnapshot(after);
+        
+        auto patch = DeltaExporter::createPatch(before, after);
+        auto changes = DeltaExporter::summarizeChanges(before, after, patch);
+        
+        bool reproduces = false;
+        bool guards_base = false;
+        try {
+            reproduces = before.patch(patch) == after;
+            after.patch(patch);
+        } catch (const std::exception&) {
+            guards_base = true;
+        }
+        
+        bool summarized = changes.added_components == std::vector<std::string>{"DeltaAddedComponent"} &&
+                          changes.removed_components == std::vector<std::string>{removed_name} &&
+                          changes.modified_components.empty();
+        bool idle = DeltaExporter::createPatch(after, after).empty();
+        
+        if (has_components && reproduces && guards_base && summarized && idle) {
+            g_test_results.push_back({"DeltaExporter_JSONPatch", true, "Snapshot delta applies as RFC 6902 patch"});
+        } else {
+            g_test_results.push_back({"DeltaExporter_JSONPatch", false, "Snapshot delta did not reproduce the new snapshot"});
+        }
+    }
+    
     g_test_results.push_back({"MetadataGenerator_TestSuite", true, "Metadata generator test suite completed"});
 }
\ No newline at end of file
@@ -225,4 +225,128 @@ void test_unity_analyzer() {
             g_test_results.push_back({"MonoBehaviourAnalyzer_ExecutionPhases", false, "Failed to identify method execution phases correctly"});
         }
     }
+    
+    // Test 7: Unity callback catalog
+    {
+        bool all_found = true;
+        for (const auto& callback : UNITY_CALLBACKS) {
+            if (findUnityCallback(callback.name) != &callback) {
+                all_found = false;
+            }
+        }
+        
+        const UnityCallbackInfo* animator_move = findUnityCallback("OnAnimatorMove");
+        bool extended_catalog = animator_move != nullptr &&
+                                animator_move->category == UnityCallbackCategory::Animation &&
+                                findUnityCallback("OnApplicationQuit") != nullptr;
+        bool rejects_near_miss = findUnityCallback("update") == nullptr &&
+                                 findUnityCallback("OnTriggerEnter3D") == nullptr;
+        
+        if (all_found && extended_catalog && rejects_near_miss) {
+            g_test_results.push_back({"UnityCallbackCatalog_Lookup", true, "Resolved every catalog entry through the perfect hash"});
+        } else {
+            g_test_results.push_back({"UnityCallbackCatalog_Lookup", false, "Callback catalog lookup returned unexpected entries"});
+        }
+    }
+    
+    // Test 8: Feature bitmaps and data-declared pattern rules
+    {
+        MonoBehaviourAnalyzer mb_analyzer;
+        UnityPatternDetector pattern_detector;
+        
+        if (mb_analyzer.analyzeFile("SampleUnityProject/GameManager.cs")) {
+            const auto& monobehaviours = mb_analyzer.getMonoBehaviours();
+            
+            bool has_singleton_features = false;
+            for (const auto& mb : monobehaviours) {
+                if (mb.class_name == "GameManager" &&
+                    hasFeature(mb.features, ComponentFeature::StaticInstanceField) &&
+                    hasFeature(mb.features, ComponentFeature::DontDestroyOnLoad)) {
+                    has_singleton_features = true;
+                }
+            }
+            
+            PatternRule studio_rule;
+            studio_rule.pattern_name = "Persistent Manager";
+            studio_rule.description = "Manager that survives scene loads";
+            studio_rule.purpose = "Keep global state across scenes";
+            studio_rule.require_all = featureSet({ComponentFeature::ServiceNamed, ComponentFeature::DontDestroyOnLoad});
+            studio_rule.evidence = {{ComponentFeature::DontDestroyOnLoad, "DontDestroyOnLoad usage"}};
+            pattern_detector.addPatternRule(studio_rule);
+            
+            ComponentGraph empty_graph;
+            pattern_detector.analyzeProject(monobehaviours, empty_graph);
+            
+            bool found_custom_rule = !pattern_detector.getPatternsByType(UnityPattern::Custom).empty();
+            
+            if (has_singleton_features && found_custom_rule) {
+                g_test_results.push_back({"UnityPatternDetector_FeatureRules", true, "Matched built-in and custom rules over feature bitmaps"});
+            } else {
+                g_test_results.push_back({"UnityPatternDetector_FeatureRules", false, "Feature bitmap or custom rule matching failed"});
+            }
+        } else {
+            g_test_results.push_back({"UnityPatternDetector_FeatureRules", false, "Failed to analyze GameManager.cs"});
+        }
+    }
+    
+    // Test 9: Features come from declared types, not field names; weak evidence detects nothing
+    {
+        MonoBehaviourAnalyzer mb_analyzer;
+        std::string source =
+            "using System;\n"
+            "using System.Collections.Generic;\n"
+            "using UnityEngine;\n\n"
+            "public class Patrol : MonoBehaviour\n{\n"
+            "    public List<Transform> waypointList;\n"
+            "    public int poolSize = 4;\n"
+            "    public PlayerAction lastAction;\n"
+            "    void Update() { }\n"
+            "    public Transform GetWaypoint(int index) { return waypointList[index]; }\n"
+            "}\n\n"
+            "public class Spawner : MonoBehaviour\n{\n"
+            "    private Queue<GameObject> spares;\n"
+            "    public Action<int> onSpawned;\n"
+            "    public GameObject GetInstance() { return spares.Dequeue(); }\n"
+            "}\n";
+        
+        bool patrol_clean = false;
+        bool spawner_typed = false;
+        if (mb_analyzer.analyzeCode(source, "Patrol.cs")) {
+            for (const auto& mb : mb_analyzer.getMonoBehaviours()) {
+                if (mb.class_name == "Patrol") {
+                    patrol_clean = !hasFeature(mb.features, ComponentFeature::PoolCollection) &&
+                                   !hasFeature(mb.features, ComponentFeature::EventFields);
+                } else if (mb.class_name == "Spawner") {
+                    spawner_typed = hasFeature(mb.features, ComponentFeature::PoolCollection) &&
+                                    hasFeature(mb.features, ComponentFeature::EventFields);
+                }
+            }
+        }
+        
+        // Event declarations alone, with nobody raising or subscribing, are not an observer setup
+        MonoBehaviourInfo announcer;
+        announcer.class_name = "Announcer";
+        announcer.features = featureSet({ComponentFeature::EventFields});
+        MonoBehaviourInfo listener;
+        listener.class_name = "Listener";
+        listener.features = featureSet({ComponentFeature::SubscribeMethods});
+        
+        UnityPatternDetector pattern_detector;
+        ComponentGraph empty_graph;
+        pattern_detector.analyzeProject({announcer}, empty_graph);
+        bool lone_events_ignored = pattern_detector.getPatternsByType(UnityPattern::ObserverPattern).empty();
+        pattern_detector.analyzeProject({announcer, listener}, empty_graph);
+        bool half_observer_ignored = pattern_detector.getPatternsByType(UnityPattern::ObserverPattern).empty();
+        
+        MonoBehaviourInfo notifier = announcer;
+        notifier.features |= featureBit(ComponentFeature::EventRaiseMethods);
+        pattern_detector.analyzeProject({notifier, listener}, empty_graph);
+        bool observer_found = !pattern_detector.getPatternsByType(UnityPattern::ObserverPattern).empty();
+        
+        if (patrol_clean && spawner_typed && lone_events_ignored && half_observer_ignored && observer_found) {
+            g_test_results.push_back({"UnityPatternDetector_NegativeCases", true, "Name-only and one-sided evidence no longer matches"});
+        } else {
+            g_test_results.push_back({"UnityPatternDetector_NegativeCases", false, "Pattern features matched on weak evidence"});
+        }
+    }
 }
\ No newline at end of file
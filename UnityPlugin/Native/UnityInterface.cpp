@@ -3,6 +3,8 @@
 #include "ContextSummarizer/ProjectSummarizer.h"
 #include <nlohmann/json.hpp>
 #include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <memory>
 #include <vector>
 #include <thread>
@@ -63,6 +65,14 @@ AnalysisOptions ParseOptionsFromJson(const char* optionsJson) {
             // Parse output flags
             options.export_json = j.value("exportJson", true);
             options.verbose_output = j.value("verboseLogging", false);
+            options.compact_json = j.value("compactJson", false);
+            options.delta_export = j.value("deltaExport", false);
+            options.context_token_budget = j.value("tokenBudget", static_cast<size_t>(0));
+            options.sharded_export = Metadata::ShardedExporter::parseGranularity(
+                j.value("shardGranularity", ""), options.shard_granularity);
+            if (!parseOutputFormat(j.value("outputFormat", "all"), options.output_format)) {
+                options.output_format = OutputFormat::All;
+            }
             
             // Set output directory
             options.output_directory = j.value("outputDirectory", "./unity_context_analysis");
@@ -399,6 +409,83 @@ UNITY_EXPORT const char* UNITY_CALL GenerateLLMPrompt(const char* analysisResult
     }
 }
 
+UNITY_EXPORT const char* UNITY_CALL GenerateLLMPromptFromShards(const char* manifestPath, const char* componentNamesJson) {
+    try {
+        if (!manifestPath) {
+            SetLastError("Manifest path cannot be null");
+            return nullptr;
+        }
+        
+        Metadata::ShardManifest manifest;
+        if (!Metadata::ShardedExporter::loadManifest(manifestPath, manifest)) {
+            SetLastError("Failed to load shard manifest: " + std::string(manifestPath));
+            return nullptr;
+        }
+        
+        std::vector<const Metadata::ShardEntry*> selected;
+        if (componentNamesJson && strlen(componentNamesJson) > 0) {
+            for (const auto& name : json::parse(componentNamesJson)) {
+                const Metadata::ShardEntry* entry = manifest.findComponent(name.get<std::string>());
+                if (!entry) {
+                    SetLastError("Component not found in shard manifest: " + name.get<std::string>());
+                    return nullptr;
+                }
+                selected.push_back(entry);
+            }
+        } else {
+            for (const auto& entry : manifest.entries) {
+                selected.push_back(&entry);
+            }
+        }
+        
+        // The manifest header carries the project-level context
+        json header;
+        {
+            std::ifstream manifest_file(manifestPath);
+            header = json::parse(manifest_file);
+        }
+        json project = header.value("project_context", json::object());
+        std::string manifestDirectory = std::filesystem::path(manifestPath).parent_path().string();
+        
+        std::stringstream prompt;
+        prompt << "# Unity Project Context\n\n";
+        prompt << "**Type:** " << project.value("type", "Unity Project") << " | ";
+        prompt << "**Architecture:** " << project.value("architecture", "Component-based") << " | ";
+        prompt << "**Components:** " << selected.size() << " of " << manifest.entries.size() << "\n\n";
+        
+        std::stringstream dependencies;
+        prompt << "## Component Overview\n";
+        for (const auto* entry : selected) {
+            std::string record;
+            if (!Metadata::ShardedExporter::loadRecord(manifestDirectory, *entry, record)) {
+                SetLastError("Failed to load shard record for component: " + entry->component);
+                return nullptr;
+            }
+            
+            json comp = json::parse(record);
+            prompt << "- **" << entry->component << "** (" << entry->system << "): ";
+            prompt << comp.value("purpose", "No description available") << "\n";
+            
+            for (const auto& dep : comp.value("dependencies", json::array())) {
+                dependencies << "- " << entry->component << " → " << dep.get<std::string>() << "\n";
+            }
+        }
+        
+        prompt << "\n## Key Dependencies\n";
+        if (dependencies.tellp() > 0) {
+            prompt << dependencies.str();
+        } else {
+            prompt << "- No significant dependencies detected\n";
+        }
+        
+        return AllocateString(prompt.str());
+        
+    } catch (const std::exception& e) {
+        SetLastError("Shard prompt generation failed: " + std::string(e.what()));
+        return nullptr;
+    }
+}
+
 UNITY_EXPORT const char* UNITY_CALL GenerateProjectSummary(const char* analysisResultJson) {
     try {
         if (!analysisResultJson) {
@@ -20,6 +20,9 @@ extern "C" {
     UNITY_EXPORT const char* UNITY_CALL GenerateLLMPrompt(const char* analysisResultJson);
     UNITY_EXPORT const char* UNITY_CALL GenerateProjectSummary(const char* analysisResultJson);
     
+    // Loads only the named components (JSON array; null or empty for all) from a shard manifest
+    UNITY_EXPORT const char* UNITY_CALL GenerateLLMPromptFromShards(const char* manifestPath, const char* componentNamesJson);
+    
     // Utility functions
     UNITY_EXPORT const char* UNITY_CALL GetLastError();
     UNITY_EXPORT void UNITY_CALL FreeString(const char* str);
@@ -23,6 +23,9 @@ namespace Unity.LLMContextGenerator
         [DllImport(NATIVE_LIBRARY, CallingConvention = CallingConvention.Cdecl)]
         private static extern IntPtr GenerateLLMPrompt(string analysisResultJson);
 
+        [DllImport(NATIVE_LIBRARY, CallingConvention = CallingConvention.Cdecl)]
+        private static extern IntPtr GenerateLLMPromptFromShards(string manifestPath, string componentNamesJson);
+
         [DllImport(NATIVE_LIBRARY, CallingConvention = CallingConvention.Cdecl)]
         private static extern IntPtr GetLastError();
 
@@ -153,6 +156,36 @@ namespace Unity.LLMContextGenerator
             }
         }
 
+        /// <summary>
+        /// Generates an LLM prompt from a sharded export, reading only the requested components
+        /// </summary>
+        /// <param name="manifestPath">Path to shard_manifest.json</param>
+        /// <param name="componentNames">Components to include; all components when empty</param>
+        /// <returns>LLM prompt text</returns>
+        public static string GeneratePromptFromShards(string manifestPath, params string[] componentNames)
+        {
+            try
+            {
+                string namesJson = null;
+                if (componentNames != null && componentNames.Length > 0)
+                {
+                    var escaped = Array.ConvertAll(componentNames,
+                        name => "\"" + name.Replace("\\", "\\\\").Replace("\"", "\\\"") + "\"");
+                    namesJson = "[" + string.Join(",", escaped) + "]";
+                }
+
+                IntPtr promptPtr = GenerateLLMPromptFromShards(manifestPath, namesJson);
+                string prompt = MarshalPtrToString(promptPtr);
+
+                return string.IsNullOrEmpty(prompt) ? $"# Error: {GetLastErrorString()}" : prompt;
+            }
+            catch (Exception e)
+            {
+                Debug.LogError($"[LLMContextGenerator] Shard prompt generation failed: {e.Message}");
+                return $"# Error: {e.Message}";
+            }
+        }
+
         #endregion
 
         #region Helper Methods
@@ -291,6 +291,43 @@ def download_results():
     except Exception as e:
         return jsonify({'error': str(e)}), 500
 
+@app.route('/api/search', methods=['POST'])
+def search_symbols():
+    """심볼 인덱스 검색 API (예: "Rigidbody in FixedUpdate")"""
+    try:
+        data = request.get_json()
+        directory_path = data.get('directory_path', '')
+        query = data.get('query', '')
+        
+        if not query:
+            return jsonify({'error': '검색어를 입력해주세요'}), 400
+        if not Path(directory_path).exists():
+            return jsonify({'error': f'디렉토리를 찾을 수 없습니다: {directory_path}'}), 404
+        
+        result = subprocess.run(
+            [UNITY_CONTEXT_GENERATOR, '--directory', directory_path, '--search', query],
+            capture_output=True,
+            text=True,
+            timeout=120
+        )
+        
+        if result.returncode == 0:
+            return jsonify({
+                'success': True,
+                'query': query,
+                'results': result.stdout
+            })
+        else:
+            return jsonify({
+                'success': False,
+                'error': result.stderr
+            }), 400
+            
+    except subprocess.TimeoutExpired:
+        return jsonify({'error': '검색 시간 초과 (2분)'}), 408
+    except Exception as e:
+        return jsonify({'error': str(e)}), 500
+
 @app.route('/api/unity_patterns')
 def get_unity_patterns():
     """지원되는 Unity API 패턴 목록"""